@@ -167,6 +167,15 @@ namespace Plugin {
 
         // We bring the interface up, so we should bring it down as well..
         _application.Close();
+
+        _notificationJob.Revoke();
+
+        _adminLock.Lock();
+        for (DeviceImpl* device : _changed) {
+            device->Release();
+        }
+        _changed.clear();
+        _adminLock.Unlock();
         ::destruct_bluetooth_driver();
     }
 
@@ -523,6 +532,7 @@ namespace Plugin {
 
             ASSERT(impl != nullptr);
             _devices.push_back(impl);
+            _index.emplace(DeviceKey(*(address.Data()), lowEnergy), impl);
 
             TRACE(Trace::Information, (_T("Added %s Bluetooth device: %s, name: '%s', class: 0x%06X"),
                                        (lowEnergy? "LowEnergy" : "classic"), address.ToString().c_str(),
@@ -545,12 +555,54 @@ namespace Plugin {
     {
         _adminLock.Lock();
 
-        for (std::list<DeviceImpl*>::iterator index = _devices.begin(), end = _devices.end(); index != end; ++index) {
+        std::list<DeviceImpl*>::iterator index = _devices.begin();
+
+        while (index != _devices.end()) {
             // call the function passed into findMatchingAddresses and see if it matches
             if (filter(*index) == true) {
+                _index.erase(DeviceKey(*((*index)->Locator().Data()), (*index)->LowEnergy()));
                 (*index)->Release();
                 index = _devices.erase(index);
             }
+            else {
+                index++;
+            }
+        }
+
+        _adminLock.Unlock();
+    }
+    void BluetoothControl::Changed(DeviceImpl* device)
+    {
+        _adminLock.Lock();
+
+        // Reports arriving while a notification is pending are folded into the same batch.
+        const bool schedule = _changed.empty();
+
+        if (_changed.insert(device).second == true) {
+            device->AddRef();
+        }
+
+        _adminLock.Unlock();
+
+        if (schedule == true) {
+            _notificationJob.Submit([this]() {
+                NotifyChanged();
+            }, NOTIFICATION_WINDOW);
+        }
+    }
+    void BluetoothControl::NotifyChanged()
+    {
+        std::set<DeviceImpl*> changed;
+
+        _adminLock.Lock();
+
+        changed.swap(_changed);
+
+        for (DeviceImpl* device : changed) {
+            for (IBluetooth::INotification* observer : _observers) {
+                observer->Update(device);
+            }
+            device->Release();
         }
 
         _adminLock.Unlock();
@@ -568,23 +620,15 @@ namespace Plugin {
     }
     BluetoothControl::DeviceImpl* BluetoothControl::Find(const Bluetooth::Address& search) const
     {
-        std::list<DeviceImpl*>::const_iterator index = _devices.begin();
+        DeviceImpl* result = Find(search, false);
 
-        while ((index != _devices.end()) && ((*index)->operator==(search) == false)) {
-            index++;
-        }
-
-        return (index != _devices.end() ? (*index) : nullptr);
+        return (result != nullptr ? result : Find(search, true));
     }
     BluetoothControl::DeviceImpl* BluetoothControl::Find(const Bluetooth::Address& search, bool lowEnergy) const
     {
-        std::list<DeviceImpl*>::const_iterator index = _devices.begin();
+        std::unordered_map<uint64_t, DeviceImpl*>::const_iterator index = _index.find(DeviceKey(*(search.Data()), lowEnergy));
 
-        while ((index != _devices.end()) && ((*index)->operator==(std::make_pair(search, lowEnergy)) == false)) {
-            index++;
-        }
-
-        return (index != _devices.end() ? (*index) : nullptr);
+        return (index != _index.end() ? index->second : nullptr);
     }
     template<typename DEVICE=BluetoothControl::DeviceImpl>
     DEVICE* BluetoothControl::Find(const uint16_t handle) const
@@ -698,6 +742,7 @@ namespace Plugin {
                         if (device != nullptr) {
 
                             _devices.push_back(device);
+                            _index.emplace(DeviceKey(*(device->Locator().Data()), device->LowEnergy()), device);
 
                             result = Core::ERROR_NONE;
                         }
@@ -25,6 +25,9 @@
 
 #include "Tracing.h"
 
+#include <set>
+#include <unordered_map>
+
 namespace WPEFramework {
 
 namespace Plugin {
@@ -37,6 +40,9 @@ class BluetoothControl : public PluginHost::IPlugin
                        , public Exchange::IBluetooth {
 
     private:
+        // Changed devices are reported to the observers at most once per window (ms).
+        static constexpr uint32_t NOTIFICATION_WINDOW = 100;
+
         class DecoupledJob : private Core::WorkerPool::JobType<DecoupledJob&> {
         public:
             using Job = std::function<void()>;
@@ -100,6 +106,16 @@ class BluetoothControl : public PluginHost::IPlugin
             return ((buffer[2] << 16) | (buffer[1] << 8) | (buffer[0]));
         }
 
+        // Six address bytes, with the transport (classic/LE) in bit 48, so a device is found without walking the list.
+        static uint64_t DeviceKey(const bdaddr_t& address, const bool lowEnergy)
+        {
+            uint64_t key = (lowEnergy == true ? (1ULL << 48) : 0);
+            for (uint8_t index = 0; index < sizeof(address.b); index++) {
+                key |= (static_cast<uint64_t>(address.b[index]) << (index * 8));
+            }
+            return (key);
+        }
+
         class ControlSocket : public Bluetooth::HCISocket {
         private:
             class ManagementSocket : public Bluetooth::ManagementSocket {
@@ -261,6 +277,8 @@ class BluetoothControl : public PluginHost::IPlugin
                 : Bluetooth::HCISocket()
                 , _parent(nullptr)
                 , _administrator(*this)
+                , _advertisementLock()
+                , _advertisements()
             {
             }
             ~ControlSocket() = default;
@@ -294,6 +312,7 @@ class BluetoothControl : public PluginHost::IPlugin
                 if (IsOpen() == true) {
                     _scanJob.Submit([this, scanTime, type, flags]() {
                         TRACE(ControlFlow, (_T("Start BT classic scan: %s"), Core::Time::Now().ToRFC1123().c_str()));
+                        ScanWindow();
                         Bluetooth::HCISocket::Scan(scanTime, type, flags);
                         ScanComplete();
                     });
@@ -304,6 +323,7 @@ class BluetoothControl : public PluginHost::IPlugin
                 if (IsOpen() == true) {
                     _scanJob.Submit([this, scanTime, limited, passive]() {
                         TRACE(ControlFlow, (_T("Start BT LowEnergy scan: %s"), Core::Time::Now().ToRFC1123().c_str()));
+                        ScanWindow();
                         Bluetooth::HCISocket::Scan(scanTime, limited, passive);
                         ScanComplete();
                     });
@@ -404,7 +424,10 @@ class BluetoothControl : public PluginHost::IPlugin
             void Discovered(const bool lowEnergy, const Bluetooth::Address& address, const Bluetooth::EIR& info) override
             {
                 if (Application() != nullptr) {
-                    Application()->Discovered(lowEnergy, address, info);
+                    DeviceImpl* device = Application()->Discovered(lowEnergy, address, info);
+                    if (device != nullptr) {
+                        Application()->Changed(device);
+                    }
                 }
             }
 
@@ -413,7 +436,8 @@ class BluetoothControl : public PluginHost::IPlugin
             {
                 BT_TRACE(ControlFlow, info);
                 if ((Application() != nullptr) && (info.bdaddr_type == 0 /* public */)
-                        && ((info.evt_type == 0 /* undirected connectable advertisement */) || (info.evt_type == 4 /* scan response */))) {
+                        && ((info.evt_type == 0 /* undirected connectable advertisement */) || (info.evt_type == 4 /* scan response */))
+                        && (Duplicate(info) == false)) {
                     Bluetooth::EIR eir(info.data, info.length);
 
                     DeviceImpl* device = Application()->Discovered(true, info.bdaddr, eir);
@@ -424,6 +448,7 @@ class BluetoothControl : public PluginHost::IPlugin
                         if (eir.CompleteName().empty() == false) {
                             device->Name(eir.CompleteName());
                         }
+                        Application()->Changed(device);
                     }
                 }
             }
@@ -662,10 +687,40 @@ class BluetoothControl : public PluginHost::IPlugin
                 BT_TRACE(ControlFlow, info);
             }
 
+        private:
+            void ScanWindow()
+            {
+                _advertisementLock.Lock();
+                _advertisements.clear();
+                _advertisementLock.Unlock();
+            }
+            bool Duplicate(const le_advertising_info& info)
+            {
+                // Advertisers repeat the same report many times per second; within one scan window
+                // only a report whose payload differs from the previous one for that advertiser and
+                // report type is worth parsing.
+                uint32_t hash = 2166136261UL;
+                for (uint8_t index = 0; index < info.length; index++) {
+                    hash = ((hash ^ info.data[index]) * 16777619UL);
+                }
+
+                const uint64_t key = (DeviceKey(info.bdaddr, true) | (static_cast<uint64_t>(info.evt_type) << 56));
+
+                _advertisementLock.Lock();
+                std::pair<std::unordered_map<uint64_t, uint32_t>::iterator, bool> entry = _advertisements.emplace(key, hash);
+                const bool duplicate = ((entry.second == false) && (entry.first->second == hash));
+                entry.first->second = hash;
+                _advertisementLock.Unlock();
+
+                return (duplicate);
+            }
+
         private:
             BluetoothControl* _parent;
             DecoupledJob _scanJob;
             ManagementSocket _administrator;
+            Core::CriticalSection _advertisementLock;
+            std::unordered_map<uint64_t, uint32_t> _advertisements;
         }; // class ControlSocket
 
         class Config : public Core::JSON::Container {
@@ -2058,7 +2113,10 @@ class BluetoothControl : public PluginHost::IPlugin
             , _btInterface(0)
             , _btAddress()
             , _devices()
+            , _index()
             , _observers()
+            , _changed()
+            , _notificationJob()
         {
             RegisterAll();
         }
@@ -2135,6 +2193,8 @@ class BluetoothControl : public PluginHost::IPlugin
         template<typename DEVICE>
         DEVICE* Find(const Bluetooth::Address& address) const;
         void RemoveDevices(std::function<bool(DeviceImpl*)> filter);
+        void Changed(DeviceImpl* device);
+        void NotifyChanged();
         DeviceImpl* Discovered(const bool lowEnergy, const Bluetooth::Address& address, const Bluetooth::EIR& info);
         void Notification(const uint8_t subEvent, const uint16_t length, const uint8_t* dataFrame);
         void Capabilities(const Bluetooth::Address& device, const uint8_t capability, const uint8_t authentication, const uint8_t oob_data);
@@ -2189,7 +2249,10 @@ class BluetoothControl : public PluginHost::IPlugin
         uint16_t _btInterface;
         Bluetooth::Address _btAddress;
         std::list<DeviceImpl*> _devices;
+        std::unordered_map<uint64_t, DeviceImpl*> _index;
         std::list<IBluetooth::INotification*> _observers;
+        std::set<DeviceImpl*> _changed;
+        DecoupledJob _notificationJob;
         Config _config;
         ControlSocket _application;
         string _persistentStoragePath;
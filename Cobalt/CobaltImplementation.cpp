@@ -88,7 +88,7 @@ private:
         Core::JSON::String FriendlyName;
     };
 
-    class NotificationSink: public Core::Thread {
+    class NotificationSink {
     private:
         NotificationSink() = delete;
         NotificationSink(const NotificationSink&) = delete;
@@ -96,36 +96,31 @@ private:
 
     public:
         NotificationSink(CobaltImplementation &parent) :
-                _parent(parent), _waitTime(0), _command(
+                _parent(parent), _job(*this), _command(
                         PluginHost::IStateControl::SUSPEND) {
         }
-        virtual ~NotificationSink() {
-            Stop();
-            Wait(Thread::STOPPED | Thread::BLOCKED, Core::infinite);
+        ~NotificationSink() {
+            _job.Revoke();
         }
 
     public:
         void RequestForStateChange(
                 const PluginHost::IStateControl::command command) {
             _command = command;
-            Run();
+            _job.Submit();
         }
 
     private:
-        virtual uint32_t Worker() {
-            bool success = false;
+        friend Core::ThreadPool::JobType<NotificationSink&>;
 
-            if ((IsRunning() == true) && (success == false)) {
-                success = _parent.RequestForStateChange(_command);
-            }
-            Block();
+        void Dispatch() {
+            bool success = _parent.RequestForStateChange(_command);
             _parent.StateChangeCompleted(success, _command);
-            return (Core::infinite);
         }
 
     private:
         CobaltImplementation &_parent;
-        uint32_t _waitTime;
+        Core::WorkerPool::JobType<NotificationSink&> _job;
         PluginHost::IStateControl::command _command;
     };
 
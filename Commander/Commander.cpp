@@ -230,8 +230,10 @@ namespace Plugin {
                 if (sequencer->IsActive() == true) {
                     response->ErrorCode = Web::STATUS_TEMPORARY_REDIRECT;
                     response->Message = _T("Sequencer already running");
+                } else if (sequencer->Load(*(request.Body<Web::JSONBodyType<Core::JSON::ArrayType<Commander::Command>>>())) == 0) {
+                    response->ErrorCode = Web::STATUS_BAD_REQUEST;
+                    response->Message = _T("Sequence List is empty or has circular dependencies");
                 } else {
-                    sequencer->Load(*(request.Body<Web::JSONBodyType<Core::JSON::ArrayType<Commander::Command>>>()));
                     sequencer->Execute();
 
                     Core::IWorkerPool::Instance().Submit(job);
@@ -260,6 +262,9 @@ namespace Plugin {
             data.Index = sequencer.Index();
         }
 
+        // Timing of the last (or current) run, including its critical path.
+        sequencer.Report(data);
+
         return (data);
     }
 
@@ -41,20 +41,24 @@ namespace Plugin {
                 , Item()
                 , Label()
                 , Parameters(false)
+                , Dependencies()
             {
                 Add(_T("command"), &Item);
                 Add(_T("label"), &Label);
                 Add(_T("parameters"), &Parameters);
+                Add(_T("dependencies"), &Dependencies);
             }
             Command(const Command& copy)
                 : Core::JSON::Container()
                 , Item(copy.Item)
                 , Label(copy.Label)
                 , Parameters(copy.Parameters)
+                , Dependencies(copy.Dependencies)
             {
                 Add(_T("command"), &Item);
                 Add(_T("label"), &Label);
                 Add(_T("parameters"), &Parameters);
+                Add(_T("dependencies"), &Dependencies);
             }
             ~Command()
             {
@@ -65,6 +69,7 @@ namespace Plugin {
                 Item = RHS.Item;
                 Label = RHS.Label;
                 Parameters = RHS.Parameters;
+                Dependencies = RHS.Dependencies;
 
                 return (*this);
             }
@@ -73,6 +78,54 @@ namespace Plugin {
             Core::JSON::String Item;
             Core::JSON::String Label;
             Core::JSON::String Parameters;
+            Core::JSON::ArrayType<Core::JSON::String> Dependencies;
+        };
+
+        class Step : public Core::JSON::Container {
+        public:
+            Step()
+                : Core::JSON::Container()
+                , Label()
+                , Start()
+                , Duration()
+                , Result()
+            {
+                Add(_T("label"), &Label);
+                Add(_T("start"), &Start);
+                Add(_T("duration"), &Duration);
+                Add(_T("result"), &Result);
+            }
+            Step(const Step& copy)
+                : Core::JSON::Container()
+                , Label(copy.Label)
+                , Start(copy.Start)
+                , Duration(copy.Duration)
+                , Result(copy.Result)
+            {
+                Add(_T("label"), &Label);
+                Add(_T("start"), &Start);
+                Add(_T("duration"), &Duration);
+                Add(_T("result"), &Result);
+            }
+            ~Step()
+            {
+            }
+
+            Step& operator=(const Step& RHS)
+            {
+                Label = RHS.Label;
+                Start = RHS.Start;
+                Duration = RHS.Duration;
+                Result = RHS.Result;
+
+                return (*this);
+            }
+
+        public:
+            Core::JSON::String Label;
+            Core::JSON::DecUInt64 Start; // ms, relative to the start of the sequence
+            Core::JSON::DecUInt64 Duration; // ms
+            Core::JSON::String Result;
         };
 
         class Data : public Core::JSON::Container {
@@ -85,6 +138,9 @@ namespace Plugin {
                 Add(_T("index"), &Index);
                 Add(_T("label"), &Label);
                 Add(_T("command"), &Command);
+                Add(_T("steps"), &Steps);
+                Add(_T("criticalpath"), &CriticalPath);
+                Add(_T("duration"), &Duration);
             }
             Data(const string& name, const state actualState, const uint32_t index, const string& label)
                 : Core::JSON::Container()
@@ -94,6 +150,9 @@ namespace Plugin {
                 Add(_T("index"), &Index);
                 Add(_T("label"), &Label);
                 Add(_T("command"), &Command);
+                Add(_T("steps"), &Steps);
+                Add(_T("criticalpath"), &CriticalPath);
+                Add(_T("duration"), &Duration);
 
                 Sequencer = name;
                 State = actualState;
@@ -107,12 +166,18 @@ namespace Plugin {
                 , Index(copy.Index)
                 , Label(copy.Label)
                 , Command(copy.Command)
+                , Steps(copy.Steps)
+                , CriticalPath(copy.CriticalPath)
+                , Duration(copy.Duration)
             {
                 Add(_T("sequencer"), &Sequencer);
                 Add(_T("state"), &State);
                 Add(_T("index"), &Index);
                 Add(_T("label"), &Label);
                 Add(_T("Command"), &Command);
+                Add(_T("steps"), &Steps);
+                Add(_T("criticalpath"), &CriticalPath);
+                Add(_T("duration"), &Duration);
             }
             ~Data()
             {
@@ -125,6 +190,9 @@ namespace Plugin {
                 Index = RHS.Index;
                 Label = RHS.Label;
                 Command = RHS.Command;
+                Steps = RHS.Steps;
+                CriticalPath = RHS.CriticalPath;
+                Duration = RHS.Duration;
 
                 return (*this);
             }
@@ -135,6 +203,9 @@ namespace Plugin {
             Core::JSON::DecUInt32 Index;
             Core::JSON::String Label;
             Core::JSON::String Command;
+            Core::JSON::ArrayType<Step> Steps;
+            Core::JSON::ArrayType<Core::JSON::String> CriticalPath;
+            Core::JSON::DecUInt64 Duration; // ms, length of the critical path
         };
 
     private:
@@ -243,6 +314,43 @@ namespace Plugin {
             Sequencer(const Sequencer& copy) = delete;
             Sequencer& operator=(const Sequencer&) = delete;
 
+            static constexpr uint32_t NoStep = static_cast<uint32_t>(~0);
+
+            class StepJob : public Core::IDispatchType<void> {
+            private:
+                StepJob() = delete;
+                StepJob(const StepJob&) = delete;
+                StepJob& operator=(const StepJob&) = delete;
+
+            public:
+                StepJob(Sequencer& parent, const uint32_t index)
+                    : _parent(parent)
+                    , _index(index)
+                {
+                }
+                ~StepJob() override
+                {
+                }
+
+            private:
+                void Dispatch() override
+                {
+                    _parent.Run(_index);
+                }
+
+            private:
+                Sequencer& _parent;
+                const uint32_t _index;
+            };
+
+            struct Timing {
+                string Label;
+                string Result;
+                uint64_t Start;
+                uint64_t End;
+                uint32_t Predecessor;
+            };
+
         public:
             Sequencer(const string& name, Administrator* commandFactory, PluginHost::IShell* service)
                 : _commandFactory(commandFactory)
@@ -252,6 +360,15 @@ namespace Plugin {
                 , _name(name)
                 , _service(service)
                 , _sequenceList(5)
+                , _dependencies()
+                , _dependants()
+                , _waiting()
+                , _jobs()
+                , _timings()
+                , _running(0)
+                , _begin(0)
+                , _report()
+                , _criticalPath()
             {
                 ASSERT(service != nullptr);
 
@@ -264,6 +381,12 @@ namespace Plugin {
                 // Make sure we are not executing anything if we get destructed.
                 Abort();
 
+                // Steps running in parallel, hold a reference to us, wait till they are done.
+                for (Core::ProxyType<StepJob>& job : _jobs) {
+                    Core::ProxyType<Core::IDispatchType<void>> step(Core::proxy_cast<Core::IDispatchType<void>>(job));
+                    Core::IWorkerPool::Instance().Revoke(step, Core::infinite);
+                }
+
                 if (_service != nullptr) {
                     _service->Release();
                 }
@@ -314,6 +437,40 @@ namespace Plugin {
 
                 return (result);
             }
+            inline bool IsParallel() const
+            {
+                return (_dependants.empty() == false);
+            }
+            void Report(Commander::Data& data) const
+            {
+                _adminLock.Lock();
+
+                for (const Timing& entry : _report) {
+                    Commander::Step& step(data.Steps.Add());
+
+                    step.Label = entry.Label;
+                    step.Result = entry.Result;
+
+                    if (entry.Start != 0) {
+                        step.Start = (entry.Start - _begin) / Core::Time::MicroSecondsPerMilliSecond;
+                    }
+                    if (entry.End >= entry.Start) {
+                        step.Duration = (entry.End - entry.Start) / Core::Time::MicroSecondsPerMilliSecond;
+                    }
+                }
+
+                uint64_t duration = 0;
+
+                for (const uint32_t index : _criticalPath) {
+                    Core::JSON::String& label(data.CriticalPath.Add());
+                    label = _report[index].Label;
+                    duration += (_report[index].End - _report[index].Start);
+                }
+
+                data.Duration = duration / Core::Time::MicroSecondsPerMilliSecond;
+
+                _adminLock.Unlock();
+            }
             uint32_t Load(const Core::JSON::ArrayType<Command>& commandList)
             {
 
@@ -330,6 +487,12 @@ namespace Plugin {
                         _sequenceList.Clear(0, _sequenceList.Count());
                     }
 
+                    _dependencies.clear();
+                    _dependants.clear();
+                    _jobs.clear();
+
+                    std::list< std::list<string> > labels;
+
                     Core::JSON::ArrayType<Command>::ConstIterator index(commandList.Elements());
 
                     while (index.Next() == true) {
@@ -342,9 +505,24 @@ namespace Plugin {
 
                         if (newCommand.IsValid() == true) {
                             _sequenceList.Add(newCommand);
+
+                            labels.emplace_back();
+
+                            Core::JSON::ArrayType<Core::JSON::String>::ConstIterator dependency(index.Current().Dependencies.Elements());
+
+                            while (dependency.Next() == true) {
+                                labels.back().push_back(dependency.Current().Value());
+                            }
                         }
                     }
 
+                    if ((_sequenceList.Count() > 0) && (Resolve(labels) == false)) {
+                        TRACE_L1("Sequence for %s contains circular dependencies, it is not loaded.", _name.c_str());
+                        _sequenceList.Clear(0, _sequenceList.Count());
+                        _dependencies.clear();
+                        _dependants.clear();
+                    }
+
                     if (_sequenceList.Count() > 0) {
                         _state = Commander::LOADED;
                         _currentIndex = 0;
@@ -380,7 +558,17 @@ namespace Plugin {
                 if (_state == Commander::RUNNING) {
                     result = Core::ERROR_NONE;
                     _state = Commander::ABORTING;
-                    _sequenceList[_currentIndex]->Abort();
+
+                    if (IsParallel() == false) {
+                        _sequenceList[_currentIndex]->Abort();
+                    } else {
+                        // Abort all steps that are in flight, the ones waiting will not be started anymore.
+                        for (uint32_t index = 0; index < _timings.size(); index++) {
+                            if ((_timings[index].Start != 0) && (_timings[index].End == 0)) {
+                                _sequenceList[index]->Abort();
+                            }
+                        }
+                    }
                 }
 
                 _adminLock.Unlock();
@@ -390,14 +578,216 @@ namespace Plugin {
             }
 
         private:
+            // Turn the labels each step depends on into indexes and check that the steps
+            // form a DAG. Only if one of the steps declares a dependency, the sequence is
+            // run in parallel, otherwise the steps run in order (and may jump by label).
+            bool Resolve(const std::list< std::list<string> >& labels)
+            {
+                bool parallel = false;
+                const uint32_t count = _sequenceList.Count();
+
+                _dependencies.assign(count, std::vector<uint32_t>());
+
+                uint32_t step = 0;
+                for (const std::list<string>& entry : labels) {
+                    for (const string& label : entry) {
+                        uint32_t index = 0;
+
+                        while ((index < count) && (_sequenceList[index]->Label() != label)) {
+                            index++;
+                        }
+
+                        if ((index < count) && (index != step)) {
+                            _dependencies[step].push_back(index);
+                            parallel = true;
+                        } else {
+                            TRACE_L1("Dependency [%s] of step %d can not be resolved, ignored.", label.c_str(), step);
+                        }
+                    }
+                    step++;
+                }
+
+                bool result = true;
+
+                if (parallel == true) {
+                    std::vector<uint32_t> waiting(count);
+                    std::list<uint32_t> ready;
+
+                    _dependants.assign(count, std::vector<uint32_t>());
+
+                    for (uint32_t index = 0; index < count; index++) {
+                        waiting[index] = static_cast<uint32_t>(_dependencies[index].size());
+
+                        for (const uint32_t dependency : _dependencies[index]) {
+                            _dependants[dependency].push_back(index);
+                        }
+                        if (waiting[index] == 0) {
+                            ready.push_back(index);
+                        }
+                        _jobs.push_back(Core::ProxyType<StepJob>::Create(*this, index));
+                    }
+
+                    // Kahn: if not all steps can be reached, there is a cycle.
+                    uint32_t reached = 0;
+
+                    while (ready.empty() == false) {
+                        const uint32_t index = ready.front();
+                        ready.pop_front();
+                        reached++;
+
+                        for (const uint32_t dependant : _dependants[index]) {
+                            if (--waiting[dependant] == 0) {
+                                ready.push_back(dependant);
+                            }
+                        }
+                    }
+
+                    result = (reached == count);
+                } else {
+                    _dependencies.clear();
+                }
+
+                return (result);
+            }
+
+            void Start()
+            {
+                const uint32_t count = _sequenceList.Count();
+
+                _timings.assign(count, Timing { EMPTY_STRING, EMPTY_STRING, 0, 0, NoStep });
+
+                for (uint32_t index = 0; index < count; index++) {
+                    _timings[index].Label = _sequenceList[index]->Label();
+                }
+
+                _begin = Core::Time::Now().Ticks();
+            }
+
+            void Completed()
+            {
+                // Build the report of this run. The critical path is found by walking back
+                // from the step that finished last, over the predecessor that finished last.
+                _report = _timings;
+                _criticalPath.clear();
+
+                if (IsParallel() == true) {
+                    for (uint32_t index = 0; index < _report.size(); index++) {
+                        uint64_t latest = 0;
+
+                        for (const uint32_t dependency : _dependencies[index]) {
+                            if (_report[dependency].End > latest) {
+                                latest = _report[dependency].End;
+                                _report[index].Predecessor = dependency;
+                            }
+                        }
+                    }
+                }
+
+                uint32_t last = NoStep;
+                uint64_t latest = 0;
+
+                for (uint32_t index = 0; index < _report.size(); index++) {
+                    if (_report[index].End > latest) {
+                        latest = _report[index].End;
+                        last = index;
+                    }
+                }
+
+                std::vector<bool> visited(_report.size(), false);
+
+                while ((last != NoStep) && (visited[last] == false)) {
+                    visited[last] = true;
+                    _criticalPath.push_front(last);
+                    last = _report[last].Predecessor;
+                }
+
+                ASSERT((_state == Commander::RUNNING) || (_state == Commander::ABORTING));
+                _state = IDLE;
+
+                _sequenceList.Clear(0, _sequenceList.Count());
+            }
+
+            void Run(const uint32_t index)
+            {
+                _adminLock.Lock();
+
+                if (_state == Commander::RUNNING) {
+                    Core::ProxyType<Exchange::ICommand> step(_sequenceList[index]);
+
+                    _currentIndex = index;
+                    _timings[index].Start = Core::Time::Now().Ticks();
+
+                    _adminLock.Unlock();
+
+                    const string result = step->Execute(_service);
+
+                    _adminLock.Lock();
+
+                    _timings[index].End = Core::Time::Now().Ticks();
+                    _timings[index].Result = result;
+
+                    // Release all steps that were only waiting for this one.
+                    for (const uint32_t dependant : _dependants[index]) {
+                        if ((--_waiting[dependant] == 0) && (_state == Commander::RUNNING)) {
+                            Core::ProxyType<Core::IDispatchType<void>> job(Core::proxy_cast<Core::IDispatchType<void>>(_jobs[dependant]));
+                            _running++;
+                            Core::IWorkerPool::Instance().Submit(job);
+                        }
+                    }
+                }
+
+                _running--;
+
+                if (_running == 0) {
+                    Completed();
+                }
+
+                _adminLock.Unlock();
+            }
+
             virtual void Dispatch()
             {
                 _adminLock.Lock();
 
+                Start();
+
+                if (IsParallel() == true) {
+                    _running = 0;
+                    _waiting.assign(_sequenceList.Count(), 0);
+
+                    for (uint32_t index = 0; index < _waiting.size(); index++) {
+                        _waiting[index] = static_cast<uint32_t>(_dependencies[index].size());
+                    }
+
+                    // Kick off all steps without dependencies, the rest follows as they complete.
+                    for (uint32_t index = 0; (index < _waiting.size()) && (_state == Commander::RUNNING); index++) {
+                        if (_waiting[index] == 0) {
+                            Core::ProxyType<Core::IDispatchType<void>> job(Core::proxy_cast<Core::IDispatchType<void>>(_jobs[index]));
+                            _running++;
+                            Core::IWorkerPool::Instance().Submit(job);
+                        }
+                    }
+
+                    if (_running == 0) {
+                        Completed();
+                    }
+
+                    _adminLock.Unlock();
+
+                    return;
+                }
+
+                uint32_t previous = NoStep;
+
                 // See if we still need to take some "next steps"
                 while ((_currentIndex < _sequenceList.Count()) && (_state == Commander::RUNNING)) {
 
                     Core::ProxyType<Exchange::ICommand> step(_sequenceList[_currentIndex]);
+                    Timing& timing(_timings[_currentIndex]);
+
+                    timing.Predecessor = previous;
+                    timing.Start = Core::Time::Now().Ticks();
+                    previous = _currentIndex;
 
                     _adminLock.Unlock();
 
@@ -405,6 +795,9 @@ namespace Plugin {
 
                     _adminLock.Lock();
 
+                    timing.End = Core::Time::Now().Ticks();
+                    timing.Result = result;
+
                     if (result.empty() == true) {
                         _currentIndex++;
                     } else {
@@ -437,10 +830,7 @@ namespace Plugin {
                     }
                 }
 
-                ASSERT((_state == Commander::RUNNING) || (_state == Commander::ABORTING));
-                _state = IDLE;
-
-                _sequenceList.Clear(0, _sequenceList.Count());
+                Completed();
 
                 _adminLock.Unlock();
             }
@@ -453,6 +843,15 @@ namespace Plugin {
             string _name;
             PluginHost::IShell* _service;
             Core::ProxyList<Exchange::ICommand> _sequenceList;
+            std::vector< std::vector<uint32_t> > _dependencies;
+            std::vector< std::vector<uint32_t> > _dependants;
+            std::vector<uint32_t> _waiting;
+            std::vector< Core::ProxyType<StepJob> > _jobs;
+            std::vector<Timing> _timings;
+            uint32_t _running;
+            uint64_t _begin;
+            std::vector<Timing> _report;
+            std::list<uint32_t> _criticalPath;
         };
 
         Commander(const Commander&) = delete;
@@ -35,6 +35,11 @@ namespace Plugin {
         return (layerName);
     }
 
+    static bool IsEqual(const Exchange::IComposition::Rectangle& lhs, const Exchange::IComposition::Rectangle& rhs)
+    {
+        return ((lhs.x == rhs.x) && (lhs.y == rhs.y) && (lhs.width == rhs.width) && (lhs.height == rhs.height));
+    }
+
     struct client_info {
         uint16_t layer;
         string   name;
@@ -43,10 +48,13 @@ namespace Plugin {
 
     static void SetZOrderList (std::list<client_info>& list, uint16_t index = 0) {
 
-        // Time to set the new ZOrder. All effected clients have been listed...
+        // Time to set the new ZOrder. All effected clients have been listed, only
+        // the ones that actually change position need to be reported to the backend.
         std::list<client_info>::iterator loop(list.begin());
         while (loop != list.end()) {
-            loop->access->ZOrder(index);
+            if (loop->layer != index) {
+                loop->access->ZOrder(index);
+            }
             index++;
             loop++;
         }
@@ -149,7 +157,11 @@ namespace Plugin {
         , _connectionId()
         , _inputSwitch(nullptr)
         , _inputSwitchCallsign()
-
+        , _geometries()
+        , _pending()
+        , _vsyncInterval(0)
+        , _scheduled(false)
+        , _geometryJob(*this)
     {
         RegisterAll();
     }
@@ -170,6 +182,7 @@ namespace Plugin {
         config.FromString(service->ConfigLine());
 
         _skipURL = service->WebPrefix().length();
+        _vsyncInterval = config.VSyncInterval.Value();
 
         // See if the mandatory XDG environment variable is set, otherwise we will set it.
         if (Core::SystemInfo::GetEnvironment(_T("XDG_RUNTIME_DIR"), result) == false) {
@@ -203,6 +216,13 @@ namespace Plugin {
     {
         ASSERT(service == _service);
 
+        _geometryJob.Revoke();
+
+        _adminLock.Lock();
+        _pending.clear();
+        _scheduled = false;
+        _adminLock.Unlock();
+
         // We would actually need to handle setting the Graphics event in the CompositorImplementation. For now, we do it here.
         PluginHost::ISubSystem* subSystems = _service->SubSystems();
 
@@ -399,7 +419,7 @@ namespace Plugin {
         ASSERT(client != nullptr);
 
         if (client != nullptr) {
-            client_info entry = { 0, name, client };
+            client_info entry = { static_cast<uint16_t>(~0), name, client };
             std::list<client_info> list;
 
             _adminLock.Lock();
@@ -419,6 +439,7 @@ namespace Plugin {
             SetZOrderList(list, 0);
 
             _clients[name] = client;
+            _geometries[name] = client->Geometry();
 
             client->AddRef();
 
@@ -441,6 +462,8 @@ namespace Plugin {
             TRACE(Trace::Information, (_T("Client %s detached"), it->first.c_str()));
             _clients.erase(it);
 
+            _geometries.erase(name);
+
             removedclient->Release();
         }
 
@@ -535,21 +558,41 @@ namespace Plugin {
 
     uint32_t Compositor::Geometry(const string& callsign, const Exchange::IComposition::Rectangle& rectangle)
     {
-        uint32_t result = Core::ERROR_UNAVAILABLE;
+        Geometries rectangles;
+        rectangles[callsign] = rectangle;
+
+        return (SetGeometries(rectangles));
+    }
+
+    // The new geometries are applied asynchronously (see Flush()), success means they were accepted. Until
+    // then Geometry(callsign) reports the pending value, a failure to apply it is only logged.
+    uint32_t Compositor::SetGeometries(const Geometries& rectangles)
+    {
+        uint32_t result = Core::ERROR_NONE;
 
         _adminLock.Lock();
 
-        Clients::iterator it = _clients.begin();
+        Geometries::const_iterator index(rectangles.cbegin());
 
-        while (it != _clients.end()) {
-            string current (PrimaryName(it->first));
-            if (callsign == current) {
-                it->second->Geometry(rectangle);
-                result = Core::ERROR_NONE;
+        while (index != rectangles.cend()) {
+            Clients::const_iterator it(_clients.cbegin());
 
-                TRACE(Trace::Information, (_T("Geometry x=%d y=%d width=%d height=%d is set for client surface %s"), rectangle.x, rectangle.y, rectangle.width, rectangle.height, callsign.c_str()));
+            while ((it != _clients.cend()) && (PrimaryName(it->first) != index->first)) {
+                it++;
             }
-            it++;
+
+            if (it == _clients.cend()) {
+                result = Core::ERROR_UNAVAILABLE;
+            } else {
+                // Last one wins, all updates within one vsync interval are applied in one go.
+                _pending[index->first] = index->second;
+            }
+            index++;
+        }
+
+        if ((_pending.empty() == false) && (_scheduled == false)) {
+            _scheduled = true;
+            _geometryJob.Submit(_vsyncInterval);
         }
 
         _adminLock.Unlock();
@@ -557,16 +600,69 @@ namespace Plugin {
         return (result);
     }
 
+    void Compositor::Flush()
+    {
+        _adminLock.Lock();
+
+        Geometries pending;
+        pending.swap(_pending);
+        _scheduled = false;
+
+        Geometries::const_iterator index(pending.cbegin());
+
+        while (index != pending.cend()) {
+            Clients::iterator it(_clients.begin());
+
+            while (it != _clients.end()) {
+                if (PrimaryName(it->first) == index->first) {
+                    Exchange::IComposition::Rectangle& current(_geometries[it->first]);
+
+                    // Only surfaces that really moved or resized need to be recomposed.
+                    if (IsEqual(current, index->second) == false) {
+                        const uint32_t result = it->second->Geometry(index->second);
+
+                        if (result == Core::ERROR_NONE) {
+                            current = index->second;
+
+                            TRACE(Trace::Information, (_T("Geometry x=%d y=%d width=%d height=%d is set for client surface %s"), index->second.x, index->second.y, index->second.width, index->second.height, it->first.c_str()));
+                        } else {
+                            // The request was already acknowledged, the model keeps the geometry the surface really has.
+                            TRACE(Trace::Error, (_T("Geometry x=%d y=%d width=%d height=%d could not be set for client surface %s, error: %d"), index->second.x, index->second.y, index->second.width, index->second.height, it->first.c_str(), result));
+                        }
+                    }
+                }
+                it++;
+            }
+            index++;
+        }
+
+        _adminLock.Unlock();
+    }
+
     Exchange::IComposition::Rectangle Compositor::Geometry(const string& callsign) const
     {
         Exchange::IComposition::Rectangle result { 0,0,0,0 };
-        Exchange::IComposition::IClient* client(InterfaceByCallsign(callsign));
 
-        if (client != nullptr) {
-            result = client->Geometry();
-            client->Release();
+        _adminLock.Lock();
+
+        Geometries::const_iterator pending(_pending.find(callsign));
+
+        if (pending != _pending.cend()) {
+            result = pending->second;
+        } else {
+            Geometries::const_iterator index(_geometries.cbegin());
+
+            while ((index != _geometries.cend()) && (PrimaryName(index->first) != callsign)) {
+                index++;
+            }
+
+            if (index != _geometries.cend()) {
+                result = index->second;
+            }
         }
 
+        _adminLock.Unlock();
+
         return (result);
     }
 
@@ -99,8 +99,48 @@ namespace Plugin {
             PluginHost::IShell* _service;
         };
 
+        class GeometryJob {
+        public:
+            GeometryJob() = delete;
+            GeometryJob(const GeometryJob&) = delete;
+            GeometryJob& operator=(const GeometryJob&) = delete;
+
+            GeometryJob(Compositor& parent)
+                : _parent(parent)
+                , _job(*this)
+            {
+            }
+            ~GeometryJob() = default;
+
+        public:
+            void Submit(const uint16_t delay)
+            {
+                if (delay == 0) {
+                    _job.Submit();
+                } else {
+                    _job.Schedule(Core::Time::Now().Add(delay));
+                }
+            }
+            void Revoke()
+            {
+                _job.Revoke();
+            }
+
+        private:
+            friend Core::ThreadPool::JobType<GeometryJob&>;
+            void Dispatch()
+            {
+                _parent.Flush();
+            }
+
+        private:
+            Compositor& _parent;
+            Core::WorkerPool::JobType<GeometryJob&> _job;
+        };
+
     public:
         typedef std::map<string, Exchange::IComposition::IClient*> Clients;
+        typedef std::map<string, Exchange::IComposition::Rectangle> Geometries;
 
         class Config : public Core::JSON::Container {
         public:
@@ -113,10 +153,12 @@ namespace Plugin {
                 , System(_T("Controller"))
                 , WorkDir()
                 , InputSwitch(_T("InputSwitch"))
+                , VSyncInterval(16)
             {
                 Add(_T("system"), &System);
                 Add(_T("workdir"), &WorkDir);
                 Add(_T("inputswitch"), &InputSwitch);
+                Add(_T("vsyncinterval"), &VSyncInterval);
             }
             ~Config()
             {
@@ -126,6 +168,74 @@ namespace Plugin {
             Core::JSON::String System;
             Core::JSON::String WorkDir;
             Core::JSON::String InputSwitch;
+            Core::JSON::DecUInt16 VSyncInterval;
+        };
+
+        class ClientGeometry : public Core::JSON::Container {
+        public:
+            ClientGeometry()
+                : Core::JSON::Container()
+            {
+                Init();
+            }
+            ClientGeometry(const ClientGeometry& copy)
+                : Core::JSON::Container()
+                , Client(copy.Client)
+                , X(copy.X)
+                , Y(copy.Y)
+                , Width(copy.Width)
+                , Height(copy.Height)
+            {
+                Init();
+            }
+            ClientGeometry& operator=(const ClientGeometry& rhs)
+            {
+                Client = rhs.Client;
+                X = rhs.X;
+                Y = rhs.Y;
+                Width = rhs.Width;
+                Height = rhs.Height;
+                return (*this);
+            }
+            ~ClientGeometry()
+            {
+            }
+
+        private:
+            void Init()
+            {
+                Add(_T("client"), &Client);
+                Add(_T("x"), &X);
+                Add(_T("y"), &Y);
+                Add(_T("width"), &Width);
+                Add(_T("height"), &Height);
+            }
+
+        public:
+            Core::JSON::String Client;
+            Core::JSON::DecUInt32 X;
+            Core::JSON::DecUInt32 Y;
+            Core::JSON::DecUInt32 Width;
+            Core::JSON::DecUInt32 Height;
+        };
+
+        class SetGeometriesParamsData : public Core::JSON::Container {
+        private:
+            SetGeometriesParamsData(const SetGeometriesParamsData&) = delete;
+            SetGeometriesParamsData& operator=(const SetGeometriesParamsData&) = delete;
+
+        public:
+            SetGeometriesParamsData()
+                : Core::JSON::Container()
+            {
+                Add(_T("geometries"), &Geometries);
+            }
+            ~SetGeometriesParamsData()
+            {
+            }
+
+        public:
+            Core::JSON::ArrayType<ClientGeometry> Geometries;
         };
 
         class Data : public Core::JSON::Container {
@@ -196,7 +306,9 @@ namespace Plugin {
         uint32_t Opacity(const string& callsign, const uint32_t value);
         uint32_t Visible(const string& callsign, const bool visible);
         uint32_t Geometry(const string& callsign, const Exchange::IComposition::Rectangle& rectangle);
+        uint32_t SetGeometries(const Geometries& rectangles);
         Exchange::IComposition::Rectangle Geometry(const string& callsign) const;
+        void Flush();
         uint32_t ToTop(const string& callsign, Exchange::IComposition::IClient* client);
         uint32_t ToTop(const string& callsign);
         uint32_t Select(const string& callsign);
@@ -223,6 +335,7 @@ namespace Plugin {
         uint32_t endpoint_putontop(const JsonData::Compositor::PutontopParamsInfo& params);
         uint32_t endpoint_select(const JsonData::Compositor::PutontopParamsInfo& params);
         uint32_t endpoint_putbelow(const JsonData::Compositor::PutbelowParamsData& params);
+        uint32_t endpoint_setgeometries(const SetGeometriesParamsData& params);
         uint32_t get_resolution(Core::JSON::EnumType<JsonData::Compositor::ResolutionType>& response) const;
         uint32_t set_resolution(const Core::JSON::EnumType<JsonData::Compositor::ResolutionType>& param);
         uint32_t get_zorder(Core::JSON::ArrayType<Core::JSON::String>& response) const;
@@ -241,6 +354,11 @@ namespace Plugin {
         Clients _clients;
         Exchange::IInputSwitch* _inputSwitch;
         string _inputSwitchCallsign;
+        Geometries _geometries;
+        Geometries _pending;
+        uint16_t _vsyncInterval;
+        bool _scheduled;
+        GeometryJob _geometryJob;
     };
 }
 }
@@ -35,6 +35,7 @@ namespace Plugin {
         Register<PutontopParamsInfo,void>(_T("putontop"), &Compositor::endpoint_putontop, this);
         Register<PutontopParamsInfo,void>(_T("select"), &Compositor::endpoint_select, this);
         Register<PutbelowParamsData,void>(_T("putbelow"), &Compositor::endpoint_putbelow, this);
+        Register<SetGeometriesParamsData,void>(_T("setgeometries"), &Compositor::endpoint_setgeometries, this);
         Property<Core::JSON::EnumType<ResolutionType>>(_T("resolution"), &Compositor::get_resolution, &Compositor::set_resolution, this);
         Property<Core::JSON::ArrayType<Core::JSON::String>>(_T("zorder"), &Compositor::get_zorder, nullptr, this);
         Property<GeometryData>(_T("geometry"), &Compositor::get_geometry, &Compositor::set_geometry, this);
@@ -55,6 +56,7 @@ namespace Plugin {
         Unregister(_T("geometry"));
         Unregister(_T("zorder"));
         Unregister(_T("resolution"));
+        Unregister(_T("setgeometries"));
         Unregister(_T("putbelow"));
         Unregister(_T("select"));
         Unregister(_T("putontop"));
@@ -98,6 +100,29 @@ namespace Plugin {
         return PutBefore(relative, client);
     }
 
+    // Method: setgeometries - Sets the geometry of several client surfaces in one batch
+    // Return codes:
+    //  - ERROR_NONE: Success
+    //  - ERROR_UNAVAILABLE: Client(s) not found
+    uint32_t Compositor::endpoint_setgeometries(const SetGeometriesParamsData& params)
+    {
+        Geometries rectangles;
+
+        Core::JSON::ArrayType<ClientGeometry>::ConstIterator index(params.Geometries.Elements());
+
+        while (index.Next() == true) {
+            const ClientGeometry& entry(index.Current());
+            Exchange::IComposition::Rectangle& rectangle(rectangles[entry.Client.Value()]);
+
+            rectangle.x = entry.X.Value();
+            rectangle.y = entry.Y.Value();
+            rectangle.width = entry.Width.Value();
+            rectangle.height = entry.Height.Value();
+        }
+
+        return (SetGeometries(rectangles));
+    }
+
     // Property: resolution - Screen resolution
     // Return codes:
     //  - ERROR_NONE: Success
@@ -85,6 +85,7 @@ namespace Plugin {
                 : _surface(*surface)
                 , _server(server)
                 , _rectangle( {0, 0, surface->Width(), surface->Height() } )
+                , _layer(static_cast<uint16_t>(~0))
             {
                 ASSERT(surface != nullptr);
                 ASSERT(server != nullptr);
@@ -133,8 +134,10 @@ namespace Plugin {
             }
             uint32_t Geometry(const Exchange::IComposition::Rectangle& rectangle) override 
             {
-                _rectangle = rectangle;
-                _surface.Resize(rectangle.x, rectangle.y, rectangle.width, rectangle.height);
+                if ((rectangle.x != _rectangle.x) || (rectangle.y != _rectangle.y) || (rectangle.width != _rectangle.width) || (rectangle.height != _rectangle.height)) {
+                    _rectangle = rectangle;
+                    _surface.Resize(rectangle.x, rectangle.y, rectangle.width, rectangle.height);
+                }
 
                 return (Core::ERROR_NONE);
             }
@@ -144,8 +147,10 @@ namespace Plugin {
             }
             uint32_t ZOrder(const uint16_t index) override
             {
-                _layer = index;
-                _surface.ZOrder(index);
+                if (index != _layer) {
+                    _layer = index;
+                    _surface.ZOrder(index);
+                }
 
                 return (Core::ERROR_NONE);
             }
@@ -32,6 +32,9 @@ namespace Plugin {
     static const string _DefaultAppInfoDevice(_T("DeviceInfo.xml"));
     static const string _DefaultRunningExtension(_T("Running"));
     static const string _SystemApp(_T("system"));
+    static const string _CacheControl(_T("max-age=1800"));
+    static const string _ServerName(_T("Linux/2.6 UPnP/1.0 quick_ssdp/1.0"));
+    static const string _UniqueServiceName(_T("uuid:UniqueIdentifier::") + _SearchTarget);
 
     constexpr char kHideCommand[] = "hide";
     static const string kVersionSupportedByClientQueryKey(_T("clientDialVer"));
@@ -56,21 +59,9 @@ namespace Plugin {
         WebFlow& operator=(const WebFlow& a_RHS) = delete;
 
     public:
-        WebFlow(const Core::ProxyType<Web::Request>& request, const Core::NodeId& nodeId)
+        WebFlow(const string& message, const Core::NodeId& nodeId)
         {
-            if (request.IsValid() == true) {
-                string text;
-                request->ToString(text);
-                _text = Core::ToString(string("\n[" + nodeId.HostAddress() + ']' + text + '\n'));
-            }
-        }
-        WebFlow(const Core::ProxyType<Web::Response>& response, const Core::NodeId& nodeId)
-        {
-            if (response.IsValid() == true) {
-                string text;
-                response->ToString(text);
-                _text = Core::ToString(string("\n[" + nodeId.HostAddress() + ']' + text + '\n'));
-            }
+            _text = Core::ToString(string("\n[" + nodeId.HostAddress() + ']' + message + '\n'));
         }
         ~WebFlow()
         {
@@ -90,117 +81,136 @@ namespace Plugin {
         std::string _text;
     };
 
-    uint16_t DIALServer::WebTransform::Transform(Web::Request::Deserializer& deserializer, uint8_t* dataFrame, const uint16_t maxSendSize)
+    static string Upper(string text)
     {
-        uint16_t index = 0;
-        const uint8_t* checker = dataFrame;
-
-        // This is a UDP service, so a message should be complete. If the first keyword is not a keyword we
-        // expect, ignore the full message, it is not a DIAL server package and does not require any further
-        // processing.
-        // First skip the white sace, if applicable...
-        while (isspace(*checker)) {
-            checker++;
-        }
-
-        // Now see if the first keyword is "M-SEARCH"
-        while ((index < _keywordLength) && (toupper(*checker) == Web::Request::MSEARCH[index])) {
-            checker++;
-            index++;
-        }
-
-        // Now we need to find the keyword "M-SEARCH" see if we have it..
-        if (index == _keywordLength) {
-            deserializer.Flush();
-            index = deserializer.Deserialize(dataFrame, maxSendSize);
-        } else {
-            index = maxSendSize;
-        }
-
-        return (index);
+        std::transform(text.begin(), text.end(), text.begin(), ::toupper);
+        return (text);
     }
 
     DIALServer::DIALServerImpl::DIALServerImpl(const string& MACAddress, const string& baseURL, const string& appPath)
-        : BaseClass(5, false, Core::NodeId(DialServerInterface.AnyInterface(), DialServerInterface.PortNumber()), DialServerInterface.AnyInterface(), 1024, 1024)
-        , _response(Core::ProxyType<Web::Response>::Create())
-        , _destinations()
+        : Core::SocketDatagram(false, Core::NodeId(DialServerInterface.AnyInterface(), DialServerInterface.PortNumber()), DialServerInterface.AnyInterface(), 1024, 1024)
+        , _lock()
         , _baseURL(baseURL)
         , _appPath(appPath)
+        , _searchResponse()
+        , _notification()
+        , _requesters()
+        , _outgoing()
+        , _nextNotify(0)
+        , _wakeUp(~0)
+        , _random(static_cast<uint32_t>(Core::Time::Now().Ticks()))
+        , _job(*this)
     {
-        _response->ErrorCode = Web::STATUS_OK;
-        _response->Message = _T("OK");
-        _response->CacheControl = _T("max-age=1800");
-        _response->Server = _T("Linux/2.6 UPnP/1.0 quick_ssdp/1.0");
-        _response->ST = _SearchTarget;
-        _response->USN = _T("uuid:UniqueIdentifier::") + _SearchTarget;
-        // FIXME: Uncomment when adding WoL/WoWLAN support.
+        // FIXME: Add a WAKEUP header when adding WoL/WoWLAN support.
         // This SHALL NOT be present if neither WoL nor WoWLAN is supported.
         // Moreover real MAC address of the network iface (either wired or wireless one) should be passed
         // where currently Device identifier is passed in MACAddress.
-        // _response->WakeUp = _T("MAC=") + MACAddress + _T(";Timeout=10");
-        _response->Mode(Web::MARSHAL_UPPERCASE);
+        // _T("WAKEUP: MAC=") + MACAddress + _T(";Timeout=10")
 
-        if (Link().Open(1000) != Core::ERROR_NONE) {
+        if (SocketDatagram::Open(1000) != Core::ERROR_NONE) {
             ASSERT(false && "Seems we can not open the DIAL discovery port");
         }
 
-        Link().Join(DialServerInterface);
+        SocketDatagram::Join(DialServerInterface);
+
+        // Announce ourselves right away.
+        WakeUp(Core::Time::Now().Ticks());
     }
 
     /* virtual */ DIALServer::DIALServerImpl::~DIALServerImpl()
     {
-        Link().Leave(DialServerInterface);
-        Link().Close(Core::infinite);
+        _job.Revoke();
+
+        SocketDatagram::Leave(DialServerInterface);
+        SocketDatagram::Close(Core::infinite);
     }
 
-    // Notification of a Partial Request received, time to attach a body..
-    /* virtual */ void DIALServer::DIALServerImpl::LinkBody(Core::ProxyType<Web::Request>& element)
+    void DIALServer::DIALServerImpl::Locator(const string& hostName)
     {
-        // upnp requests are empty so no body needed...
+        bool changed = false;
+
+        _lock.Lock();
+
+        if (_baseURL != hostName) {
+            _baseURL = hostName;
+
+            // Everything we rendered so far carries the old location, announce the new one right away.
+            _searchResponse.clear();
+            _notification.clear();
+            _nextNotify = 0;
+            changed = true;
+        }
+
+        _lock.Unlock();
+
+        if (changed == true) {
+            WakeUp(Core::Time::Now().Ticks());
+        }
     }
-    // Notification of a Partial Request received, time to attach a body..
-    // upnp requests are empty so no body needed...
-    /* virtual */ void DIALServer::DIALServerImpl::Received(Core::ProxyType<Web::Request>& request)
-    {
-        Core::NodeId sourceNode(Link().ReceivedNode());
-        TRACE(WebFlow, (request, sourceNode));
 
-        if ((request->Verb == Web::Request::HTTP_MSEARCH) && (request->ST.IsSet() == true)) {
-            if (request->ST.Value() == _SearchTarget) {
+    /* virtual */ uint16_t DIALServer::DIALServerImpl::SendData(uint8_t* dataFrame, const uint16_t maxSendSize)
+    {
+        uint16_t result = 0;
 
-                TRACE(Protocol, (&(*request)));
-                _destinations.push_back(sourceNode);
-                // remember the NodeId where this comes from.
-                if (_destinations.size() == 1) {
+        _lock.Lock();
 
-                    Link().RemoteNode(_destinations.front());
+        if (_outgoing.empty() == false) {
+            const std::pair<Core::NodeId, bool>& entry(_outgoing.front());
+            const string& message(entry.second == true ? Notification() : SearchResponse());
 
-                    _response->Location = URL() + '/' + _DefaultAppInfoDevice;
+            if (message.length() <= maxSendSize) {
+                TRACE(WebFlow, (message, entry.first));
 
-                    Submit(_response);
-                }
+                SocketDatagram::RemoteNode(entry.first);
+                result = static_cast<uint16_t>(message.length());
+                ::memcpy(dataFrame, message.c_str(), result);
             }
+
+            _outgoing.pop_front();
         }
+
+        _lock.Unlock();
+
+        return (result);
     }
 
-    // Notification of a Response send.
-    /* virtual */ void DIALServer::DIALServerImpl::Send(const Core::ProxyType<Web::Response>& response)
+    /* virtual */ uint16_t DIALServer::DIALServerImpl::ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize)
     {
-        TRACE(WebFlow, (response, _destinations.front()));
+        uint8_t delay;
+
+        if (IsSearch(dataFrame, receivedSize, delay) == true) {
+            const Core::NodeId sourceNode(SocketDatagram::ReceivedNode());
+            const string key(sourceNode.HostAddress() + ':' + Core::NumberType<uint16_t>(sourceNode.PortNumber()).Text());
+            const uint64_t now(Core::Time::Now().Ticks());
+            uint64_t due = 0;
 
-        TRACE(Protocol, (&(*response)));
+            TRACE(WebFlow, (string(reinterpret_cast<const char*>(dataFrame), receivedSize), sourceNode));
 
-        // Drop the current destination.
-        _destinations.pop_front();
+            _lock.Lock();
 
-        if (_destinations.size() > 0) {
-            _response->Location = URL() + '/' + _DefaultAppInfoDevice;
+            std::map<string, Requester>::iterator index(_requesters.find(key));
 
-            // Move on to notifying the next one.
-            Link().RemoteNode(_destinations.front());
+            if ((index == _requesters.end()) || (index->second.Until <= now)) {
+                Requester& requester(_requesters[key]);
 
-            Submit(response);
+                // Spread the answers over the window the requester asked for (UPnP 1.1 section 1.3.3), a
+                // requester that repeats its search within that window gets only one answer.
+                due = now + ((delay == 0) ? 0 : ((_random() % (delay * 1000)) * Core::Time::MicroSecondsPerMilliSecond));
+
+                requester.Node = sourceNode;
+                requester.Due = due;
+                requester.Until = now + (std::max(delay, static_cast<uint8_t>(1)) * Core::Time::MicroSecondsPerSecond);
+                requester.Answered = false;
+            }
+
+            _lock.Unlock();
+
+            if (due != 0) {
+                WakeUp(due);
+            }
         }
+
+        return (receivedSize);
     }
 
     // Notification of a channel state change..
@@ -208,6 +218,154 @@ namespace Plugin {
     {
     }
 
+    bool DIALServer::DIALServerImpl::IsSearch(const uint8_t dataFrame[], const uint16_t length, uint8_t& delay) const
+    {
+        // This is a UDP service, so a message should be complete. If the first keyword is not M-SEARCH, it is
+        // not a request we answer (our own NOTIFY messages loop back as well) and it needs no further processing.
+        const string message(reinterpret_cast<const char*>(dataFrame), length);
+        const string keyword(Web::Request::MSEARCH);
+        bool result = false;
+
+        delay = 0;
+
+        string::size_type start = message.find_first_not_of(_T(" \t\r\n"));
+
+        if ((start != string::npos) && (Upper(message.substr(start, keyword.length())) == keyword)) {
+
+            start = message.find('\n', start);
+
+            while (start != string::npos) {
+                string::size_type end = message.find('\n', ++start);
+                string line(message.substr(start, (end == string::npos ? end : end - start)));
+                string::size_type colon = line.find(':');
+
+                if (colon != string::npos) {
+                    string key(Upper(line.substr(0, colon)));
+                    string value(line.substr(colon + 1));
+
+                    key.erase(key.find_last_not_of(_T(" \t")) + 1);
+                    value.erase(0, value.find_first_not_of(_T(" \t")));
+                    value.erase(value.find_last_not_of(_T(" \t\r")) + 1);
+
+                    if (key == _T("ST")) {
+                        result = (value == _SearchTarget);
+                    } else if (key == _T("MX")) {
+                        delay = static_cast<uint8_t>(std::min(std::max(::atoi(value.c_str()), 0), static_cast<int>(MaxResponseDelay)));
+                    }
+                }
+
+                start = end;
+            }
+        }
+
+        return (result);
+    }
+
+    // Called with the _lock taken.
+    const string& DIALServer::DIALServerImpl::SearchResponse()
+    {
+        if (_searchResponse.empty() == true) {
+            Web::Response response;
+
+            response.ErrorCode = Web::STATUS_OK;
+            response.Message = _T("OK");
+            response.CacheControl = _CacheControl;
+            response.Server = _ServerName;
+            response.ST = _SearchTarget;
+            response.USN = _UniqueServiceName;
+            response.Location = URL() + '/' + _DefaultAppInfoDevice;
+            response.Mode(Web::MARSHAL_UPPERCASE);
+
+            response.ToString(_searchResponse);
+
+            TRACE(Protocol, (&response));
+        }
+
+        return (_searchResponse);
+    }
+
+    // Called with the _lock taken.
+    const string& DIALServer::DIALServerImpl::Notification()
+    {
+        if (_notification.empty() == true) {
+            _notification = _T("NOTIFY * HTTP/1.1\r\n")
+                            _T("HOST: ") + DialServerInterface.HostAddress() + ':' + Core::NumberType<uint16_t>(DialServerInterface.PortNumber()).Text() + _T("\r\n")
+                            _T("CACHE-CONTROL: ") + _CacheControl + _T("\r\n")
+                            _T("LOCATION: ") + URL() + '/' + _DefaultAppInfoDevice + _T("\r\n")
+                            _T("NT: ") + _SearchTarget + _T("\r\n")
+                            _T("NTS: ssdp:alive\r\n")
+                            _T("SERVER: ") + _ServerName + _T("\r\n")
+                            _T("USN: ") + _UniqueServiceName + _T("\r\n\r\n");
+
+            TRACE(Protocol, (_notification));
+        }
+
+        return (_notification);
+    }
+
+    void DIALServer::DIALServerImpl::WakeUp(const uint64_t time)
+    {
+        _lock.Lock();
+
+        bool earlier = (time < _wakeUp);
+
+        if (earlier == true) {
+            _wakeUp = time;
+        }
+
+        _lock.Unlock();
+
+        // Revoke waits for a running Dispatch, so do not hold the lock here.
+        if (earlier == true) {
+            _job.Revoke();
+            _job.Schedule(Core::Time(time));
+        }
+    }
+
+    void DIALServer::DIALServerImpl::Dispatch()
+    {
+        const uint64_t now(Core::Time::Now().Ticks());
+
+        _lock.Lock();
+
+        if (_nextNotify <= now) {
+            _outgoing.emplace_back(DialServerInterface, true);
+            _nextNotify = now + (NotifyInterval * Core::Time::MicroSecondsPerSecond);
+        }
+
+        uint64_t next = _nextNotify;
+        std::map<string, Requester>::iterator index(_requesters.begin());
+
+        while (index != _requesters.end()) {
+            if (index->second.Answered == false) {
+                if (index->second.Due <= now) {
+                    _outgoing.emplace_back(index->second.Node, false);
+                    index->second.Answered = true;
+                } else if (index->second.Due < next) {
+                    next = index->second.Due;
+                }
+            }
+
+            if ((index->second.Answered == true) && (index->second.Until <= now)) {
+                index = _requesters.erase(index);
+            } else {
+                index++;
+            }
+        }
+
+        _wakeUp = next;
+
+        bool send = (_outgoing.empty() == false);
+
+        _lock.Unlock();
+
+        if (send == true) {
+            SocketDatagram::Trigger();
+        }
+
+        _job.Schedule(Core::Time(next));
+    }
+
     void DIALServer::AppInformation::GetData(string& data, const Version& version) const
     {
         bool running = IsRunning();
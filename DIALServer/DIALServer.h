@@ -25,6 +25,8 @@
 #include <interfaces/IWebServer.h>
 #include <interfaces/IBrowser.h>
 
+#include <random>
+
 namespace WPEFramework {
 namespace Plugin {
 
@@ -583,30 +585,23 @@ namespace Plugin {
         private:
             std::string _text;
         };
-        class WebTransform {
+        // SSDP responder for the DIAL service. M-SEARCH requests are answered after a random share of the
+        // requested MX delay, once per requester within that window, and the service is announced with
+        // NOTIFY messages so controllers have less reason to search. Both messages only depend on the
+        // location, so they are rendered once and reused until the Locator changes.
+        class DIALServerImpl : public Core::SocketDatagram {
         private:
-            WebTransform(const WebTransform&);
-            WebTransform& operator=(const WebTransform&);
-
-        public:
-            inline WebTransform()
-                : _keywordLength(static_cast<uint8_t>(_tcslen(Web::Request::MSEARCH)))
-            {
-            }
-            inline ~WebTransform()
-            {
-            }
+            static const Core::NodeId DialServerInterface;
 
-            // Methods to extract and insert data into the socket buffers
-            uint16_t Transform(Web::Request::Deserializer& deserializer, uint8_t* dataFrame, const uint16_t maxSendSize);
+            static constexpr uint8_t MaxResponseDelay = 5; // s, UPnP caps the MX value here
+            static constexpr uint16_t NotifyInterval = 900; // s, half of the advertised max-age
 
-        private:
-            uint8_t _keywordLength;
-        };
-        class DIALServerImpl : public Web::WebLinkType<Core::SocketDatagram, Web::Request, Web::Response, Core::ProxyPoolType<Web::Request>, WebTransform> {
-        private:
-            static const Core::NodeId DialServerInterface;
-            typedef Web::WebLinkType<Core::SocketDatagram, Web::Request, Web::Response, Core::ProxyPoolType<Web::Request>, WebTransform> BaseClass;
+            struct Requester {
+                Core::NodeId Node;
+                uint64_t Due;
+                uint64_t Until;
+                bool Answered;
+            };
 
             DIALServerImpl(const DIALServerImpl&) = delete;
             DIALServerImpl& operator=(const DIALServerImpl&) = delete;
@@ -616,18 +611,6 @@ namespace Plugin {
             virtual ~DIALServerImpl();
 
         public:
-            // Notification of a Partial Request received, time to attach a body..
-            virtual void LinkBody(Core::ProxyType<Web::Request>& element);
-
-            // Notification of a Request received.
-            virtual void Received(Core::ProxyType<Web::Request>& text);
-
-            // Notification of a Response send.
-            virtual void Send(const Core::ProxyType<Web::Response>& text);
-
-            // Notification of a channel state change..
-            virtual void StateChange();
-
             inline string URL() const
             {
                 string result;
@@ -644,22 +627,36 @@ namespace Plugin {
             {
                 locator = Core::URL(URL());
             }
-            inline void Locator(const string& hostName)
-            {
-                _lock.Lock();
+            void Locator(const string& hostName);
 
-                _baseURL = hostName;
+        private:
+            // Methods to extract and insert data into the socket buffers
+            virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) override;
+            virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) override;
 
-                _lock.Unlock();
-            }
+            // Notification of a channel state change..
+            virtual void StateChange() override;
+
+            bool IsSearch(const uint8_t dataFrame[], const uint16_t length, uint8_t& delay) const;
+            const string& SearchResponse();
+            const string& Notification();
+            void WakeUp(const uint64_t time);
+
+            friend Core::ThreadPool::JobType<DIALServerImpl&>;
+            void Dispatch();
 
         private:
             mutable Core::CriticalSection _lock;
-            // This should be the "Response" as depicted by the parent/DIALserver.
-            Core::ProxyType<Web::Response> _response;
-            std::list<Core::NodeId> _destinations;
             string _baseURL;
             const string _appPath;
+            string _searchResponse;
+            string _notification;
+            std::map<string, Requester> _requesters;
+            std::list<std::pair<Core::NodeId, bool>> _outgoing;
+            uint64_t _nextNotify;
+            uint64_t _wakeUp;
+            std::mt19937 _random;
+            Core::WorkerPool::JobType<DIALServerImpl&> _job;
         };
         class AppInformation {
         private:
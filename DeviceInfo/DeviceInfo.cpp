@@ -24,7 +24,9 @@ namespace Plugin {
 
     SERVICE_REGISTRATION(DeviceInfo, 1, 0);
 
-    static Core::ProxyPoolType<Web::JSONBodyType<DeviceInfo::Data>> jsonResponseFactory(4);
+    static Core::ProxyPoolType<Web::TextBody> textResponseFactory(4);
+
+    static const TCHAR* const GroupNames[] = { _T("systeminfo"), _T("addresses"), _T("sockets") };
 
     /* virtual */ const string DeviceInfo::Initialize(PluginHost::IShell* service)
     {
@@ -42,6 +44,19 @@ namespace Plugin {
 
         ASSERT(_subSystem != nullptr);
 
+        if (_subSystem != nullptr) {
+            const uint16_t intervals[Groups] = { config.SystemInterval.Value(), config.AddressInterval.Value(), config.SocketInterval.Value() };
+            const uint64_t now = Core::Time::Now().Ticks();
+
+            // Take a first sample of everything right away, from here on the job keeps them fresh.
+            for (uint8_t index = 0; index < Groups; index++) {
+                _snapshots[index].Interval = static_cast<uint64_t>(std::max(intervals[index], static_cast<uint16_t>(1))) * Core::Time::TicksPerMillisecond * 1000;
+                Sample(index, now);
+            }
+
+            Dispatch();
+        }
+
         // On success return empty, to indicate there is no error text.
 
         return (_subSystem != nullptr) ? EMPTY_STRING : _T("Could not retrieve System Information.");
@@ -51,6 +66,8 @@ namespace Plugin {
     {
         ASSERT(_service == service);
 
+        _job.Revoke();
+
         if (_subSystem != nullptr) {
             _subSystem->Release();
             _subSystem = nullptr;
@@ -82,7 +99,7 @@ namespace Plugin {
         // <GET> - currently, only the GET command is supported, returning system info
         if (request.Verb == Web::Request::HTTP_GET) {
 
-            Core::ProxyType<Web::JSONBodyType<Data>> response(jsonResponseFactory.Element());
+            Core::ProxyType<Web::TextBody> response(textResponseFactory.Element());
 
             Core::TextSegmentIterator index(Core::TextFragment(request.Path, _skipURL, static_cast<uint32_t>(request.Path.length()) - _skipURL), false, '/');
 
@@ -90,15 +107,19 @@ namespace Plugin {
             index.Next();
 
             if (index.Next() == false) {
-                AddressInfo(response->Addresses);
-                SysInfo(response->SystemInfo);
-                SocketPortInfo(response->Sockets);
+                *response = Compose(SYSTEM | ADDRESSES | SOCKETS, 0, false);
             } else if (index.Current() == "Adresses") {
-                AddressInfo(response->Addresses);
+                *response = Compose(ADDRESSES, 0, false);
             } else if (index.Current() == "System") {
-                SysInfo(response->SystemInfo);
+                *response = Compose(SYSTEM, 0, false);
             } else if (index.Current() == "Sockets") {
-                SocketPortInfo(response->Sockets);
+                *response = Compose(SOCKETS, 0, false);
+            } else if (index.Current() == "Changes") {
+                // Only the groups that changed after the given generation, e.g. /Changes/42
+                uint32_t since = (index.Next() == true ? Core::NumberType<uint32_t>(index.Current()).Value() : 0);
+                *response = Compose(SYSTEM | ADDRESSES | SOCKETS, since, true);
+            } else {
+                *response = _T("{}");
             }
             // TODO RB: I guess we should do something here to return other info (e.g. time) as well.
 
@@ -155,5 +176,125 @@ namespace Plugin {
         socketPortInfo.Runs = Core::ResourceMonitor::Instance().Runs();
     }
 
+    void DeviceInfo::Dispatch()
+    {
+        const uint64_t now = Core::Time::Now().Ticks();
+        uint64_t next = ~0;
+
+        for (uint8_t index = 0; index < Groups; index++) {
+            if (_snapshots[index].Due <= now) {
+                Sample(index, now);
+            }
+            if (_snapshots[index].Due < next) {
+                next = _snapshots[index].Due;
+            }
+        }
+
+        _job.Schedule(Core::Time(next));
+    }
+
+    // Only called from the job (or before it is started), so the Due field does not need the lock.
+    void DeviceInfo::Sample(const uint8_t index, const uint64_t now)
+    {
+        string body;
+        string stable;
+
+        // Counters and clocks change on every sample, they are reported but do not make a new generation.
+        switch (static_cast<group>(1 << index)) {
+        case SYSTEM: {
+            JsonData::DeviceInfo::SysteminfoData data;
+            SysInfo(data);
+            data.ToString(body);
+            data.Time.Clear();
+            data.Uptime.Clear();
+            data.Freeram.Clear();
+            data.Cpuload.Clear();
+            data.ToString(stable);
+            break;
+        }
+        case ADDRESSES: {
+            Core::JSON::ArrayType<JsonData::DeviceInfo::AddressesData> data;
+            AddressInfo(data);
+            data.ToString(body);
+            stable = body;
+            break;
+        }
+        case SOCKETS: {
+            JsonData::DeviceInfo::SocketinfoData data;
+            SocketPortInfo(data);
+            data.ToString(body);
+            data.Runs.Clear();
+            data.ToString(stable);
+            break;
+        }
+        default:
+            ASSERT(false);
+            break;
+        }
+
+        Snapshot& snapshot(_snapshots[index]);
+
+        snapshot.Due = now + snapshot.Interval;
+
+        _adminLock.Lock();
+
+        if ((snapshot.Generation == 0) || (stable != snapshot.Stable)) {
+            snapshot.Stable = std::move(stable);
+            snapshot.Generation = ++_generation;
+        }
+
+        snapshot.Body = std::move(body);
+
+        _adminLock.Unlock();
+    }
+
+    string DeviceInfo::Cached(const group which) const
+    {
+        uint8_t index = 0;
+
+        while ((index < Groups) && ((1 << index) != which)) {
+            index++;
+        }
+
+        ASSERT(index < Groups);
+
+        _adminLock.Lock();
+        string result(_snapshots[index].Body);
+        _adminLock.Unlock();
+
+        return (result);
+    }
+
+    // Put the cached documents of the requested groups, that changed after generation "since", in one
+    // object. With generation set the current generation is reported as well, to be used in the next call.
+    string DeviceInfo::Compose(const uint8_t groups, const uint32_t since, const bool generation) const
+    {
+        string result(1, '{');
+
+        _adminLock.Lock();
+
+        if (generation == true) {
+            result += _T("\"generation\":") + Core::NumberType<uint32_t>(_generation).Text();
+        }
+
+        for (uint8_t index = 0; index < Groups; index++) {
+            if (((groups & (1 << index)) != 0) && (_snapshots[index].Generation > since)) {
+                if (result.length() > 1) {
+                    result += ',';
+                }
+                result += '"';
+                result += GroupNames[index];
+                result += _T("\":");
+                result += _snapshots[index].Body;
+            }
+        }
+
+        _adminLock.Unlock();
+
+        result += '}';
+
+        return (result);
+    }
+
 } // namespace Plugin
 } // namespace WPEFramework
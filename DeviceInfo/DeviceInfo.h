@@ -27,7 +27,71 @@ namespace WPEFramework {
 namespace Plugin {
 
     class DeviceInfo : public PluginHost::IPlugin, public PluginHost::IWeb, public PluginHost::JSONRPC {
+    private:
+        // The information is sampled in the background, every group at its own pace, and kept as
+        // a serialized JSON document. Requests are answered from these documents, every time the
+        // content of a group changes it is stamped with a new generation.
+        enum group : uint8_t {
+            SYSTEM = 0x01,
+            ADDRESSES = 0x02,
+            SOCKETS = 0x04
+        };
+
+        static constexpr uint8_t Groups = 3;
+
+        class Config : public Core::JSON::Container {
+        public:
+            Config(const Config&) = delete;
+            Config& operator=(const Config&) = delete;
+
+            Config()
+                : Core::JSON::Container()
+                , SystemInterval(1)
+                , AddressInterval(10)
+                , SocketInterval(1)
+            {
+                Add(_T("systeminterval"), &SystemInterval);
+                Add(_T("addressinterval"), &AddressInterval);
+                Add(_T("socketinterval"), &SocketInterval);
+            }
+            ~Config() override
+            {
+            }
+
+        public:
+            Core::JSON::DecUInt16 SystemInterval;
+            Core::JSON::DecUInt16 AddressInterval;
+            Core::JSON::DecUInt16 SocketInterval;
+        };
+
+        struct Snapshot {
+            uint64_t Interval;
+            uint64_t Due;
+            uint32_t Generation;
+            string Body;
+            string Stable; // Body without the fields that differ on every sample
+        };
+
     public:
+        class ChangesParams : public Core::JSON::Container {
+        public:
+            ChangesParams(const ChangesParams&) = delete;
+            ChangesParams& operator=(const ChangesParams&) = delete;
+
+            ChangesParams()
+                : Core::JSON::Container()
+                , Since(0)
+            {
+                Add(_T("since"), &Since);
+            }
+            ~ChangesParams() override
+            {
+            }
+
+        public:
+            Core::JSON::DecUInt32 Since;
+        };
+
         class Data : public Core::JSON::Container {
         public:
             Data()
@@ -77,6 +141,10 @@ namespace Plugin {
             , _subSystem(nullptr)
             , _systemId()
             , _deviceId()
+            , _adminLock()
+            , _snapshots()
+            , _generation(0)
+            , _job(*this)
         {
             RegisterAll();
         }
@@ -105,24 +173,36 @@ namespace Plugin {
         virtual Core::ProxyType<Web::Response> Process(const Web::Request& request) override;
 
     private:
+        friend class Core::ThreadPool::JobType<DeviceInfo&>;
+
         // JsonRpc
         void RegisterAll();
         void UnregisterAll();
-        uint32_t get_systeminfo(JsonData::DeviceInfo::SysteminfoData& response) const;
-        uint32_t get_addresses(Core::JSON::ArrayType<JsonData::DeviceInfo::AddressesData>& response) const;
-        uint32_t get_socketinfo(JsonData::DeviceInfo::SocketinfoData& response) const;
+        uint32_t get_systeminfo(Core::JSON::String& response) const;
+        uint32_t get_addresses(Core::JSON::String& response) const;
+        uint32_t get_socketinfo(Core::JSON::String& response) const;
+        uint32_t endpoint_changes(const ChangesParams& params, Core::JSON::String& response) const;
 
         void SysInfo(JsonData::DeviceInfo::SysteminfoData& systemInfo) const;
         void AddressInfo(Core::JSON::ArrayType<JsonData::DeviceInfo::AddressesData>& addressInfo) const;
         void SocketPortInfo(JsonData::DeviceInfo::SocketinfoData& socketPortInfo) const;
         string GetDeviceId() const;
 
+        void Dispatch();
+        void Sample(const uint8_t index, const uint64_t now);
+        string Cached(const group which) const;
+        string Compose(const uint8_t groups, const uint32_t since, const bool generation) const;
+
     private:
         uint8_t _skipURL;
         PluginHost::IShell* _service;
         PluginHost::ISubSystem* _subSystem;
         string _systemId;
         mutable string _deviceId;
+        mutable Core::CriticalSection _adminLock;
+        Snapshot _snapshots[Groups];
+        uint32_t _generation;
+        Core::WorkerPool::JobType<DeviceInfo&> _job;
     };
 
 } // namespace Plugin
@@ -30,13 +30,16 @@ namespace Plugin {
 
     void DeviceInfo::RegisterAll()
     {
-        Property<SysteminfoData>(_T("systeminfo"), &DeviceInfo::get_systeminfo, nullptr, this);
-        Property<Core::JSON::ArrayType<AddressesData>>(_T("addresses"), &DeviceInfo::get_addresses, nullptr, this);
-        Property<SocketinfoData>(_T("socketinfo"), &DeviceInfo::get_socketinfo, nullptr, this);
+        // The properties are answered with the (pre-serialized) snapshots, hence the unquoted strings.
+        Property<Core::JSON::String>(_T("systeminfo"), &DeviceInfo::get_systeminfo, nullptr, this);
+        Property<Core::JSON::String>(_T("addresses"), &DeviceInfo::get_addresses, nullptr, this);
+        Property<Core::JSON::String>(_T("socketinfo"), &DeviceInfo::get_socketinfo, nullptr, this);
+        Register<ChangesParams, Core::JSON::String>(_T("changes"), &DeviceInfo::endpoint_changes, this);
     }
 
     void DeviceInfo::UnregisterAll()
     {
+        Unregister(_T("changes"));
         Unregister(_T("socketinfo"));
         Unregister(_T("addresses"));
         Unregister(_T("systeminfo"));
@@ -48,27 +51,40 @@ namespace Plugin {
     // Property: systeminfo - System general information
     // Return codes:
     //  - ERROR_NONE: Success
-    uint32_t DeviceInfo::get_systeminfo(SysteminfoData& response) const
+    uint32_t DeviceInfo::get_systeminfo(Core::JSON::String& response) const
     {
-        SysInfo(response);
+        response.SetQuoted(false);
+        response = Cached(SYSTEM);
         return Core::ERROR_NONE;
     }
 
     // Property: addresses - Network interface addresses
     // Return codes:
     //  - ERROR_NONE: Success
-    uint32_t DeviceInfo::get_addresses(Core::JSON::ArrayType<AddressesData>& response) const
+    uint32_t DeviceInfo::get_addresses(Core::JSON::String& response) const
     {
-        AddressInfo(response);
+        response.SetQuoted(false);
+        response = Cached(ADDRESSES);
         return Core::ERROR_NONE;
     }
 
     // Property: socketinfo - Socket information
     // Return codes:
     //  - ERROR_NONE: Success
-    uint32_t DeviceInfo::get_socketinfo(SocketinfoData& response) const
+    uint32_t DeviceInfo::get_socketinfo(Core::JSON::String& response) const
     {
-        SocketPortInfo(response);
+        response.SetQuoted(false);
+        response = Cached(SOCKETS);
+        return Core::ERROR_NONE;
+    }
+
+    // Method: changes - The groups that changed after the given generation
+    // Return codes:
+    //  - ERROR_NONE: Success
+    uint32_t DeviceInfo::endpoint_changes(const ChangesParams& params, Core::JSON::String& response) const
+    {
+        response.SetQuoted(false);
+        response = Compose(SYSTEM | ADDRESSES | SOCKETS, params.Since.Value(), true);
         return Core::ERROR_NONE;
     }
 
@@ -80,20 +80,22 @@ namespace Plugin {
             }
             _state.Add(end);
         }
-        void Trigger(GPIO::Pin& pin) override
+        void Trigger(GPIO::Pin& /* pin */, const GPIO::Pin::Edges& edges) override
         {
             uint32_t marker;
 
             ASSERT(_service != nullptr);
 
-            if (_state.Analyse(pin.Set(), marker) == true) {
-                if ((marker == _marker1) || (marker == _marker2)) {
-                    Exchange::IBluetoothControl* handler(_service->QueryInterfaceByCallsign<Exchange::IBluetoothControl>(_callsign));
+            for (const GPIO::Pin::Edge& edge : edges) {
+                if (_state.Reached(edge.Value, edge.Time, marker) == true) {
+                    if ((marker == _marker1) || (marker == _marker2)) {
+                        Exchange::IBluetoothControl* handler(_service->QueryInterfaceByCallsign<Exchange::IBluetoothControl>(_callsign));
 
-                    if (handler != nullptr) {
+                        if (handler != nullptr) {
 
-                        handler->Scan();
-                        handler->Release();
+                            handler->Scan();
+                            handler->Release();
+                        }
                     }
                 }
             }
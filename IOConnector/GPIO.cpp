@@ -19,6 +19,8 @@
  
 #include "GPIO.h"
 
+#include <linux/gpio.h>
+
 namespace WPEFramework {
 
 ENUM_CONVERSION_BEGIN(GPIO::Pin::trigger_mode)
@@ -59,15 +61,33 @@ namespace GPIO
     // Class: PIN
     // ----------------------------------------------------------------------------------------------------
 
-    Pin::Pin(const uint16_t pin, const bool activeLow)
+    Pin::Pin(const uint16_t pin, const bool activeLow, const string& chip, const uint16_t debounce)
         : BaseClass(pin, IExternal::regulator, IExternal::general, IExternal::logic, 0)
         , _pin(pin)
         , _activeLow(activeLow ? 1 : 0)
         , _lastValue(false)
         , _descriptor(-1)
         , _timedPin(this)
+        , _chip(-1)
+        , _events(false)
+        , _bias(0)
+        , _trigger(NONE)
+        , _debounce(debounce * Core::Time::TicksPerMillisecond)
+        , _lastEdge(0)
+        , _rawValue(false)
+        , _rawTime(0)
+        , _settle(*this)
+        , _edges()
     {
-        if (_pin != 0xFFFF) {
+        if ((_pin != 0xFFFF) && (chip.empty() == false)) {
+            // The line itself is requested once the mode (or trigger) is known.
+            _chip = open(chip.c_str(), O_RDONLY | O_CLOEXEC);
+
+            if (_chip == -1) {
+                SYSLOG(Logging::Startup, (_T("Could not open GPIO chip [%s] for pin [%d]."), chip.c_str(), _pin));
+            }
+        }
+        else if (_pin != 0xFFFF) {
             struct stat properties;
             char buffer[64];
             sprintf(buffer, "/sys/class/gpio/gpio%d/value", _pin);
@@ -98,7 +118,21 @@ namespace GPIO
 
     /* virtual */ Pin::~Pin()
     {
-        if (_descriptor != -1) {
+        _settle.Revoke();
+
+        if (IsCharacterDevice() == true) {
+
+            if (_descriptor != -1) {
+                Core::ResourceMonitor::Instance().Unregister(*this);
+
+                close(_descriptor);
+                _descriptor = -1;
+            }
+
+            close(_chip);
+            _chip = -1;
+        }
+        else if (_descriptor != -1) {
 
             Core::ResourceMonitor::Instance().Unregister(*this);
 
@@ -155,30 +189,199 @@ namespace GPIO
 
     /* virtual */ uint16_t Pin::Events()
     {
+        if (IsCharacterDevice() == true) {
+            return ((_descriptor != -1) && (_events == true) ? POLLIN : 0);
+        }
         return (_descriptor != -1 ? (POLLPRI | POLLERR) : 0);
     }
 
     /* virtual */ void Pin::Handle(const uint16_t events)
     {
+        if (IsCharacterDevice() == true) {
+
+            if ((events & POLLIN) != 0) {
+
+                struct gpioevent_data data[16];
+                ssize_t length;
+
+                // The line is non-blocking, drain all events the kernel queued since the last
+                // wake-up, a bouncing contact or a rotary encoder easily queues a few of them.
+                while ((length = read(_descriptor, data, sizeof(data))) > 0) {
+
+                    const uint16_t count = static_cast<uint16_t>(length / sizeof(struct gpioevent_data));
+
+                    for (uint16_t index = 0; index < count; index++) {
+                        // Kernel timestamps are in ns, our ticks are in us.
+                        Event(data[index].id == GPIOEVENT_EVENT_RISING_EDGE, data[index].timestamp / 1000);
+                    }
+
+                    if (static_cast<size_t>(length) < sizeof(data)) {
+                        break;
+                    }
+                }
+
+                Lock();
+
+                bool report = (_edges.empty() == false);
+
+                if (_rawValue != _lastValue) {
+                    // The line settled on a level that was filtered as a bounce, check it again once
+                    // the debounce period passed.
+                    _settle.Schedule(Core::Time::Now().Add(static_cast<uint32_t>(_debounce / Core::Time::TicksPerMillisecond)));
+                }
 
-        if ((events & (POLLPRI | POLLERR)) != 0) {
+                Unlock();
 
-            unsigned char buffer[1];
+                if (report == true) {
+                    Updated();
+                }
+            }
+        }
+        else if ((events & (POLLPRI | POLLERR)) != 0) {
 
-            read(_descriptor, &buffer, sizeof(buffer));
+            uint8_t value = '0';
+
+            lseek(_descriptor, 0, SEEK_SET);
+            read(_descriptor, &value, 1);
 
             // If we are only triggered on a falling edge, or a rising edge
             // the change is not detected compared to the previous value,
-            // force HasChanged to be true!!
-            _lastValue = !Get();
+            // so record it regardless of the previous value!!
+            Lock();
+            Record((value != '0') != (_activeLow != 0), Core::Time::Now().Ticks());
+            Unlock();
 
             Updated();
         }
     }
 
-    void Pin::Trigger(const trigger_mode mode)
+    void Pin::Request(const uint32_t flags, const bool events)
     {
+        ASSERT(IsCharacterDevice() == true);
+
         if (_descriptor != -1) {
+            close(_descriptor);
+            _descriptor = -1;
+        }
+
+        if (events == true) {
+            struct gpioevent_request info;
+            ::memset(&info, 0, sizeof(info));
+
+            // Always ask for both edges, this keeps the cached value accurate, the trigger mode is
+            // applied when the edges are recorded.
+            info.lineoffset = _pin;
+            info.handleflags = flags | _bias;
+            info.eventflags = GPIOEVENT_REQUEST_BOTH_EDGES;
+            ::strncpy(info.consumer_label, "IOConnector", sizeof(info.consumer_label) - 1);
+
+            if (ioctl(_chip, GPIO_GET_LINEEVENT_IOCTL, &info) == 0) {
+                struct gpiohandle_data data;
+                ::memset(&data, 0, sizeof(data));
+
+                _descriptor = info.fd;
+                fcntl(_descriptor, F_SETFL, fcntl(_descriptor, F_GETFL) | O_NONBLOCK);
+
+                if (ioctl(_descriptor, GPIOHANDLE_GET_LINE_VALUES_IOCTL, &data) == 0) {
+                    Lock();
+                    _lastValue = ((data.values[0] != 0) != (_activeLow != 0));
+                    _rawValue = _lastValue;
+                    Unlock();
+                }
+            }
+        } else {
+            struct gpiohandle_request info;
+            ::memset(&info, 0, sizeof(info));
+
+            info.lineoffsets[0] = _pin;
+            info.lines = 1;
+            info.flags = flags | _bias;
+            info.default_values[0] = _activeLow;
+            ::strncpy(info.consumer_label, "IOConnector", sizeof(info.consumer_label) - 1);
+
+            if (ioctl(_chip, GPIO_GET_LINEHANDLE_IOCTL, &info) == 0) {
+                _descriptor = info.fd;
+            }
+        }
+
+        _events = ((events == true) && (_descriptor != -1));
+
+        if (_descriptor == -1) {
+            SYSLOG(Logging::Startup, (_T("Could not request GPIO line [%d], error: %d."), _pin, errno));
+        }
+    }
+
+    void Pin::Event(const bool rising, const uint64_t timestamp)
+    {
+        const bool value = (rising != (_activeLow != 0));
+
+        Lock();
+
+        _rawValue = value;
+        _rawTime = timestamp;
+
+        // Edges following the last accepted one within the debounce period are considered a
+        // bounce. The level the line settles on is picked up by the next edge or by the settle job.
+        if ((value != _lastValue) && ((timestamp - _lastEdge) >= _debounce)) {
+            Record(value, timestamp);
+        }
+
+        Unlock();
+    }
+
+    // Should be called with the lock taken.
+    void Pin::Record(const bool value, const uint64_t timestamp)
+    {
+        const bool rising = (value != (_activeLow != 0));
+
+        _lastValue = value;
+        _lastEdge = timestamp;
+
+        if ((_events == false) || ((_trigger & (rising == true ? (RISING | HIGH) : (FALLING | LOW))) != 0)) {
+            _edges.push_back(Edge{ value, timestamp });
+            _timedPin.Update(value, timestamp);
+        }
+    }
+
+    void Pin::Dispatch()
+    {
+        bool report = false;
+
+        Lock();
+
+        if (_rawValue != _lastValue) {
+            Record(_rawValue, _rawTime);
+            report = true;
+        }
+
+        Unlock();
+
+        if (report == true) {
+            Updated();
+        }
+    }
+
+    bool Pin::Collect(Edges& edges)
+    {
+        edges.clear();
+
+        Lock();
+        edges.swap(_edges);
+        Unlock();
+
+        return (edges.empty() == false);
+    }
+
+    void Pin::Trigger(const trigger_mode mode)
+    {
+        _trigger = mode;
+
+        if (IsCharacterDevice() == true) {
+            if (mode != NONE) {
+                Request(GPIOHANDLE_REQUEST_INPUT, true);
+            }
+        }
+        else if (_descriptor != -1) {
             // Oke looks like we have a valid pin.
             char buffer[64];
             sprintf(buffer, "/sys/class/gpio/gpio%d/edge", _pin);
@@ -202,16 +405,24 @@ namespace GPIO
         return (Get() != _lastValue);
     }
 
-    void Pin::Align()
-    {
-        _lastValue = Get();
-    }
-
     bool Pin::Get() const
     {
         bool result = false;
 
-        if (_descriptor != -1) {
+        if ((_descriptor != -1) && (IsCharacterDevice() == true)) {
+            if (_events == true) {
+                // Both edges are reported on this line, so the (debounced) value is known already.
+                result = _lastValue;
+            } else {
+                struct gpiohandle_data data;
+                ::memset(&data, 0, sizeof(data));
+
+                if (ioctl(_descriptor, GPIOHANDLE_GET_LINE_VALUES_IOCTL, &data) == 0) {
+                    result = ((data.values[0] != 0) != (_activeLow != 0));
+                }
+            }
+        }
+        else if (_descriptor != -1) {
             uint8_t value;
             lseek(_descriptor, 0, SEEK_SET);
             read(_descriptor, &value, 1);
@@ -225,7 +436,14 @@ namespace GPIO
 
     void Pin::Set(const bool value)
     {
-        if (_descriptor != -1) {
+        if ((_descriptor != -1) && (IsCharacterDevice() == true)) {
+            struct gpiohandle_data data;
+            ::memset(&data, 0, sizeof(data));
+
+            data.values[0] = (value != (_activeLow != 0) ? 1 : 0);
+            ioctl(_descriptor, GPIOHANDLE_SET_LINE_VALUES_IOCTL, &data);
+        }
+        else if (_descriptor != -1) {
             uint8_t newValue;
             if (_activeLow != 0) {
                 newValue = (value ? '0' : '1');
@@ -238,7 +456,14 @@ namespace GPIO
 
     void Pin::Mode(const pin_mode mode)
     {
-        if (_descriptor != -1) {
+        if (IsCharacterDevice() == true) {
+            if (mode == GPIO::Pin::INPUT) {
+                Request(GPIOHANDLE_REQUEST_INPUT, false);
+            } else if (mode == GPIO::Pin::OUTPUT) {
+                Request(GPIOHANDLE_REQUEST_OUTPUT, false);
+            }
+        }
+        else if (_descriptor != -1) {
             // Oke looks like we have a valid pin.
             char buffer[64];
             sprintf(buffer, "/sys/class/gpio/gpio%d/direction", _pin);
@@ -261,12 +486,18 @@ namespace GPIO
 
     void Pin::Pull(const pull_mode mode)
     {
-        if (_descriptor != -1) {
+        if (IsCharacterDevice() == true) {
+#ifdef GPIOHANDLE_REQUEST_BIAS_DISABLE
+            // The bias is a property of the line request, it is applied on the next Mode()/Trigger().
+            _bias = (mode == GPIO::Pin::UP ? GPIOHANDLE_REQUEST_BIAS_PULL_UP : (mode == GPIO::Pin::DOWN ? GPIOHANDLE_REQUEST_BIAS_PULL_DOWN : GPIOHANDLE_REQUEST_BIAS_DISABLE));
+#endif
+        }
+        else if (_descriptor != -1) {
             // Oke looks like we have a valid pin.
             char buffer[64];
             sprintf(buffer, "/sys/class/gpio/gpio%d/active_low", _pin);
 
-            if ((mode == GPIO::Pin::OFF) || (mode == GPIO::Pin::DOWN) || (mode == GPIO::Pin::DOWN)) {
+            if ((mode == GPIO::Pin::OFF) || (mode == GPIO::Pin::DOWN) || (mode == GPIO::Pin::UP)) {
 
                 Core::EnumerateType<pull_mode> textMode(mode);
 
@@ -290,7 +521,7 @@ namespace GPIO
     }
 
     void Pin::Unregister(IInputPin::INotification* sink) /* override */ {
-        _timedPin.Register(sink);
+        _timedPin.Unregister(sink);
     }
 
     void Pin::AddMarker(const uint32_t marker) /* override */ {
@@ -304,7 +535,10 @@ namespace GPIO
     /* virtual */ void Pin::Evaluate()
     {
         if (HasChanged() == true) {
-            _timedPin.Update(Get());
+            Lock();
+            Record(Get(), Core::Time::Now().Ticks());
+            Unlock();
+
             BaseClass::Updated();
         }
     }
@@ -48,7 +48,7 @@ namespace GPIO {
 
             TimedPin(Pin* parent)
                 : _parent(*parent)
-                , _marker(~0)
+                , _markers()
                 , _job()
                 , _observerList()
                 , _monitor()
@@ -111,17 +111,20 @@ namespace GPIO {
 
                 _parent.Unlock();
             }
-            void Update(const bool pressed)
+            void Update(const bool pressed, const uint64_t timestamp)
             {
                 uint32_t marker;
 
-                if (_monitor.Reached(pressed, marker) == true) {
+                if (_monitor.Reached(pressed, timestamp, marker) == true) {
  
                     _parent.Lock();
 
-                    ASSERT(_marker == static_cast<uint32_t>(~0));
-                    _marker = marker;
-                    _parent.Updated();
+                    // One batch of edges can pass several markers before the job runs, deliver them all.
+                    const bool idle = _markers.empty();
+                    _markers.push_back(marker);
+                    if (idle == true) {
+                        Core::IWorkerPool::Instance().Submit(_job);
+                    }
                     _parent.Unlock();
                 }
             }
@@ -129,15 +132,16 @@ namespace GPIO {
         private:
             void Dispatch() override
             {
+                std::list<uint32_t> markers;
+
                 _parent.Lock();
 
-                uint32_t marker = _marker;
+                markers.swap(_markers);
 
                 ObserverList::const_iterator index(_observerList.cbegin());
-                _marker = ~0;
-                RecursiveCall(index, marker);
+                RecursiveCall(index, markers);
             }
-            void RecursiveCall(ObserverList::const_iterator& position, const uint32_t marker)
+            void RecursiveCall(ObserverList::const_iterator& position, const std::list<uint32_t>& markers)
             {
                 if (position == _observerList.cend()) {
                     _parent.Unlock();
@@ -145,15 +149,17 @@ namespace GPIO {
                     IInputPin::INotification* client(*position);
                     client->AddRef();
                     position++;
-                    RecursiveCall(position, marker);
-                    client->Marker(marker);
+                    RecursiveCall(position, markers);
+                    for (const uint32_t marker : markers) {
+                        client->Marker(marker);
+                    }
                     client->Release();
                 }
             }
 
         private:
             Pin& _parent;
-            uint32_t _marker;
+            std::list<uint32_t> _markers;
             Core::ProxyType<Core::IDispatch> _job;
             ObserverList _observerList;
             TimedInput _monitor;
@@ -183,12 +189,24 @@ namespace GPIO {
             LOW = 0x08
         };
 
+        // A (debounced) state change of the pin. The timestamp is in Core::Time ticks, taken from
+        // the kernel (CLOCK_MONOTONIC) for the character device backend and from Core::Time::Now()
+        // for the sysfs backend, so only the difference between two edges is meaningful.
+        struct Edge {
+            bool Value;
+            uint64_t Time;
+        };
+        using Edges = std::vector<Edge>;
+
     public:
         Pin() = delete;
         Pin(const Pin&) = delete;
         Pin& operator=(const Pin&) = delete;
 
-        Pin(const uint16_t id, const bool activeLow);
+        // If a chip (e.g. /dev/gpiochip0) is given, the id is the line offset on that chip and the
+        // GPIO character device is used, otherwise the id is the global sysfs GPIO number. Edges
+        // closer to each other than debounce (ms) are filtered, this requires the chip.
+        Pin(const uint16_t id, const bool activeLow, const string& chip = string(), const uint16_t debounce = 0);
         ~Pin() override;
 
     public:
@@ -200,7 +218,9 @@ namespace GPIO {
         void Pull(const pull_mode mode);
 
         bool HasChanged() const;
-        void Align();
+
+        // Hand over all edges collected since the previous call, returns false if there were none.
+        bool Collect(Edges& edges);
 
         inline void Subscribe(Exchange::IExternal::INotification* sink)
         {
@@ -230,17 +250,41 @@ namespace GPIO {
         NEXT_INTERFACE_MAP(Exchange::ExternalBase)
 
     private:
+        friend class Core::ThreadPool::JobType<Pin&>;
+
         Core::IResource::handle Descriptor() const override;
         uint16_t Events() override;
         void Handle(const uint16_t events) override;
         void Flush();
 
+        bool IsCharacterDevice() const
+        {
+            return (_chip != -1);
+        }
+        void Request(const uint32_t flags, const bool events);
+        void Event(const bool rising, const uint64_t timestamp);
+        void Record(const bool value, const uint64_t timestamp);
+        void Dispatch();
+
     private:
         const uint16_t _pin;
         uint8_t _activeLow;
         bool _lastValue;
         mutable int _descriptor;
         Core::ProxyObject<TimedPin> _timedPin;
+
+        // Character device backend only.
+        int _chip;
+        bool _events;
+        uint32_t _bias;
+        trigger_mode _trigger;
+        const uint64_t _debounce;
+        uint64_t _lastEdge;
+        bool _rawValue;
+        uint64_t _rawTime;
+        Core::WorkerPool::JobType<Pin&> _settle;
+
+        Edges _edges;
     };
 }
 } // namespace WPEFramework::GPIO
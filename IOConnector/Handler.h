@@ -29,7 +29,8 @@ namespace Plugin {
 
     struct IHandler {
         virtual ~IHandler() {}
-        virtual void Trigger(GPIO::Pin& pin) = 0;
+        // All edges seen on the pin since the previous trigger, oldest first.
+        virtual void Trigger(GPIO::Pin& pin, const GPIO::Pin::Edges& edges) = 0;
     };
 
     class HandlerAdministrator {
@@ -106,7 +106,7 @@ namespace Plugin
 
         while (index.Next() == true) {
 
-            GPIO::Pin* pin = Core::Service<GPIO::Pin>::Create<GPIO::Pin>(index.Current().Id.Value(), index.Current().ActiveLow.Value());
+            GPIO::Pin* pin = Core::Service<GPIO::Pin>::Create<GPIO::Pin>(index.Current().Id.Value(), index.Current().ActiveLow.Value(), config.Chip.Value(), index.Current().Debounce.Value());
             uint8_t mode = 0;
 
             if (pin != nullptr) {
@@ -346,6 +346,7 @@ namespace Plugin
 
         // Lets find the pin and trigger if posisble...
         Pins::iterator index = _pins.begin();
+        GPIO::Pin::Edges edges;
 
         while (index != _pins.end()) {
 
@@ -353,16 +354,15 @@ namespace Plugin
 
             ASSERT (pin != nullptr);
 
-            if (pin->HasChanged()) {
-
-                pin->Align();
+            if (pin->Collect(edges) == true) {
 
                 TRACE(IOState, (pin));
 
                 if (index->second.HasHandlers() == true) {
-                    index->second.Handle();
+                    index->second.Handle(edges);
                 } else {
-                    int32_t value = (pin->Get() ? 1 : 0);
+                    // A burst of edges is reported once, with the state it ended in.
+                    int32_t value = (edges.back().Value ? 1 : 0);
                     string pinAsText (Core::NumberType<uint16_t>(pin->Identifier() & 0xFFFF).Text());
                     _service->Notify(_T("{ \"id\": ") + pinAsText + _T(", \"state\": \"") + (value != 0 ? _T("Set\" }") : _T("Clear\" }")));
 
@@ -96,11 +96,11 @@ namespace Plugin {
                 }
                 return (method != nullptr);
             }
-            void Handle() {
+            void Handle(const GPIO::Pin::Edges& edges) {
                 std::list<IHandler*>::iterator index (_handlers.begin());
 
                 while (index != _handlers.end()) {
-                    (*index)->Trigger(*_pin);
+                    (*index)->Trigger(*_pin, edges);
                     index++;
                 }
             }
@@ -192,22 +192,26 @@ namespace Plugin {
                     : Id(~0)
                     , Mode(LOW)
                     , ActiveLow(false)
+                    , Debounce(0)
                     , Handlers()
                 {
                     Add(_T("id"), &Id);
                     Add(_T("mode"), &Mode);
                     Add(_T("activelow"), &ActiveLow);
+                    Add(_T("debounce"), &Debounce);
                     Add(_T("handlers"), &Handlers);
                 }
                 Pin(const Pin& copy)
                     : Id(copy.Id)
                     , Mode(copy.Mode)
                     , ActiveLow(copy.ActiveLow)
+                    , Debounce(copy.Debounce)
                     , Handlers(copy.Handlers)
                 {
                     Add(_T("id"), &Id);
                     Add(_T("mode"), &Mode);
                     Add(_T("activelow"), &ActiveLow);
+                    Add(_T("debounce"), &Debounce);
                     Add(_T("handlers"), &Handlers);
                 }
                 ~Pin() override
@@ -219,6 +223,7 @@ namespace Plugin {
                     Id = RHS.Id;
                     Mode = RHS.Mode;
                     ActiveLow = RHS.ActiveLow;
+                    Debounce = RHS.Debounce;
                     Handlers = RHS.Handlers;
 
                     return (*this);
@@ -228,6 +233,7 @@ namespace Plugin {
                 Core::JSON::DecUInt16 Id;
                 Core::JSON::EnumType<mode> Mode;
                 Core::JSON::Boolean ActiveLow;
+                Core::JSON::DecUInt16 Debounce;
                 Core::JSON::ArrayType<Handler> Handlers;
             };
 
@@ -237,7 +243,10 @@ namespace Plugin {
 
             Config()
                 : Core::JSON::Container()
+                , Chip()
+                , Pins()
             {
+                Add(_T("chip"), &Chip);
                 Add(_T("pins"), &Pins);
             }
             ~Config() override
@@ -245,6 +254,7 @@ namespace Plugin {
             }
 
         public:
+            Core::JSON::String Chip;
             Core::JSON::ArrayType<Pin> Pins;
         };
 
@@ -84,39 +84,41 @@ namespace Plugin {
         }
 
     public:
-        void Trigger(GPIO::Pin& pin) override
+        void Trigger(GPIO::Pin& /* pin */, const GPIO::Pin::Edges& edges) override
         {
             uint32_t marker;
 
             ASSERT(_service != nullptr);
 
-            if (_state.Reached(pin.Get(), marker) == true) {
-                Exchange::IPower* handler(_service->QueryInterfaceByCallsign<Exchange::IPower>(_callsign));
-
-                if (handler != nullptr) {
-                    if (marker == marker1) {
-                        // Get the current Device Power mode
-                        int state = handler->GetState();
-
-                        if (state == Exchange::IPower::ActiveStandby)
-                        {
-                            // Wake the Device from standby mode
-                            TRACE(Trace::Information, (_T("The device is in Active Standby mode, Waking the device")));
-                            handler->SetState(Exchange::IPower::On, 0);
+            for (const GPIO::Pin::Edge& edge : edges) {
+                if (_state.Reached(edge.Value, edge.Time, marker) == true) {
+                    Exchange::IPower* handler(_service->QueryInterfaceByCallsign<Exchange::IPower>(_callsign));
+
+                    if (handler != nullptr) {
+                        if (marker == marker1) {
+                            // Get the current Device Power mode
+                            int state = handler->GetState();
+
+                            if (state == Exchange::IPower::ActiveStandby)
+                            {
+                                // Wake the Device from standby mode
+                                TRACE(Trace::Information, (_T("The device is in Active Standby mode, Waking the device")));
+                                handler->SetState(Exchange::IPower::On, 0);
+                            }
+                            else if (state == Exchange::IPower::On)
+                            {
+                                //Set the Device to ActiveStandby Mode
+                                TRACE(Trace::Information, (_T("The device is in normal mode setting the device to Active Standby")));
+                                handler->SetState(Exchange::IPower::ActiveStandby, 0);
+                            }
                         }
-                        else if (state == Exchange::IPower::On)
-                        {
-                            //Set the Device to ActiveStandby Mode
-                            TRACE(Trace::Information, (_T("The device is in normal mode setting the device to Active Standby")));
-                            handler->SetState(Exchange::IPower::ActiveStandby, 0);
+                        else if (marker == marker2) {
+                            TRACE(Trace::Information, (_T("The device is requested to go to PowerOff mode")));
+                            handler->SetState(_powerOff, 0);
                         }
-                    }
-                    else if (marker == marker2) {
-                        TRACE(Trace::Information, (_T("The device is requested to go to PowerOff mode")));
-                        handler->SetState(_powerOff, 0);
-                    }
 
-                    handler->Release();
+                        handler->Release();
+                    }
                 }
             }
         }
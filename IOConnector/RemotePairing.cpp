@@ -71,24 +71,26 @@ namespace Plugin {
         }
 
     public:
-        void Trigger(GPIO::Pin& pin) override
+        void Trigger(GPIO::Pin& /* pin */, const GPIO::Pin::Edges& edges) override
         {
             uint32_t marker;
 
             ASSERT(_service != nullptr);
 
-            if ( (_state.Reached(pin.Get(), marker) == true) && (_marker == marker) ) {
-                Exchange::IKeyHandler* handler(_service->QueryInterfaceByCallsign<Exchange::IKeyHandler>(_callsign));
+            for (const GPIO::Pin::Edge& edge : edges) {
+                if ( (_state.Reached(edge.Value, edge.Time, marker) == true) && (_marker == marker) ) {
+                    Exchange::IKeyHandler* handler(_service->QueryInterfaceByCallsign<Exchange::IKeyHandler>(_callsign));
 
-                if (handler != nullptr) {
-                    Exchange::IKeyProducer* producer(handler->Producer(_producer));
+                    if (handler != nullptr) {
+                        Exchange::IKeyProducer* producer(handler->Producer(_producer));
 
-                    if (producer != nullptr) {
-                        producer->Pair();
-                        producer->Release();
-                    }
+                        if (producer != nullptr) {
+                            producer->Pair();
+                            producer->Release();
+                        }
 
-                    handler->Release();
+                        handler->Release();
+                    }
                 }
             }
         }
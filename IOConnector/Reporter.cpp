@@ -46,16 +46,18 @@ namespace Plugin {
         }
 
     public:
-        void Trigger(GPIO::Pin& pin) override
+        void Trigger(GPIO::Pin& /* pin */, const GPIO::Pin::Edges& edges) override
         {
             uint32_t marker;
 
             ASSERT(_service != nullptr);
 
-            if ( (_state.Reached(pin.Get(), marker) == true) && (_begin == marker) ) {
+            for (const GPIO::Pin::Edge& edge : edges) {
+                if ( (_state.Reached(edge.Value, edge.Time, marker) == true) && (_begin == marker) ) {
  
-                TRACE(Trace::Information, (_T("Reached Interval [%d] - [%d] seconds."), _begin / 1000, _end / 1000));
-                _service->Notify(_message);
+                    TRACE(Trace::Information, (_T("Reached Interval [%d] - [%d] seconds."), _begin / 1000, _end / 1000));
+                    _service->Notify(_message);
+                }
             }
         }
 
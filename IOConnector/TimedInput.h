@@ -70,9 +70,14 @@ namespace GPIO {
             }
         }
         bool Reached(bool pressed, uint32_t& marker) const
+        {
+            return (Reached(pressed, Core::Time::Now().Ticks(), marker));
+        }
+        // The timestamp (in ticks) of the edge, e.g. as reported by the kernel, only the time
+        // between the press and the release is used, so any monotonic clock will do.
+        bool Reached(bool pressed, const uint64_t now, uint32_t& marker) const
         {
             bool reached = false;
-            uint64_t now = Core::Time::Now().Ticks();
 
             marker = ~0;
 
@@ -82,7 +87,7 @@ namespace GPIO {
             else if (_markers.size() == 0) {
                 reached = true;
             } 
-            else if (now > (_pressedTime + BounceThreshold)) {
+            else if (now > (_pressedTime + (BounceThreshold * Core::Time::TicksPerMillisecond))) {
                 uint32_t elapsedTime = static_cast<uint32_t>( (now - _pressedTime) / Core::Time::TicksPerMillisecond );
 
                 // See which marker we have reached..
@@ -210,6 +210,50 @@ namespace Plugin {
         Geography _geo;
     };
 
+    // What was learned by the last successful probe, so the next boot can serve it right away.
+    class CachedLocation : public Core::JSON::Container {
+    public:
+        CachedLocation(const CachedLocation&) = delete;
+        CachedLocation& operator=(const CachedLocation&) = delete;
+
+        CachedLocation()
+            : Core::JSON::Container()
+            , Source()
+            , Ip()
+            , TimeZone()
+            , Country()
+            , Region()
+            , City()
+            , Address()
+            , Port(0)
+        {
+            Add(_T("source"), &Source);
+            Add(_T("ip"), &Ip);
+            Add(_T("timezone"), &TimeZone);
+            Add(_T("country"), &Country);
+            Add(_T("region"), &Region);
+            Add(_T("city"), &City);
+            Add(_T("address"), &Address);
+            Add(_T("port"), &Port);
+        }
+        ~CachedLocation() override
+        {
+        }
+
+    public:
+        Core::JSON::String Source;
+        Core::JSON::String Ip;
+        Core::JSON::String TimeZone;
+        Core::JSON::String Country;
+        Core::JSON::String Region;
+        Core::JSON::String City;
+        Core::JSON::String Address;
+        Core::JSON::DecUInt16 Port;
+    };
+
+    // RFC 8305, section 5: head start of the preferred (IPv6) family before IPv4 joins the race.
+    constexpr uint32_t ConnectionAttemptDelay = 250; // ms
+
     static Core::ProxyPoolType<Web::Response> g_Factory(1);
 
     static Core::NodeId FindLocalIPV6()
@@ -276,6 +320,14 @@ namespace Plugin {
         , _activity(*this)
         , _infoCarrier()
         , _request(Core::ProxyType<Web::Request>::Create())
+        , _cacheFile()
+        , _cached(false)
+        , _published(false)
+        , _preferred()
+        , _winner()
+        , _fallback()
+        , _primary()
+        , _secondary()
     {
     }
 #ifdef __WINDOWS__
@@ -340,6 +392,23 @@ namespace Plugin {
                         _request->Query = info.Query().Value();
                     }
 
+                    if ((_publicIPAddress.empty() == true) && (_cacheFile.empty() == false)) {
+                        // Nothing known yet, see what the previous run learned.
+                        CachedLocation cache;
+                        Core::File file(_cacheFile, true);
+
+                        if ((file.Open(true) == true) && (cache.IElement::FromFile(file) == true) && (cache.Source.Value() == _remoteId)) {
+                            _publicIPAddress = cache.Ip.Value();
+                            _timeZone = cache.TimeZone.Value();
+                            _country = cache.Country.Value();
+                            _region = cache.Region.Value();
+                            _city = cache.City.Value();
+                            _preferred = Core::NodeId(cache.Address.Value().c_str(), cache.Port.Value());
+                            _cached = true;
+                            _published = false;
+                        }
+                    }
+
                     string fullRequest; _request->ToString(fullRequest);
                     _infoCarrier = constructor->factory();
 
@@ -374,9 +443,56 @@ namespace Plugin {
             _infoCarrier.Release();
         }
 
+        Core::ProxyType<Attempt> primary(_primary);
+        Core::ProxyType<Attempt> secondary(_secondary);
+        _primary.Release();
+        _secondary.Release();
+
+        _adminLock.Unlock();
+
+        // Closing waits for the socket thread, which might be waiting for the lock in Raced().
+        if (primary.IsValid() == true) {
+            primary->Close(Core::infinite);
+        }
+        if (secondary.IsValid() == true) {
+            secondary->Close(Core::infinite);
+        }
+    }
+
+    void LocationService::Cache(const string& fileName)
+    {
+        _adminLock.Lock();
+        _cacheFile = fileName;
         _adminLock.Unlock();
     }
 
+    void LocationService::Save() const
+    {
+        // runs always in the context of the adminlock
+
+        if (_cacheFile.empty() == false) {
+            CachedLocation cache;
+            Core::File file(_cacheFile, true);
+
+            cache.Source = _remoteId;
+            cache.Ip = _publicIPAddress;
+            cache.TimeZone = _timeZone;
+            cache.Country = _country;
+            cache.Region = _region;
+            cache.City = _city;
+
+            if (_preferred.IsValid() == true) {
+                cache.Address = _preferred.HostAddress();
+                cache.Port = _preferred.PortNumber();
+            }
+
+            if (file.Create() == true) {
+                cache.IElement::ToFile(file);
+                file.Close();
+            }
+        }
+    }
+
     // Methods to extract and insert data into the socket buffers
     /* virtual */ void LocationService::LinkBody(Core::ProxyType<Web::Response>& element)
     {
@@ -414,6 +530,11 @@ namespace Plugin {
                 _publicIPAddress = _infoCarrier->IP();
             }
             _state = LOADED;
+            _cached = false;
+
+            // Next time, go straight for the address that worked.
+            _preferred = Link().RemoteNode();
+            Save();
 
             ASSERT(!_publicIPAddress.empty());
 
@@ -468,11 +589,70 @@ namespace Plugin {
         }
     }
 
+    void LocationService::Raced(Attempt& attempt)
+    {
+        _adminLock.Lock();
+
+        if ((_state == RACING) && (_winner.IsValid() == false)) {
+            if (attempt.IsOpen() == true) {
+                // First one to connect wins. The probe opens a new connection to this address, this socket is dropped.
+                _winner = attempt.RemoteNode();
+                _activity.Revoke();
+                _activity.Submit();
+            } else if ((attempt.HasError() == true) && (_fallback.IsValid() == true)) {
+                // The preferred family failed already, no need to wait for its head start to expire.
+                _activity.Revoke();
+                _activity.Submit();
+            }
+        }
+
+        _adminLock.Unlock();
+    }
+
+    bool LocationService::Race()
+    {
+        // runs always in the context of the adminlock
+
+        Core::NodeId ipv6(Core::NodeId::IsIPV6Enabled() == true ? Core::NodeId(_remoteId.c_str(), Core::NodeId::TYPE_IPV6) : Core::NodeId());
+        Core::NodeId ipv4(_remoteId.c_str(), Core::NodeId::TYPE_IPV4);
+
+        _winner = Core::NodeId();
+        _fallback = Core::NodeId();
+
+        if (ipv6.IsValid() == true) {
+            _primary = Core::ProxyType<Attempt>::Create(*this, ipv6);
+            _fallback = ipv4;
+        } else if (ipv4.IsValid() == true) {
+            _primary = Core::ProxyType<Attempt>::Create(*this, ipv4);
+        }
+
+        if (_primary.IsValid() == true) {
+            TRACE(Trace::Information, (_T("Racing [%s:%d] on [%s]"), _primary->RemoteNode().HostAddress().c_str(), _primary->RemoteNode().PortNumber(), ipv6.IsValid() ? _T("IPv6") : _T("IPv4")));
+            _primary->Open(0);
+            _state = RACING;
+        }
+
+        return (_primary.IsValid() == true);
+    }
+
+    void LocationService::Connect(const Core::NodeId& remote)
+    {
+        // runs always in the context of the adminlock
+
+        Link().LocalNode(remote.AnyInterface());
+        Link().RemoteNode(remote);
+
+        TRACE(Trace::Information, (_T("Probing [%s:%d] on [%s]"), remote.HostAddress().c_str(), remote.PortNumber(), remote.Type() == Core::NodeId::TYPE_IPV6 ? _T("IPV6") : _T("IPv4")));
+        _state = (remote.Type() == Core::NodeId::TYPE_IPV6 ? IPV6_INPROGRESS : IPV4_INPROGRESS);
+    }
+
     // The network might be down, keep on trying until we have connectivity.
-    // We start using IPV6, preferred network...
+    // IPv6 and IPv4 are raced, IPv6 gets a small head start as it is the preferred network...
     void LocationService::Dispatch()
     {
         uint32_t result = Core::infinite;
+        Core::ProxyType<Attempt> primary;
+        Core::ProxyType<Attempt> secondary;
 
         if ((IsClosed() == false) || (Close(100) != Core::ERROR_NONE)) {
 
@@ -481,16 +661,60 @@ namespace Plugin {
 
             _adminLock.Lock();
 
-            if (_state == IPV4_INPROGRESS) {
+            if ((_cached == true) && (_published == false)) {
+                // Serve what we learned last time, while we find out if it still holds.
+                _published = true;
+                TRACE(Trace::Information, (_T("LocationSync: Using cached location while probing, ip: %s, tz: %s"), _publicIPAddress.c_str(), _timeZone.c_str()));
+                _callback->Dispatch();
+            }
+
+            if ((_state == IPV6_INPROGRESS) || (_state == IPV4_INPROGRESS)) {
+                // No answer in time on the chosen address, forget it and race again.
+                _preferred = Core::NodeId();
                 _state = (_retries-- == 0 ? FAILED : ACTIVE);
             }
 
-            if ((_state != LOADED) && (_state != FAILED)) {
+            if (_state == RACING) {
+                bool over = true;
 
-                Core::NodeId remote(_remoteId.c_str(), ((_state == ACTIVE) && (Core::NodeId::IsIPV6Enabled()) ? Core::NodeId::TYPE_IPV6 : Core::NodeId::TYPE_IPV4));
+                if (_winner.IsValid() == true) {
+                    Connect(_winner);
+                } else if (_fallback.IsValid() == true) {
+                    TRACE(Trace::Information, (_T("Racing [%s:%d] on [IPv4]"), _fallback.HostAddress().c_str(), _fallback.PortNumber()));
+                    _secondary = Core::ProxyType<Attempt>::Create(*this, _fallback);
+                    _secondary->Open(0);
+                    _fallback = Core::NodeId();
 
-                if (remote.IsValid() == false) {
+                    over = false;
+                    result = _tryInterval;
+                } else {
+                    TRACE_L1("No address family connected. Reschedule for the next attempt: %d", _retries);
 
+                    // Give the network some time before we race again, if we still can..
+                    if (_retries-- == 0)
+                        _state = FAILED;
+                    else {
+                        _state = ACTIVE;
+                        result = _tryInterval;
+                    }
+                }
+
+                if (over == true) {
+                    // The race is over, the attempts can go.
+                    primary = _primary;
+                    secondary = _secondary;
+                    _primary.Release();
+                    _secondary.Release();
+                    _winner = Core::NodeId();
+                    _fallback = Core::NodeId();
+                }
+            } else if (_state == ACTIVE) {
+                if (_preferred.IsValid() == true) {
+                    // Skip DNS and the race, the address that worked last time most likely works again.
+                    Connect(_preferred);
+                } else if (Race() == true) {
+                    result = (_fallback.IsValid() == true ? ConnectionAttemptDelay : _tryInterval);
+                } else {
                     TRACE_L1("DNS resolving failed. Sleep for %d mS for attempt %d", _tryInterval, _retries);
 
                     // Name resolving does not even work. Retry this after a few seconds, if we still can..
@@ -498,38 +722,48 @@ namespace Plugin {
                         _state = FAILED;
                     else
                         result = _tryInterval;
-                } else {
-                    Link().LocalNode(remote.AnyInterface());
-                    Link().RemoteNode(remote);
-
-                    TRACE(Trace::Information, (_T("Probing [%s:%d] on [%s]"), remote.HostAddress().c_str(), remote.PortNumber(), remote.Type() == Core::NodeId::TYPE_IPV6 ? _T("IPV6") : _T("IPv4")));
-                    _state = (remote.Type() == Core::NodeId::TYPE_IPV6 ? IPV6_INPROGRESS : IPV4_INPROGRESS);
+                }
+            }
 
-                    uint32_t status = Open(0);
+            if ((_state == IPV6_INPROGRESS) || (_state == IPV4_INPROGRESS)) {
+                uint32_t status = Open(0);
 
-                    if ((status == Core::ERROR_NONE) || (status == Core::ERROR_INPROGRESS)) {
+                if ((status == Core::ERROR_NONE) || (status == Core::ERROR_INPROGRESS)) {
 
-                        TRACE_L1("Sending out a network package on %s. Attempt: %d", (remote.Type() == Core::NodeId::TYPE_IPV6 ? _T("IPv6") : _T("IPv4")), _retries);
+                    TRACE_L1("Sending out a network package on %s. Attempt: %d", (_state == IPV6_INPROGRESS ? _T("IPv6") : _T("IPv4")), _retries);
 
-                        // We need to get a response in the given time..
-                        result = _tryInterval;
-                    } else {
-                        TRACE_L1("Failed on network %s. Reschedule for the next attempt: %d", (remote.Type() == Core::NodeId::TYPE_IPV6 ? _T("IPv6") : _T("IPv4")), _retries);
+                    // We need to get a response in the given time..
+                    result = _tryInterval;
+                } else {
+                    TRACE_L1("Failed on network %s. Reschedule for the next attempt: %d", (_state == IPV6_INPROGRESS ? _T("IPv6") : _T("IPv4")), _retries);
 
-                        // Seems we could not open this connection, move on to the next attempt.
-                        Close(0);
-                        result = 100;
-                    }
+                    // Seems we could not open this connection, move on to the next attempt.
+                    Close(0);
+                    result = 100;
                 }
             }
 
             if (_state == FAILED) {
                 _infoCarrier.Release();
+
+                if (_cached == true) {
+                    // The cached location still is our best guess, the cached public address is not.
+                    _publicIPAddress.clear();
+                    _cached = false;
+                }
             }
 
             _adminLock.Unlock();
         }
 
+        // Closing waits for the socket thread, which might be waiting for the lock in Raced().
+        if (primary.IsValid() == true) {
+            primary->Close(Core::infinite);
+        }
+        if (secondary.IsValid() == true) {
+            secondary->Close(Core::infinite);
+        }
+
         if (_state == FAILED) {
             Core::NodeId::ClearIPV6Enabled();
 
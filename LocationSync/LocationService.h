@@ -37,6 +37,7 @@ namespace Plugin {
         enum state {
             IDLE,
             ACTIVE,
+            RACING,
             IPV6_INPROGRESS,
             IPV4_INPROGRESS,
             LOADED,
@@ -45,6 +46,43 @@ namespace Plugin {
 
         using Job = Core::ThreadPool::JobType<LocationService>;
 
+        // A bare TCP connect towards one resolved address. IPv6 and IPv4 attempts are raced against
+        // each other (RFC 8305) and the first one that connects decides the address used for the probe.
+        // The attempt itself only proves reachability, the probe opens its own connection to that address.
+        class Attempt : public Core::SocketStream {
+        public:
+            Attempt() = delete;
+            Attempt(const Attempt&) = delete;
+            Attempt& operator=(const Attempt&) = delete;
+
+            Attempt(LocationService& parent, const Core::NodeId& remote)
+                : Core::SocketStream(false, remote.AnyInterface(), remote, 64, 64)
+                , _parent(parent)
+            {
+            }
+            ~Attempt() override
+            {
+                Close(Core::infinite);
+            }
+
+        private:
+            uint16_t SendData(uint8_t* /* dataFrame */, const uint16_t /* maxSendSize */) override
+            {
+                return (0);
+            }
+            uint16_t ReceiveData(uint8_t* /* dataFrame */, const uint16_t receivedSize) override
+            {
+                return (receivedSize);
+            }
+            void StateChange() override
+            {
+                _parent.Raced(*this);
+            }
+
+        private:
+            LocationService& _parent;
+        };
+
     private:
         LocationService() = delete;
         LocationService(const LocationService&) = delete;
@@ -68,6 +106,15 @@ namespace Plugin {
         uint32_t Probe(const string& remoteNode, const uint32_t retries, const uint32_t retryTimeSpan);
         void Stop();
 
+        // Load the outcome of the last successful probe from the given file and keep it up to date.
+        void Cache(const string& fileName);
+
+        // The location (and public IP) reported are the cached ones, the live probe did not finish yet.
+        bool IsCached() const
+        {
+            return (_cached);
+        }
+
         /*
        * ------------------------------------------------------------------------------------------------------------
        * ISubSystem::INetwork methods
@@ -115,6 +162,11 @@ namespace Plugin {
         friend Core::ThreadPool::JobType<LocationService&>;
         void Dispatch();
 
+        void Raced(Attempt& attempt);
+        bool Race();
+        void Connect(const Core::NodeId& remote);
+        void Save() const;
+
     private:
         Core::CriticalSection _adminLock;
         state _state;
@@ -131,6 +183,14 @@ namespace Plugin {
         Core::WorkerPool::JobType<LocationService&> _activity;
         Core::ProxyType<IGeography> _infoCarrier;
         Core::ProxyType<Web::Request> _request;
+        string _cacheFile;
+        bool _cached;
+        bool _published;
+        Core::NodeId _preferred;
+        Core::NodeId _winner;
+        Core::NodeId _fallback;
+        Core::ProxyType<Attempt> _primary;
+        Core::ProxyType<Attempt> _secondary;
     };
 }
 } // namespace WPEFramework:Plugin
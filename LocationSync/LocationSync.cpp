@@ -144,7 +144,10 @@ namespace Plugin {
 
         if (subSystem != nullptr) {
 
-            subSystem->Set(PluginHost::ISubSystem::INTERNET, _sink.Network());
+            // A cached location can be served up front, internet connectivity is only claimed once the probe is done.
+            if (_sink.IsCached() == false) {
+                subSystem->Set(PluginHost::ISubSystem::INTERNET, _sink.Network());
+            }
             subSystem->Set(PluginHost::ISubSystem::LOCATION, _sink.Location());
             subSystem->Release();
 
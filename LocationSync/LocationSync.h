@@ -96,6 +96,12 @@ namespace Plugin {
                 _interval = interval;
                 _retries = retries;
 
+                const string path(service->PersistentPath());
+
+                if ((path.empty() == false) && (Core::Directory(path.c_str()).CreatePath() == true)) {
+                    _locator->Cache(path + _T("location.json"));
+                }
+
                 Probe();
             }
             inline void Deinitialize()
@@ -118,6 +124,10 @@ namespace Plugin {
             {
                 return (_locator);
             }
+            inline bool IsCached() const
+            {
+                return (_locator->IsCached());
+            }
 
         private:
             inline uint32_t Probe()
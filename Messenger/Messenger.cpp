@@ -62,6 +62,13 @@ namespace Plugin {
         _roomAdmin->Unregister(this);
         _rooms.clear();
 
+        // Nothing posts events anymore, drop whatever was not delivered yet.
+        _job.Revoke();
+
+        _eventLock.Lock();
+        _events.clear();
+        _eventLock.Unlock();
+
         _roomAdmin->Release();
         _roomAdmin = nullptr;
 
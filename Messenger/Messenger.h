@@ -22,8 +22,11 @@
 #include "Module.h"
 #include <interfaces/IMessenger.h>
 #include <interfaces/json/JsonData_Messenger.h>
+#include <algorithm>
 #include <map>
 #include <set>
+#include <list>
+#include <vector>
 #include <functional>
 
 namespace WPEFramework {
@@ -43,6 +46,9 @@ namespace Plugin {
             , _roomAdmin(nullptr)
             , _roomIds()
             , _adminLock()
+            , _eventLock()
+            , _events()
+            , _job(*this)
         {
             RegisterAll();
         }
@@ -167,6 +173,24 @@ namespace Plugin {
             _adminLock.Unlock();
         }
 
+    private:
+        // A notification waiting for delivery. Deliveries of the same notification to several rooms
+        // (e.g. a message echoed to all users of a room) are merged into one event, addressed to all
+        // those room IDs, so it is serialized and matched against the subscribers only once.
+        struct Event {
+            enum kind : uint8_t {
+                ROOMUPDATE,
+                USERUPDATE,
+                MESSAGE
+            };
+
+            kind Kind;
+            string Subject; // room name (roomupdate) or user name (userupdate, message)
+            string Text;
+            uint8_t Action;
+            std::vector<string> Ids; // empty addresses all subscribers
+        };
+
     private:
         string GenerateRoomId(const string& roomName, const string& userName);
         bool SubscribeUserUpdate(const string& roomId, bool subscribe);
@@ -181,12 +205,21 @@ namespace Plugin {
         void event_userupdate(const string& id, const string& user, const JsonData::Messenger::UserupdateParamsData::ActionType& action);
         void event_message(const string& id, const string& user, const string& message);
 
+        void Post(const Event::kind kind, const string& id, const string& subject, const string& text, const uint8_t action);
+        static bool Addressed(const std::vector<string>& ids, const string& designator);
+
+        friend Core::ThreadPool::JobType<Messenger&>;
+        void Dispatch();
+
         uint32_t _connectionId;
         PluginHost::IShell* _service;
         Exchange::IRoomAdministrator* _roomAdmin;
         std::map<string, Exchange::IRoomAdministrator::IRoom*> _roomIds;
         std::set<string> _rooms;
         mutable Core::CriticalSection _adminLock;
+        Core::CriticalSection _eventLock;
+        std::list<Event> _events;
+        Core::WorkerPool::JobType<Messenger&> _job;
     }; // class Messenger
 
 } // namespace Plugin
@@ -118,37 +118,124 @@ namespace Plugin {
     // Notifies about room status updates.
     void Messenger::event_roomupdate(const string& room, const RoomupdateParamsData::ActionType& action)
     {
-        RoomupdateParamsData params;
-        params.Room = room;
-        params.Action = action;
-
-        Notify(_T("roomupdate"), params);
+        Post(Event::ROOMUPDATE, string(), room, string(), static_cast<uint8_t>(action));
     }
 
     // Notifies about user status updates.
     void Messenger::event_userupdate(const string& id, const string& user, const UserupdateParamsData::ActionType& action)
     {
-        UserupdateParamsData params;
-        params.User = user;
-        params.Action = action;
-
-        Notify(_T("userupdate"), params, [&](const string& designator) -> bool {
-            const string designator_id = designator.substr(0, designator.find('.'));
-            return (id == designator_id);
-        });
+        Post(Event::USERUPDATE, id, user, string(), static_cast<uint8_t>(action));
     }
 
     // Notifies about new messages in a room.
     void Messenger::event_message(const string& id, const string& user, const string& message)
     {
-        MessageParamsData params;
-        params.User = user;
-        params.Message = message;
+        Post(Event::MESSAGE, id, user, message, 0);
+    }
 
-        Notify(_T("message"), params, [&](const string& designator) -> bool {
-            const string designator_id = designator.substr(0, designator.find('.'));
-            return (id == designator_id);
-        });
+    // Event delivery
+    //
+
+    // Events are delivered from the worker pool, in the order they were posted. Everything posted
+    // while a delivery is pending is handled in that same run, an event equal to the one posted
+    // before it only adds its room ID to the already queued event. A room that is already in there
+    // (the same message posted twice) gets an event of its own, so nothing is delivered less often.
+    void Messenger::Post(const Event::kind kind, const string& id, const string& subject, const string& text, const uint8_t action)
+    {
+        _eventLock.Lock();
+
+        const bool idle = _events.empty();
+        bool merged = false;
+
+        if ((idle == false) && (id.empty() == false)) {
+            Event& last(_events.back());
+
+            if ((last.Kind == kind) && (last.Ids.empty() == false) && (last.Action == action) && (last.Subject == subject) && (last.Text == text)
+                && (std::find(last.Ids.begin(), last.Ids.end(), id) == last.Ids.end())) {
+                last.Ids.push_back(id);
+                merged = true;
+            }
+        }
+
+        if (merged == false) {
+            _events.emplace_back();
+
+            Event& event(_events.back());
+            event.Kind = kind;
+            event.Subject = subject;
+            event.Text = text;
+            event.Action = action;
+
+            if (id.empty() == false) {
+                event.Ids.push_back(id);
+            }
+
+            if (idle == true) {
+                _job.Submit();
+            }
+        }
+
+        _eventLock.Unlock();
+    }
+
+    // The designator of a room bound event is "<roomid>.<event>", the room IDs are sorted.
+    /* static */ bool Messenger::Addressed(const std::vector<string>& ids, const string& designator)
+    {
+        const size_t length = std::min(designator.find('.'), designator.length());
+
+        std::vector<string>::const_iterator index(std::lower_bound(ids.begin(), ids.end(), designator,
+            [length](const string& id, const string& key) -> bool { return (key.compare(0, length, id) > 0); }));
+
+        return ((index != ids.end()) && (designator.compare(0, length, *index) == 0));
+    }
+
+    void Messenger::Dispatch()
+    {
+        std::list<Event> events;
+
+        _eventLock.Lock();
+        events.swap(_events);
+        _eventLock.Unlock();
+
+        for (Event& event : events) {
+            std::sort(event.Ids.begin(), event.Ids.end());
+
+            const std::vector<string>& ids(event.Ids);
+
+            switch (event.Kind) {
+            case Event::ROOMUPDATE: {
+                RoomupdateParamsData params;
+                params.Room = event.Subject;
+                params.Action = static_cast<RoomupdateParamsData::ActionType>(event.Action);
+
+                Notify(_T("roomupdate"), params);
+                break;
+            }
+            case Event::USERUPDATE: {
+                UserupdateParamsData params;
+                params.User = event.Subject;
+                params.Action = static_cast<UserupdateParamsData::ActionType>(event.Action);
+
+                Notify(_T("userupdate"), params, [&ids](const string& designator) -> bool {
+                    return (Addressed(ids, designator));
+                });
+                break;
+            }
+            case Event::MESSAGE: {
+                MessageParamsData params;
+                params.User = event.Subject;
+                params.Message = event.Text;
+
+                Notify(_T("message"), params, [&ids](const string& designator) -> bool {
+                    return (Addressed(ids, designator));
+                });
+                break;
+            }
+            default:
+                ASSERT(false);
+                break;
+            }
+        }
     }
 
 } // namespace Plugin
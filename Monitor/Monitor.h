@@ -24,6 +24,7 @@
 #include <interfaces/IMemory.h>
 #include <interfaces/json/JsonData_Monitor.h>
 #include <limits>
+#include <random>
 #include <string>
 
 static uint32_t gcd(uint32_t a, uint32_t b)
@@ -370,6 +371,42 @@ namespace Plugin {
             RestartInfo Restart;
         };
 
+        class History : public Core::JSON::Container {
+        public:
+            History& operator=(const History&) = delete;
+
+            History()
+                : Core::JSON::Container()
+            {
+                Init();
+            }
+            History(const History& copy)
+                : Core::JSON::Container()
+                , Time(copy.Time)
+                , Reason(copy.Reason)
+                , Action(copy.Action)
+                , Delay(copy.Delay)
+            {
+                Init();
+            }
+            ~History() override = default;
+
+        private:
+            void Init()
+            {
+                Add(_T("time"), &Time);
+                Add(_T("reason"), &Reason);
+                Add(_T("action"), &Action);
+                Add(_T("delay"), &Delay);
+            }
+
+        public:
+            Core::JSON::String Time;
+            Core::JSON::String Reason;
+            Core::JSON::String Action;
+            Core::JSON::DecUInt32 Delay;
+        };
+
     private:
         Monitor(const Monitor&);
         Monitor& operator=(const Monitor&);
@@ -423,8 +460,13 @@ namespace Plugin {
         public:
             Config()
                 : Core::JSON::Container()
+                , Observables()
+                , Backoff(1000)
+                , MaxBackoff(60000)
             {
                 Add(_T("observables"), &Observables);
+                Add(_T("backoff"), &Backoff);
+                Add(_T("maxbackoff"), &MaxBackoff);
             }
             ~Config()
             {
@@ -432,6 +474,119 @@ namespace Plugin {
 
         public:
             Core::JSON::ArrayType<Entry> Observables;
+            Core::JSON::DecUInt32 Backoff;
+            Core::JSON::DecUInt32 MaxBackoff;
+        };
+
+        // The restarts of an observable, in a small memory mapped ring buffer in the persistent path. It
+        // outlives the Monitor (and the framework) so a crash loop is still recognized after a restart.
+        class Journal {
+        public:
+            static constexpr uint32_t Magic = 0x4D4A4E31; // "MJN1"
+            static constexpr uint16_t Entries = 32;
+
+            enum action : uint8_t {
+                RESTARTED,
+                GAVE_UP
+            };
+
+            struct Record {
+                uint64_t Time; // ticks
+                uint32_t Delay; // ms
+                uint8_t Reason;
+                uint8_t Action;
+                uint8_t Reserved[2];
+            };
+
+        private:
+            struct Layout {
+                uint32_t Magic;
+                uint16_t Count;
+                uint16_t Head;
+                Record Records[Entries];
+            };
+
+        public:
+            Journal() = delete;
+            Journal(const Journal&) = delete;
+            Journal& operator=(const Journal&) = delete;
+
+            Journal(const string& fileName)
+                : _file(nullptr)
+                , _layout(nullptr)
+            {
+                Core::File file(fileName);
+
+                if ((file.Exists() == false) || (file.Size() != sizeof(Layout))) {
+                    if (file.Create() == true) {
+                        Layout empty;
+                        ::memset(&empty, 0, sizeof(empty));
+                        empty.Magic = Magic;
+                        file.Write(reinterpret_cast<const uint8_t*>(&empty), sizeof(empty));
+                        file.Close();
+                    }
+                }
+
+                _file = new Core::DataElementFile(fileName, Core::File::SHAREABLE | Core::File::USER_READ | Core::File::USER_WRITE, 0);
+
+                if ((_file->IsValid() == true) && (_file->Size() == sizeof(Layout))) {
+                    _layout = reinterpret_cast<Layout*>(_file->Buffer());
+
+                    if ((_layout->Magic != Magic) || (_layout->Count > Entries) || (_layout->Head >= Entries)) {
+                        ::memset(_layout, 0, sizeof(Layout));
+                        _layout->Magic = Magic;
+                    }
+                } else {
+                    SYSLOG(Logging::Startup, (_T("Restart journal %s could not be opened."), fileName.c_str()));
+                }
+            }
+            ~Journal()
+            {
+                if (_file != nullptr) {
+                    if (_layout != nullptr) {
+                        _file->Sync();
+                    }
+                    delete _file;
+                }
+            }
+
+        public:
+            bool IsValid() const
+            {
+                return (_layout != nullptr);
+            }
+            void Add(const uint64_t time, const uint8_t reason, const action what, const uint32_t delay)
+            {
+                if (_layout != nullptr) {
+                    Record& entry(_layout->Records[_layout->Head]);
+                    entry.Time = time;
+                    entry.Delay = delay;
+                    entry.Reason = reason;
+                    entry.Action = what;
+
+                    _layout->Head = (_layout->Head + 1) % Entries;
+                    if (_layout->Count < Entries) {
+                        _layout->Count++;
+                    }
+                }
+            }
+            // Visits the records, the oldest first.
+            template <typename VISITOR>
+            void Visit(VISITOR&& visitor) const
+            {
+                if (_layout != nullptr) {
+                    uint16_t index((_layout->Head + Entries - _layout->Count) % Entries);
+
+                    for (uint16_t count = 0; count < _layout->Count; count++) {
+                        visitor(_layout->Records[index]);
+                        index = (index + 1) % Entries;
+                    }
+                }
+            }
+
+        private:
+            Core::DataElementFile* _file;
+            Layout* _layout;
         };
 
         class MonitorObjects : public PluginHost::IPlugin::INotification {
@@ -477,6 +632,9 @@ namespace Plugin {
                     , _restartWindowStart()
                     , _restartCount(0)
                     , _restartLimit(restartLimit)
+                    , _consecutive(0)
+                    , _activated(0)
+                    , _pending()
                     , _measurement()
                     , _operationalEvaluate(actOnOperational)
                     , _source(nullptr)
@@ -496,6 +654,9 @@ namespace Plugin {
                     , _restartWindowStart(copy._restartWindowStart)
                     , _restartCount(copy._restartCount)
                     , _restartLimit(copy._restartLimit)
+                    , _consecutive(copy._consecutive)
+                    , _activated(copy._activated)
+                    , _pending(copy._pending)
                     , _measurement(copy._measurement)
                     , _operationalEvaluate(copy._operationalEvaluate)
                     , _source(copy._source)
@@ -520,14 +681,8 @@ namespace Plugin {
                     ASSERT(why == PluginHost::IShell::MEMORY_EXCEEDED || why == PluginHost::IShell::FAILURE);
                     ASSERT(HasRestartAllowed());
 
-                    if (((_restartWindowStart.IsValid() == true) && (_restartWindowStart > Core::Time::Now())) || (_restartWindow == 0)) {
-                        // It's within window.
-                        _restartCount += _restartCount + 1;
-                    } else {
-                        _restartWindowStart = Core::Time::Now().Add(_restartWindow * 1000 /* ms */);
-                        _restartCount = 0;
-                    }
-                    
+                    Count(Core::Time::Now());
+
                     bool result = ((_restartLimit == 0) || (_restartCount < _restartLimit));
                     if (result == false) {
                         _restartCount = 0;
@@ -535,6 +690,57 @@ namespace Plugin {
 
                     return result;
                 }
+                // Replay a restart from the journal, the state is as if the Monitor had been there all along.
+                inline void Restore(const Core::Time& when, const uint64_t stable, const bool restarted)
+                {
+                    Count(when);
+
+                    if ((_restartLimit != 0) && (_restartCount >= _restartLimit)) {
+                        _restartCount = 0;
+                    }
+
+                    if (restarted == false) {
+                        _consecutive = 0;
+                    } else {
+                        _consecutive = (((_activated != 0) && ((when.Ticks() - _activated) <= stable)) ? _consecutive + 1 : 1);
+                    }
+                    _activated = when.Ticks();
+                }
+                // The delay (ms) before the next restart, doubling with every restart that follows the previous one
+                // within the stable period (both in ms). The first restart of a series is immediate.
+                inline uint32_t Backoff(const uint32_t initial, const uint32_t stable)
+                {
+                    const uint64_t now(Core::Time::Now().Ticks());
+
+                    if ((_activated == 0) || ((now - _activated) > (static_cast<uint64_t>(stable) * Core::Time::TicksPerMillisecond))) {
+                        _consecutive = 0;
+                    }
+
+                    uint32_t delay = 0;
+
+                    if ((initial != 0) && (_consecutive > 0)) {
+                        const uint8_t shift(static_cast<uint8_t>(std::min(_consecutive - 1, static_cast<uint32_t>(16))));
+                        delay = static_cast<uint32_t>(std::min(static_cast<uint64_t>(initial) << shift, static_cast<uint64_t>(stable)));
+                    }
+
+                    _consecutive++;
+
+                    return (delay);
+                }
+                inline void Pending(const Core::ProxyType<Core::IDispatch>& job)
+                {
+                    _pending = job;
+                }
+                inline Core::ProxyType<Core::IDispatch> Pending()
+                {
+                    Core::ProxyType<Core::IDispatch> result(_pending);
+                    _pending.Release();
+                    return (result);
+                }
+                inline bool IsPending(const Core::IDispatch* job) const
+                {
+                    return ((_pending.IsValid() == true) && (_pending.operator->() == job));
+                }
                 inline uint8_t RestartLimit()
                 {
                     return _restartLimit;
@@ -625,7 +831,25 @@ namespace Plugin {
                 }
 
                 bool IsActive() const { return _active; }
-                void Active(bool active) { _active = active; }
+                void Active(bool active)
+                {
+                    if ((active == true) && (_active == false)) {
+                        _activated = Core::Time::Now().Ticks();
+                    }
+                    _active = active;
+                }
+
+            private:
+                inline void Count(const Core::Time& when)
+                {
+                    if (((_restartWindowStart.IsValid() == true) && (_restartWindowStart > when)) || (_restartWindow == 0)) {
+                        // It's within window.
+                        _restartCount += _restartCount + 1;
+                    } else {
+                        _restartWindowStart = Core::Time(when).Add(_restartWindow * 1000 /* ms */);
+                        _restartCount = 0;
+                    }
+                }
 
             private:
                 const uint32_t _operationalInterval; //!< Interval (s) to check the monitored processes
@@ -638,6 +862,9 @@ namespace Plugin {
                 Core::Time _restartWindowStart;
                 uint32_t _restartCount;
                 uint8_t _restartLimit;
+                uint32_t _consecutive; //!< Restarts without a stable period in between.
+                uint64_t _activated; //!< Last time (ticks) the observable was activated (or restarted).
+                Core::ProxyType<Core::IDispatch> _pending; //!< A delayed restart that is not yet executed.
                 MetaData _measurement;
                 bool _operationalEvaluate;
                 Exchange::IMemory* _source;
@@ -645,6 +872,37 @@ namespace Plugin {
                 bool _active;
             };
 
+        private:
+            // A delayed restart. It only activates the plugin if it is still the pending restart of
+            // that plugin, a restart that got superseded or revoked in the meantime does nothing.
+            class DelayedRestart : public Core::IDispatch {
+            public:
+                DelayedRestart() = delete;
+                DelayedRestart(const DelayedRestart&) = delete;
+                DelayedRestart& operator=(const DelayedRestart&) = delete;
+
+                DelayedRestart(MonitorObjects& parent, const string& callsign, const Core::ProxyType<Core::IDispatch>& job)
+                    : _parent(parent)
+                    , _callsign(callsign)
+                    , _job(job)
+                {
+                }
+                ~DelayedRestart() override = default;
+
+            public:
+                void Dispatch() override
+                {
+                    if (_parent.Started(_callsign, this) == true) {
+                        _job->Dispatch();
+                    }
+                }
+
+            private:
+                MonitorObjects& _parent;
+                const string _callsign;
+                Core::ProxyType<Core::IDispatch> _job;
+            };
+
         public:
 #ifdef __WINDOWS__
 #pragma warning(disable : 4355)
@@ -652,9 +910,13 @@ namespace Plugin {
             MonitorObjects(Monitor* parent)
                 : _adminLock()
                 , _monitor()
+                , _journals()
                 , _job(*this)
                 , _service(nullptr)
                 , _parent(*parent)
+                , _backoff(0)
+                , _maxBackoff(0)
+                , _random(static_cast<uint32_t>(Core::Time::Now().Ticks()))
             {
             }
 #ifdef __WINDOWS__
@@ -686,17 +948,22 @@ namespace Plugin {
 
                 _adminLock.Unlock();
             }
-            inline void Open(PluginHost::IShell* service, Core::JSON::ArrayType<Config::Entry>::Iterator& index)
+            inline void Open(PluginHost::IShell* service, Core::JSON::ArrayType<Config::Entry>::Iterator& index, const uint32_t backoff, const uint32_t maxBackoff)
             {
                 ASSERT((service != nullptr) && (_service == nullptr));
 
                 uint64_t baseTime = Core::Time::Now().Ticks();
+                const string journalPath(service->PersistentPath());
+                const bool journaling(Core::Directory(journalPath.c_str()).CreatePath());
 
                 _service = service;
                 _service->AddRef();
 
                 _adminLock.Lock();
 
+                _backoff = backoff;
+                _maxBackoff = std::max(backoff, maxBackoff);
+
                 while (index.Next() == true) {
                     Config::Entry& element(index.Current());
                     string callSign(element.Callsign.Value());
@@ -713,7 +980,7 @@ namespace Plugin {
                     }
                     SYSLOG(Logging::Startup, (_T("Monitoring: %s (%d,%d)."), callSign.c_str(), (interval / 1000000), (memory / 1000000)));
                     if ((interval != 0) || (memory != 0)) {
-                        _monitor.insert(
+                        auto entry = _monitor.insert(
                             std::pair<string, MonitorObject>(callSign, MonitorObject(
                                 element.Operational.Value() >= 0, 
                                 interval, 
@@ -722,6 +989,19 @@ namespace Plugin {
                                 baseTime, 
                                 restartWindow, 
                                 restartLimit)));
+
+                        if ((journaling == true) && (entry.second == true)) {
+                            auto journal = _journals.emplace(std::piecewise_construct,
+                                std::forward_as_tuple(callSign),
+                                std::forward_as_tuple(journalPath + callSign + _T(".journal")));
+
+                            MonitorObject& object(entry.first->second);
+                            const uint64_t stable(static_cast<uint64_t>(_maxBackoff) * Core::Time::TicksPerMillisecond);
+
+                            journal.first->second.Visit([&object, stable](const Journal::Record& record) {
+                                object.Restore(Core::Time(record.Time), stable, (record.Action == Journal::RESTARTED));
+                            });
+                        }
                     }
                 }
 
@@ -735,14 +1015,33 @@ namespace Plugin {
 
                 _job.Revoke();
 
+                std::list<Core::ProxyType<Core::IDispatch>> pending;
+
+                _adminLock.Lock();
+                for (auto& entry : _monitor) {
+                    Core::ProxyType<Core::IDispatch> job(entry.second.Pending());
+                    if (job.IsValid() == true) {
+                        pending.push_back(job);
+                    }
+                }
+                _adminLock.Unlock();
+
+                for (Core::ProxyType<Core::IDispatch>& job : pending) {
+                    Core::IWorkerPool::Instance().Revoke(job);
+                }
+
                 _adminLock.Lock();
                 _monitor.clear();
+                _journals.clear();
                 _adminLock.Unlock();
                 _service->Release();
                 _service = nullptr;
             }
             virtual void StateChange(PluginHost::IShell* service)
             {
+                // A restart that is no longer needed, revoked outside the lock as it might be waiting for it.
+                Core::ProxyType<Core::IDispatch> revoke;
+
                 _adminLock.Lock();
 
                 std::map<string, MonitorObject>::iterator index(_monitor.find(service->Callsign()));
@@ -753,6 +1052,9 @@ namespace Plugin {
                     PluginHost::IShell::state currentState(service->State());
 
                     if (currentState == PluginHost::IShell::ACTIVATED) {
+                        // Activated before the delayed restart kicked in (e.g. manually), it is not needed anymore.
+                        revoke = index->second.Pending();
+
                         bool is_active = index->second.IsActive();
                         index->second.Active(true);
                         if (is_active == false && std::count_if(_monitor.begin(), _monitor.end(), [](const std::pair<string, MonitorObject>& v) {
@@ -780,7 +1082,12 @@ namespace Plugin {
                     } else if ((currentState == PluginHost::IShell::DEACTIVATED)) {
                         index->second.Active(false);
                         if ((index->second.HasRestartAllowed() == true) && ((service->Reason() == PluginHost::IShell::MEMORY_EXCEEDED) || (service->Reason() == PluginHost::IShell::FAILURE))) {
+                            std::map<string, Journal>::iterator journal(_journals.find(service->Callsign()));
+
                             if (index->second.RegisterRestart(service->Reason()) == false) {
+                                if (journal != _journals.end()) {
+                                    journal->second.Add(Core::Time::Now().Ticks(), service->Reason(), Journal::GAVE_UP, 0);
+                                }
                                 TRACE(Trace::Fatal, (_T("Giving up restarting of %s: Failed more than %d times within %d seconds."), service->Callsign().c_str(), index->second.RestartLimit(), index->second.RestartWindow()));
                                 const string message("{\"callsign\": \"" + service->Callsign() + "\", \"action\": \"Restart\", \"reason\":\"" + (std::to_string(index->second.RestartLimit())).c_str() + " Attempts Failed within the restart window\"}");
                                 _service->Notify(message);
@@ -789,14 +1096,36 @@ namespace Plugin {
                                 const string message("{\"callsign\": \"" + service->Callsign() + "\", \"action\": \"Activate\", \"reason\": \"Automatic\" }");
                                 _service->Notify(message);
                                 _parent.event_action(service->Callsign(), "Activate", "Automatic");
-                                TRACE(Trace::Error, (_T("Restarting %s again because we detected it misbehaved."), service->Callsign().c_str()));
-                                Core::IWorkerPool::Instance().Submit(PluginHost::IShell::Job::Create(service, PluginHost::IShell::ACTIVATED, PluginHost::IShell::AUTOMATIC));
+                                uint32_t delay(Jitter(index->second.Backoff(_backoff, _maxBackoff)));
+
+                                if (journal != _journals.end()) {
+                                    journal->second.Add(Core::Time::Now().Ticks(), service->Reason(), Journal::RESTARTED, delay);
+                                }
+
+                                Core::ProxyType<Core::IDispatch> job(PluginHost::IShell::Job::Create(service, PluginHost::IShell::ACTIVATED, PluginHost::IShell::AUTOMATIC));
+
+                                // Never leave an earlier restart behind, this one replaces it.
+                                revoke = index->second.Pending();
+
+                                if (delay == 0) {
+                                    TRACE(Trace::Error, (_T("Restarting %s again because we detected it misbehaved."), service->Callsign().c_str()));
+                                    Core::IWorkerPool::Instance().Submit(job);
+                                } else {
+                                    TRACE(Trace::Error, (_T("Restarting %s again in %d ms because we detected it misbehaved."), service->Callsign().c_str(), delay));
+                                    Core::ProxyType<Core::IDispatch> delayed(Core::ProxyType<DelayedRestart>::Create(*this, service->Callsign(), job));
+                                    index->second.Pending(delayed);
+                                    Core::IWorkerPool::Instance().Schedule(Core::Time::Now().Add(delay), delayed);
+                                }
                             }
                         }
                     }
                 }
 
                 _adminLock.Unlock();
+
+                if (revoke.IsValid() == true) {
+                    Core::IWorkerPool::Instance().Revoke(revoke);
+                }
             }
             void Snapshot(Core::JSON::ArrayType<Monitor::Data>& snapshot)
             {
@@ -911,6 +1240,30 @@ namespace Plugin {
                 return (found);
             }
 
+            bool Restarts(const string& name, Core::JSON::ArrayType<Monitor::History>& response)
+            {
+                bool found = false;
+
+                _adminLock.Lock();
+
+                std::map<string, Journal>::const_iterator index(_journals.find(name));
+
+                if (index != _journals.end()) {
+                    index->second.Visit([&response](const Journal::Record& record) {
+                        Monitor::History& entry(response.Add());
+                        entry.Time = Core::Time(record.Time).ToISO8601(true);
+                        entry.Reason = Core::EnumerateType<PluginHost::IShell::reason>(static_cast<PluginHost::IShell::reason>(record.Reason)).Data();
+                        entry.Action = (record.Action == Journal::RESTARTED ? _T("restart") : _T("giveup"));
+                        entry.Delay = record.Delay;
+                    });
+                    found = true;
+                }
+
+                _adminLock.Unlock();
+
+                return (found);
+            }
+
             BEGIN_INTERFACE_MAP(MonitorObjects)
             INTERFACE_ENTRY(PluginHost::IPlugin::INotification)
             END_INTERFACE_MAP
@@ -979,6 +1332,35 @@ namespace Plugin {
             }
 
         private:
+            // Called by a delayed restart when it runs, clears it as the pending restart of the plugin.
+            bool Started(const string& callsign, const Core::IDispatch* job)
+            {
+                bool result = false;
+
+                _adminLock.Lock();
+
+                std::map<string, MonitorObject>::iterator index(_monitor.find(callsign));
+
+                if ((index != _monitor.end()) && (index->second.IsPending(job) == true)) {
+                    index->second.Pending();
+                    result = true;
+                }
+
+                _adminLock.Unlock();
+
+                return (result);
+            }
+            // Spread the restarts of plugins that failed together (boot storm) by +/- 25%.
+            uint32_t Jitter(const uint32_t delay)
+            {
+                uint32_t result(delay);
+
+                if (delay >= 4) {
+                    result = delay - (delay / 4) + (_random() % ((delay / 2) + 1));
+                }
+
+                return (result);
+            }
             template <typename T>
             void translate(const Core::MeasurementType<T>& from, JsonData::Monitor::MeasurementInfo* to)
             {
@@ -990,9 +1372,13 @@ namespace Plugin {
 
             Core::CriticalSection _adminLock;
             std::map<string, MonitorObject> _monitor;
+            std::map<string, Journal> _journals;
             Core::WorkerPool::JobType<MonitorObjects&> _job;
             PluginHost::IShell* _service;
             Monitor& _parent;
+            uint32_t _backoff;
+            uint32_t _maxBackoff;
+            std::mt19937 _random;
         };
 
     public:
@@ -1069,6 +1455,7 @@ namespace Plugin {
         uint32_t endpoint_restartlimits(const JsonData::Monitor::RestartlimitsParamsData& params);
         uint32_t endpoint_resetstats(const JsonData::Monitor::ResetstatsParamsData& params, JsonData::Monitor::InfoInfo& response);
         uint32_t get_status(const string& index, Core::JSON::ArrayType<JsonData::Monitor::InfoInfo>& response) const;
+        uint32_t get_history(const string& index, Core::JSON::ArrayType<History>& response) const;
         void event_action(const string& callsign, const string& action, const string& reason);
     };
 }
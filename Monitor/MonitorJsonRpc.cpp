@@ -35,6 +35,7 @@ namespace Plugin {
         Register<RestartlimitsParamsData,void>(_T("restartlimits"), &Monitor::endpoint_restartlimits, this);
         Register<ResetstatsParamsData,InfoInfo>(_T("resetstats"), &Monitor::endpoint_resetstats, this);
         Property<Core::JSON::ArrayType<InfoInfo>>(_T("status"), &Monitor::get_status, nullptr, this);
+        Property<Core::JSON::ArrayType<Monitor::History>>(_T("history"), &Monitor::get_history, nullptr, this);
     }
 
     void Monitor::UnregisterAll()
@@ -42,6 +43,7 @@ namespace Plugin {
         Unregister(_T("resetstats"));
         Unregister(_T("restartlimits"));
         Unregister(_T("status"));
+        Unregister(_T("history"));
     }
 
     // API implementation
@@ -85,6 +87,15 @@ namespace Plugin {
         return Core::ERROR_NONE;
     }
 
+    // Property: history - The restarts of a plugin watched by the Monitor, also from before the Monitor (re)started
+    // Return codes:
+    //  - ERROR_NONE: Success
+    //  - ERROR_UNKNOWN_KEY: No restart journal for this callsign
+    uint32_t Monitor::get_history(const string& index, Core::JSON::ArrayType<Monitor::History>& response) const
+    {
+        return (_monitor->Restarts(index, response) == true ? Core::ERROR_NONE : Core::ERROR_UNKNOWN_KEY);
+    }
+
     // Event: action - Signals action taken by the monitor
     void Monitor::event_action(const string& callsign, const string& action, const string& reason)
     {
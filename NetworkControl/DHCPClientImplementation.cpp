@@ -32,6 +32,21 @@ namespace Plugin {
 
     /* static */ constexpr uint8_t DHCPClientImplementation::MagicCookie[];
 
+    // RFC 826 message for Ethernet/IPv4, the link layer header is taken care of by the socket.
+#pragma pack(push, 1)
+    struct ARPMessage {
+        uint16_t htype;
+        uint16_t ptype;
+        uint8_t hlen;
+        uint8_t plen;
+        uint16_t operation;
+        uint8_t sha[ETH_ALEN];
+        uint32_t spa;
+        uint8_t tha[ETH_ALEN];
+        uint32_t tpa;
+    };
+#pragma pack(pop)
+
     class DHCPIPPacket {
         /*
          * DHCP Protocol (rfc2131) defines, that every message prior to acquiring IP 
@@ -80,7 +95,7 @@ namespace Plugin {
             RecalcIpHeaderChecksum();
         } 
 
-        static Core::NodeId BroadcastNode(const string& interfaceName)
+        static Core::NodeId BroadcastNode(const string& interfaceName, const uint16_t protocol = ETH_P_IP)
         {
             Core::NodeId result;
 
@@ -89,7 +104,7 @@ namespace Plugin {
             struct sockaddr_ll target;
             memset(&target, 0, sizeof(target));
             target.sll_family   = PF_PACKET;
-            target.sll_protocol = htons(ETH_P_IP);
+            target.sll_protocol = htons(protocol);
             target.sll_ifindex  = index;
             target.sll_hatype   = ARPHRD_ETHER;
             target.sll_pkttype  = PACKET_BROADCAST;
@@ -179,7 +194,153 @@ namespace Plugin {
         static constexpr uint16_t PROTOCOL_UDP = 17;
     };
 
-    DHCPClientImplementation::DHCPClientImplementation(const string& interfaceName, DiscoverCallback discoverCallback, RequestCallback claimCallback, LeaseExpiredCallback leaseExpiredCallback)
+    DHCPClientImplementation::Probe::Probe(DHCPClientImplementation& parent, const string& interfaceName)
+        : Core::SocketDatagram(false, DHCPIPPacket::BroadcastNode(interfaceName, ETH_P_ARP), DHCPIPPacket::BroadcastNode(interfaceName, ETH_P_ARP), 64, 256)
+        , _adminLock()
+        , _parent(parent)
+        , _interfaceName(interfaceName)
+        , _target(0)
+        , _sent(0)
+        , _pending(false)
+        , _until(0)
+        , _job(*this)
+    {
+    }
+
+    /* virtual */ DHCPClientImplementation::Probe::~Probe()
+    {
+        _job.Revoke();
+        SocketDatagram::Close(Core::infinite);
+    }
+
+    void DHCPClientImplementation::Probe::Start(const Core::NodeId& address)
+    {
+        ASSERT(address.Type() == Core::NodeId::TYPE_IPV4);
+
+        _job.Revoke();
+
+        _adminLock.Lock();
+
+        _target = reinterpret_cast<const struct sockaddr_in*>(static_cast<const struct sockaddr*>(address))->sin_addr.s_addr;
+        _sent = 0;
+        _pending = false;
+        _until = Core::Time::Now().Add(ProbeWindow).Ticks();
+
+        // Called on the communication thread, so do not wait for the socket to open.
+        if ((SocketDatagram::IsOpen() == true) || (SocketDatagram::Open(0, _interfaceName) == Core::ERROR_NONE)) {
+            _job.Submit();
+        } else {
+            TRACE_L1("ARP socket for %s could not be opened, no conflict detection for %s", _interfaceName.c_str(), address.HostAddress().c_str());
+            _target = 0;
+        }
+
+        _adminLock.Unlock();
+    }
+
+    void DHCPClientImplementation::Probe::Stop()
+    {
+        _job.Revoke();
+
+        _adminLock.Lock();
+
+        _target = 0;
+        _pending = false;
+
+        if (SocketDatagram::IsOpen() == true) {
+            SocketDatagram::Close(0);
+        }
+
+        _adminLock.Unlock();
+    }
+
+    void DHCPClientImplementation::Probe::Dispatch()
+    {
+        _adminLock.Lock();
+
+        if (_target != 0) {
+            Core::Time now(Core::Time::Now());
+
+            if (_sent < ProbeCount) {
+                _pending = true;
+                SocketDatagram::Trigger();
+                _job.Schedule(now.Add(ProbeInterval));
+            } else if (now.Ticks() < _until) {
+                _job.Schedule(Core::Time(_until));
+            } else {
+                TRACE_L1("No address conflict detected on %s", _interfaceName.c_str());
+                _target = 0;
+                SocketDatagram::Close(0);
+            }
+        }
+
+        _adminLock.Unlock();
+    }
+
+    /* virtual */ uint16_t DHCPClientImplementation::Probe::SendData(uint8_t* dataFrame, const uint16_t maxSendSize)
+    {
+        uint16_t result = 0;
+
+        _adminLock.Lock();
+
+        if ((_pending == true) && (_target != 0) && (maxSendSize >= sizeof(ARPMessage))) {
+            ARPMessage& message(*reinterpret_cast<ARPMessage*>(dataFrame));
+
+            ::memset(&message, 0, sizeof(ARPMessage));
+            message.htype = htons(ARPHRD_ETHER);
+            message.ptype = htons(ETH_P_IP);
+            message.hlen = ETH_ALEN;
+            message.plen = 4;
+            message.operation = htons(ARPOP_REQUEST);
+            ::memcpy(message.sha, _parent._MAC, ETH_ALEN);
+
+            // A probe has no sender address, nobody should learn a mapping that might still be declined.
+            message.tpa = _target;
+
+            _pending = false;
+            _sent++;
+            result = sizeof(ARPMessage);
+        }
+
+        _adminLock.Unlock();
+
+        return (result);
+    }
+
+    /* virtual */ uint16_t DHCPClientImplementation::Probe::ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize)
+    {
+        if (receivedSize >= sizeof(ARPMessage)) {
+            const ARPMessage& message(*reinterpret_cast<const ARPMessage*>(dataFrame));
+            uint32_t conflict = 0;
+
+            _adminLock.Lock();
+
+            if ((_target != 0) && (message.hlen == ETH_ALEN) && (message.plen == 4) && (::memcmp(message.sha, _parent._MAC, ETH_ALEN) != 0)) {
+
+                // Another host uses the address, or is probing for it at the same time (RFC 5227 section 2.1.1)
+                if ((message.spa == _target) || ((message.spa == 0) && (message.tpa == _target) && (ntohs(message.operation) == ARPOP_REQUEST))) {
+                    conflict = _target;
+                    _target = 0;
+                }
+            }
+
+            _adminLock.Unlock();
+
+            if (conflict != 0) {
+                _job.Revoke();
+                SocketDatagram::Close(0);
+
+                _parent.Conflict(conflict);
+            }
+        }
+
+        return (receivedSize);
+    }
+
+    /* virtual */ void DHCPClientImplementation::Probe::StateChange()
+    {
+    }
+
+    DHCPClientImplementation::DHCPClientImplementation(const string& interfaceName, DiscoverCallback discoverCallback, RequestCallback claimCallback, LeaseExpiredCallback leaseExpiredCallback, ConflictCallback conflictCallback)
         : Core::SocketDatagram(false, DHCPIPPacket::BroadcastNode(interfaceName), DHCPIPPacket::BroadcastNode(interfaceName), 512, 1024)
         , _adminLock()
         , _interfaceName(interfaceName)
@@ -190,9 +351,11 @@ namespace Plugin {
         , _discoverCallback(discoverCallback)
         , _claimCallback(claimCallback)
         , _leaseExpiredCallback(leaseExpiredCallback)
+        , _conflictCallback(conflictCallback)
         , _leasedOffer()
         , _unleasedOffers()
         , _activity(*this)
+        , _probe(*this, interfaceName)
     {
         Core::AdapterIterator adapters(_interfaceName);
 
@@ -205,6 +368,7 @@ namespace Plugin {
 
     /* virtual */ DHCPClientImplementation::~DHCPClientImplementation()
     {
+        _probe.Stop();
         _activity.Revoke();
         SocketDatagram::Close(Core::infinite);
     }
@@ -248,5 +412,37 @@ namespace Plugin {
     /* virtual */ void DHCPClientImplementation::StateChange()
     {
     }
+
+    void DHCPClientImplementation::Conflict(const uint32_t address)
+    {
+        _adminLock.Lock();
+        bool ours = (_leasedOffer.IsValid() == true) && (reinterpret_cast<const struct sockaddr_in*>(static_cast<const struct sockaddr*>(_leasedOffer.Address()))->sin_addr.s_addr == address);
+        _adminLock.Unlock();
+
+        if (ours == true) {
+            // The lease timer needs our lock when it fires, so revoke it outside of it.
+            _activity.Revoke();
+
+            _adminLock.Lock();
+
+            Offer declined(_leasedOffer);
+
+            if (declined.IsValid() == true) {
+                TRACE(Trace::Information, ("Address %s is in use by another host on %s", declined.Address().HostAddress().c_str(), _interfaceName.c_str()));
+
+                _leasedOffer.Clear();
+                Decline(declined);
+
+                // With the lease gone, the lease timer brings us back to DISCOVER.
+                _activity.Schedule(Core::Time::Now().Add(DeclineBackOff * 1000));
+            }
+
+            _adminLock.Unlock();
+
+            if (declined.IsValid() == true) {
+                _conflictCallback(declined);
+            }
+        }
+    }
 }
 } // namespace WPEFramework::Plugin
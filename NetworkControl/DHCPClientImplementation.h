@@ -77,6 +77,7 @@ namespace Plugin {
             OPTION_RENEWALTIME = 58,
             OPTION_REBINDINGTIME = 59,
             OPTION_CLIENTIDENTIFIER = 61,
+            OPTION_RAPIDCOMMIT = 80, // RFC 4039
             OPTION_END = 255,
         };
 
@@ -95,6 +96,9 @@ namespace Plugin {
         // DHCP magic cookie values
         static constexpr uint8_t MagicCookie[] = { 99, 130, 83, 99 };
 
+        // Seconds to wait after declining an address before starting over (RFC 2131 section 3.1)
+        static constexpr uint16_t DeclineBackOff = 10;
+
         // RFC 2131 section 2
 #pragma pack(push, 1)
         struct CoreMessage {
@@ -158,6 +162,45 @@ namespace Plugin {
             std::string _text;
         };
 
+        // Address conflict detection (RFC 5227). The probes go out while the acknowledged address is
+        // already being configured, so on a conflict free link nobody waits for the probe window.
+        class Probe : public Core::SocketDatagram {
+        private:
+            static constexpr uint8_t ProbeCount = 3;
+            static constexpr uint16_t ProbeInterval = 200; // ms
+            static constexpr uint16_t ProbeWindow = 1000; // ms, counted from the first probe
+
+        public:
+            Probe() = delete;
+            Probe(const Probe&) = delete;
+            Probe& operator=(const Probe&) = delete;
+
+            Probe(DHCPClientImplementation& parent, const string& interfaceName);
+            ~Probe() override;
+
+        public:
+            void Start(const Core::NodeId& address);
+            void Stop();
+
+        private:
+            uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) override;
+            uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) override;
+            void StateChange() override;
+
+            friend Core::ThreadPool::JobType<Probe&>;
+            void Dispatch();
+
+        private:
+            Core::CriticalSection _adminLock;
+            DHCPClientImplementation& _parent;
+            string _interfaceName;
+            uint32_t _target;
+            uint8_t _sent;
+            bool _pending;
+            uint64_t _until;
+            Core::WorkerPool::JobType<Probe&> _job;
+        };
+
     public:
         // DHCP constants (see RFC 2131 section 4.1)
         static constexpr uint16_t DefaultDHCPServerPort = 67;
@@ -174,6 +217,8 @@ namespace Plugin {
                 , leaseTime()
                 , renewalTime()
                 , rebindingTime()
+                , serverIdentifier()
+                , rapidCommit(false)
             {
             }
 
@@ -186,6 +231,8 @@ namespace Plugin {
                 , leaseTime()
                 , renewalTime()
                 , rebindingTime()
+                , serverIdentifier()
+                , rapidCommit(false)
             {
                 FromRAW(optionsData, length);    
             }
@@ -264,6 +311,15 @@ namespace Plugin {
                         ::memcpy(&rebindingTime, &optionsData[used], sizeof(rebindingTime));
                         rebindingTime = ntohl(rebindingTime);
                         break;
+                    case OPTION_SERVERIDENTIFIER: {
+                        struct in_addr rInfo;
+                        rInfo.s_addr = htonl(optionsData[used] << 24 | optionsData[used + 1] << 16 | optionsData[used + 2] << 8 | optionsData[used + 3]);
+                        serverIdentifier = rInfo;
+                        break;
+                    }
+                    case OPTION_RAPIDCOMMIT:
+                        rapidCommit = true;
+                        break;
                     }
 
                     /* move on to the next option. */
@@ -281,6 +337,8 @@ namespace Plugin {
             Core::OptionalType<uint32_t> leaseTime; /* lease time in seconds */
             Core::OptionalType<uint32_t> renewalTime; /* renewal time in seconds */
             Core::OptionalType<uint32_t> rebindingTime; /* rebinding time in seconds */
+            Core::NodeId serverIdentifier; /* the DHCP server that sent the message */
+            bool rapidCommit; /* ACK that answers a DISCOVER directly */
         };
 
         class Offer {
@@ -385,6 +443,9 @@ namespace Plugin {
                     result._renewalTime = renewalTime.Value();
                     result._rebindingTime = rebindingTime.Value();
 
+                    // Only acknowledged leases get persisted.
+                    result._bound = true;
+
                     return result;
                 }
             private:
@@ -411,6 +472,7 @@ namespace Plugin {
                 , _leaseTime(0)
                 , _renewalTime(0)
                 , _rebindingTime(0)
+                , _bound(false)
             {
                 Crypto::Random(_id);
             }
@@ -424,6 +486,7 @@ namespace Plugin {
                 , _leaseTime(0)
                 , _renewalTime(0)
                 , _rebindingTime(0)
+                , _bound(false)
             {
                 _source = frame.siaddr;
                 _offer = frame.yiaddr;
@@ -442,6 +505,7 @@ namespace Plugin {
                 , _renewalTime(copy._renewalTime)
                 , _rebindingTime(copy._rebindingTime)
                 , _id(copy._id)
+                , _bound(copy._bound)
             {
             }
             
@@ -451,7 +515,12 @@ namespace Plugin {
 
             void Update(DHCPMessageOptions& options) {
                if (_offer.IsValid() == true) {
-                    
+
+                    // The siaddr field is the next (boot) server, option 54 really names the DHCP server.
+                    if (options.serverIdentifier.IsValid() == true) {
+                        _source = options.serverIdentifier;
+                    }
+
                     _gateway = options.gateway;
                     _broadcast = options.broadcast;
                     _dns = options.dns;
@@ -511,6 +580,7 @@ namespace Plugin {
                 _renewalTime = rhs._renewalTime;
                 _rebindingTime = rhs._rebindingTime;
                 _id = rhs._id;
+                _bound = rhs._bound;
 
                 return (*this);
             }
@@ -528,6 +598,7 @@ namespace Plugin {
                 _renewalTime = 0;
                 _rebindingTime = 0;
                 _id = 0;
+                _bound = false;
             }
 
         public:
@@ -579,6 +650,15 @@ namespace Plugin {
             {
                 return (_rebindingTime);
             }
+            // Bound offers were acknowledged before, they can be confirmed with an INIT-REBOOT request.
+            bool Bound() const
+            {
+                return (_bound);
+            }
+            void Bound(const bool bound)
+            {
+                _bound = bound;
+            }
 
         private:
             Core::NodeId _source; /* address of DHCP server that sent this offer */
@@ -591,6 +671,7 @@ namespace Plugin {
             uint32_t _renewalTime; /* renewal time in seconds */
             uint32_t _rebindingTime; /* rebinding time in seconds */
             uint32_t _id; /* unique offer identifier */
+            bool _bound; /* acknowledged at least once */
         };
 
         typedef Core::IteratorType<std::list<Offer>, Offer&, std::list<Offer>::iterator> Iterator;
@@ -598,9 +679,10 @@ namespace Plugin {
         typedef std::function<void(Offer&)> DiscoverCallback;
         typedef std::function<void(Offer&)> LeaseExpiredCallback;
         typedef std::function<void(Offer&, bool)> RequestCallback;
+        typedef std::function<void(Offer&)> ConflictCallback;
 
     public:
-        DHCPClientImplementation(const string& interfaceName, DiscoverCallback discoverCallback, RequestCallback claimCallback, LeaseExpiredCallback leaseExpiredCallback);
+        DHCPClientImplementation(const string& interfaceName, DiscoverCallback discoverCallback, RequestCallback claimCallback, LeaseExpiredCallback leaseExpiredCallback, ConflictCallback conflictCallback);
         virtual ~DHCPClientImplementation();
 
     public:
@@ -684,8 +766,10 @@ namespace Plugin {
                     _preferred = offer.Address();
                     // Use offer id as transaction id to pair request with correct response
                     _xid = offer.Id(); 
+                    _serverIdentifier = 0;
 
-                    if (offer.Source().IsEmpty() == false) {
+                    // A lease we held before is confirmed without naming a server, INIT-REBOOT (RFC 2131 section 4.3.2)
+                    if ((offer.Bound() == false) && (offer.Source().IsEmpty() == false)) {
                         auto addr = reinterpret_cast<const sockaddr_in*>(static_cast<const struct sockaddr*>(offer.Source()));
                         
                         memcpy(&_serverIdentifier, &(addr->sin_addr), 4);
@@ -703,19 +787,37 @@ namespace Plugin {
             return (result);
         }
 
-        inline uint32_t Decline(const Core::NodeId& acknowledged)
+        inline uint32_t Decline(const Offer& acknowledged)
         {
 
-            uint32_t result = Core::ERROR_INPROGRESS;
+            uint32_t result = Core::ERROR_OPENING_FAILED;
 
             _adminLock.Lock();
 
-            if (_state == RECEIVING) {
+            // The socket might already be closed after the acknowledge, open it without waiting as
+            // this is typically called from the communication thread.
+            if (SocketDatagram::IsOpen() == true
+                || SocketDatagram::Open(0, _interfaceName) == Core::ERROR_NONE) {
+
+                SocketDatagram::Broadcast(true);
+
+                TRACE(Trace::Information, ("Sending DECLINE for %s", acknowledged.Address().HostAddress().c_str()));
                 _state = SENDING;
-                _modus = CLASSIFICATION_NAK;
+                _modus = CLASSIFICATION_DECLINE;
                 Crypto::Random(_xid);
-                _preferred = acknowledged;
+                _preferred = acknowledged.Address();
+                _serverIdentifier = 0;
+
+                if (acknowledged.Source().IsEmpty() == false) {
+                    auto addr = reinterpret_cast<const sockaddr_in*>(static_cast<const struct sockaddr*>(acknowledged.Source()));
+
+                    memcpy(&_serverIdentifier, &(addr->sin_addr), 4);
+                }
+
                 result = Core::ERROR_NONE;
+                SocketDatagram::Trigger();
+            } else {
+                TRACE_L1("Failed to open socket whilte trying to decline ip %s\n", acknowledged.Address().HostAddress().c_str());
             }
 
             _adminLock.Unlock();
@@ -777,6 +879,8 @@ namespace Plugin {
         }
 
         void MakeUnleasedOffer() {
+             _probe.Stop();
+
              _adminLock.Lock();
              if (_leasedOffer.IsValid() == true) {
                  AddUnleasedOfferToBegin(_leasedOffer);
@@ -837,6 +941,7 @@ namespace Plugin {
             _adminLock.Lock();
 
             _leasedOffer = offer;
+            _leasedOffer.Bound(true);
             _unleasedOffers.remove_if([offer] (Offer& o) {return o.Id() == offer.Id();});
 
             _activity.Revoke();
@@ -914,7 +1019,11 @@ namespace Plugin {
                 options[index++] = OPTION_ROUTER;
                 options[index++] = OPTION_DNS;
                 options[index++] = OPTION_BROADCASTADDRESS;
-            } else if (_modus == CLASSIFICATION_REQUEST) {
+
+                /* Servers that support it skip the OFFER/REQUEST round trip and ACK right away */
+                options[index++] = OPTION_RAPIDCOMMIT;
+                options[index++] = 0;
+            } else if ((_modus == CLASSIFICATION_REQUEST) || (_modus == CLASSIFICATION_DECLINE)) {
                 // required for usage in bridged networks
                 if (_serverIdentifier != 0) {
                     options[index++] = OPTION_SERVERIDENTIFIER;
@@ -950,7 +1059,7 @@ namespace Plugin {
                 switch (options.messageType.Value()) {
                     case CLASSIFICATION_OFFER:
                         {
-                            if (xid == _discoverXID) {
+                            if ((xid == _discoverXID) && (_modus == CLASSIFICATION_DISCOVER) && (_leasedOffer.IsValid() == false)) {
                                 AddUnleasedOfferToBegin(Offer(source, frame, options));
                                 TRACE(Trace::Information, ("Received an Offer from: %s", source.HostAddress().c_str()));
                                 _discoverCallback(_unleasedOffers.back());
@@ -961,14 +1070,28 @@ namespace Plugin {
                         }
                     case CLASSIFICATION_ACK: 
                         {
-                            Iterator index = FindUnleasedOffer(xid);
-                            Offer offer = (index.IsValid())? index.Current(): LeasedOffer();
-                                        
-                            if (offer.IsValid() && offer.Id() == xid) {
-                                offer.Update(options); // Update if informations changed since offering
-                                
-                                Offer& leased = MakeLeased(offer);
-                                _claimCallback(leased, true);
+                            if ((xid == _discoverXID) && (_modus == CLASSIFICATION_DISCOVER)) {
+                                // Only a rapid commit may answer a DISCOVER with an ACK (RFC 4039)
+                                if ((options.rapidCommit == true) && (_leasedOffer.IsValid() == false)) {
+                                    TRACE(Trace::Information, ("Received a rapid commit from: %s", source.HostAddress().c_str()));
+
+                                    Offer& leased = MakeLeased(Offer(source, frame, options));
+                                    _probe.Start(leased.Address());
+                                    _claimCallback(leased, true);
+                                }
+                            } else {
+                                Iterator index = FindUnleasedOffer(xid);
+                                Offer offer = (index.IsValid())? index.Current(): LeasedOffer();
+
+                                if (offer.IsValid() && offer.Id() == xid) {
+                                    offer.Update(options); // Update if informations changed since offering
+
+                                    Offer& leased = MakeLeased(offer);
+
+                                    // Check for duplicates while the address is being configured
+                                    _probe.Start(leased.Address());
+                                    _claimCallback(leased, true);
+                                }
                             }
                             break;
                         }
@@ -992,6 +1115,9 @@ namespace Plugin {
             return (result);
         }
 
+        // Reported by the probe when another host answers for the given address (network order).
+        void Conflict(const uint32_t address);
+
         friend Core::ThreadPool::JobType<DHCPClientImplementation&>;
         void Dispatch()
         {
@@ -1011,9 +1137,11 @@ namespace Plugin {
         DiscoverCallback _discoverCallback;
         RequestCallback _claimCallback;
         LeaseExpiredCallback _leaseExpiredCallback;
+        ConflictCallback _conflictCallback;
         Offer _leasedOffer;
         std::list<Offer> _unleasedOffers;
         Core::WorkerPool::JobType<DHCPClientImplementation&> _activity;
+        Probe _probe;
     };
 }
 } // namespace WPEFramework::Plugin
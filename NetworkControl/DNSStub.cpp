@@ -0,0 +1,518 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DNSStub.h"
+
+namespace WPEFramework {
+
+namespace Plugin {
+
+    namespace {
+
+        constexpr uint16_t DNSPort = 53;
+
+        constexpr uint8_t RCODE_NOERROR = 0;
+        constexpr uint8_t RCODE_SERVFAIL = 2;
+        constexpr uint8_t RCODE_NXDOMAIN = 3;
+        constexpr uint8_t RCODE_REFUSED = 5;
+
+        constexpr uint16_t TYPE_SOA = 6;
+        constexpr uint16_t TYPE_OPT = 41;
+
+        constexpr uint8_t SECTION_ANSWER = 0;
+        constexpr uint8_t SECTION_AUTHORITY = 1;
+
+        inline uint16_t Get16(const uint8_t data[])
+        {
+            return (static_cast<uint16_t>((data[0] << 8) | data[1]));
+        }
+        inline uint32_t Get32(const uint8_t data[])
+        {
+            return ((static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) | (static_cast<uint32_t>(data[2]) << 8) | data[3]);
+        }
+        inline void Put16(uint8_t data[], const uint16_t value)
+        {
+            data[0] = static_cast<uint8_t>(value >> 8);
+            data[1] = static_cast<uint8_t>(value & 0xFF);
+        }
+        inline void Put32(uint8_t data[], const uint32_t value)
+        {
+            data[0] = static_cast<uint8_t>(value >> 24);
+            data[1] = static_cast<uint8_t>((value >> 16) & 0xFF);
+            data[2] = static_cast<uint8_t>((value >> 8) & 0xFF);
+            data[3] = static_cast<uint8_t>(value & 0xFF);
+        }
+        inline bool IsResponse(const uint8_t message[])
+        {
+            return ((message[2] & 0x80) != 0);
+        }
+        inline bool IsTruncated(const uint8_t message[])
+        {
+            return ((message[2] & 0x02) != 0);
+        }
+        inline uint8_t Opcode(const uint8_t message[])
+        {
+            return ((message[2] >> 3) & 0x0F);
+        }
+        inline uint8_t ResponseCode(const uint8_t message[])
+        {
+            return (message[3] & 0x0F);
+        }
+
+        // Move the offset past a (possibly compressed) domain name.
+        bool SkipName(const uint8_t message[], const uint16_t length, uint16_t& offset)
+        {
+            while (offset < length) {
+                const uint8_t label = message[offset];
+
+                if (label == 0) {
+                    offset += 1;
+                    return (true);
+                } else if ((label & 0xC0) == 0xC0) {
+                    offset += 2;
+                    return (offset <= length);
+                } else if ((label & 0xC0) != 0) {
+                    return (false);
+                }
+                offset += (label + 1);
+            }
+            return (false);
+        }
+
+        // The single question of a message, lowercased, is what identifies an answer in the cache.
+        bool Question(const uint8_t message[], const uint16_t length, string& key)
+        {
+            uint16_t offset = DNSStub::HeaderSize;
+            bool result = false;
+
+            if ((Get16(&message[4]) == 1) && (SkipName(message, length, offset) == true) && ((offset + 4) <= length)) {
+                key.assign(reinterpret_cast<const char*>(&message[DNSStub::HeaderSize]), (offset + 4) - DNSStub::HeaderSize);
+
+                // Label lengths are < 64, so they are never mistaken for an upper case character.
+                for (char& character : key) {
+                    if ((character >= 'A') && (character <= 'Z')) {
+                        character += ('a' - 'A');
+                    }
+                }
+                result = true;
+            }
+
+            return (result);
+        }
+
+        // Visit all resource records following the question section.
+        using Visitor = std::function<void(const uint8_t section, const uint16_t type, const uint16_t ttl, const uint16_t rdata, const uint16_t rdlength)>;
+
+        bool Walk(const uint8_t message[], const uint16_t length, const Visitor& visitor)
+        {
+            uint16_t offset = DNSStub::HeaderSize;
+            uint16_t questions = Get16(&message[4]);
+
+            while (questions-- != 0) {
+                if ((SkipName(message, length, offset) == false) || ((offset + 4) > length)) {
+                    return (false);
+                }
+                offset += 4;
+            }
+
+            for (uint8_t section = 0; section < 3; section++) {
+                uint16_t records = Get16(&message[6 + (section * 2)]);
+
+                while (records-- != 0) {
+                    if ((SkipName(message, length, offset) == false) || ((offset + 10) > length)) {
+                        return (false);
+                    }
+
+                    const uint16_t type = Get16(&message[offset]);
+                    const uint16_t rdlength = Get16(&message[offset + 8]);
+                    const uint16_t rdata = offset + 10;
+
+                    if ((rdata + rdlength) > length) {
+                        return (false);
+                    }
+
+                    visitor(section, type, offset + 4, rdata, rdlength);
+                    offset = rdata + rdlength;
+                }
+            }
+
+            return (true);
+        }
+
+        // How long an answer may be cached, 0 if it should not be cached at all.
+        uint32_t TimeToLive(const uint8_t message[], const uint16_t length)
+        {
+            const uint8_t code = ResponseCode(message);
+            const bool positive = ((code == RCODE_NOERROR) && (Get16(&message[6]) != 0));
+            uint32_t result = ~0;
+            bool found = false;
+
+            bool valid = Walk(message, length, [&](const uint8_t section, const uint16_t type, const uint16_t ttl, const uint16_t rdata, const uint16_t rdlength) {
+                if ((positive == true) && (section == SECTION_ANSWER)) {
+                    result = std::min(result, Get32(&message[ttl]));
+                    found = true;
+                } else if ((positive == false) && (section == SECTION_AUTHORITY) && (type == TYPE_SOA)) {
+                    // RFC 2308: the negative TTL is the lower of the SOA TTL and its MINIMUM field.
+                    uint16_t offset = rdata;
+
+                    if ((SkipName(message, length, offset) == true) && (SkipName(message, length, offset) == true) && ((offset + 20) <= (rdata + rdlength))) {
+                        result = std::min(result, std::min(Get32(&message[ttl]), Get32(&message[offset + 16])));
+                        found = true;
+                    }
+                }
+            });
+
+            return (((valid == true) && (found == true)) ? std::min(result, static_cast<uint32_t>(DNSStub::MaxTTL)) : 0);
+        }
+    }
+
+    DNSStub::DNSStub(const Core::NodeId& listen)
+        : _adminLock()
+        , _listen(listen)
+        , _listener(*this, listen, false)
+        , _upstreamIPv4(*this, Core::NodeId(_T("0.0.0.0"), 0, Core::NodeId::TYPE_IPV4), true)
+        , _upstreamIPv6(*this, Core::NodeId(_T("::"), 0, Core::NodeId::TYPE_IPV6), true)
+        , _servers()
+        , _cache()
+        , _pending()
+        , _streams()
+        , _random(std::random_device()())
+        , _hits(0)
+        , _misses(0)
+    {
+    }
+
+    DNSStub::~DNSStub()
+    {
+        Close();
+    }
+
+    uint32_t DNSStub::Open()
+    {
+        uint32_t result = _listener.Open(0);
+
+        if (result == Core::ERROR_NONE) {
+            // Upstream sockets get an ephemeral port, random by the kernel.
+            if (_upstreamIPv4.Open(0) != Core::ERROR_NONE) {
+                TRACE(Trace::Warning, (_T("DNS stub could not open an IPv4 upstream socket")));
+            }
+            if ((Core::NodeId::IsIPV6Enabled() == true) && (_upstreamIPv6.Open(0) != Core::ERROR_NONE)) {
+                TRACE(Trace::Warning, (_T("DNS stub could not open an IPv6 upstream socket")));
+            }
+            TRACE(Trace::Information, (_T("DNS stub listening on %s:%d"), _listen.HostAddress().c_str(), _listen.PortNumber()));
+        }
+
+        return (result);
+    }
+
+    void DNSStub::Close()
+    {
+        std::list<Core::ProxyType<Stream>> streams;
+
+        _listener.Close(Core::infinite);
+        _upstreamIPv4.Close(Core::infinite);
+        _upstreamIPv6.Close(Core::infinite);
+
+        _adminLock.Lock();
+        _pending.clear();
+        _cache.clear();
+        _streams.swap(streams);
+        _adminLock.Unlock();
+
+        // Closing waits for the socket thread, which might be waiting for the lock in Answer().
+        for (Core::ProxyType<Stream>& stream : streams) {
+            stream->Close(Core::infinite);
+        }
+    }
+
+    void DNSStub::Servers(const std::list<Core::NodeId>& servers)
+    {
+        std::list<Core::NodeId> upstream;
+
+        for (const Core::NodeId& server : servers) {
+            // Never forward to ourselves.
+            if (server.HostAddress() != _listen.HostAddress()) {
+                upstream.emplace_back(server.HostAddress().c_str(), (server.PortNumber() != 0 ? server.PortNumber() : DNSPort));
+            }
+        }
+
+        _adminLock.Lock();
+
+        // The resolv.conf is rewritten for every DNS refresh, only a different server list invalidates the answers.
+        if (upstream != _servers) {
+            TRACE(Trace::Information, (_T("DNS stub upstream servers changed, %d entries flushed"), static_cast<uint32_t>(_cache.size())));
+
+            _servers.swap(upstream);
+            _cache.clear();
+        }
+
+        _adminLock.Unlock();
+    }
+
+    void DNSStub::Flush()
+    {
+        _adminLock.Lock();
+
+        TRACE(Trace::Information, (_T("DNS stub cache flushed, %d entries, %d hits, %d misses"), static_cast<uint32_t>(_cache.size()), _hits, _misses));
+
+        _cache.clear();
+        _hits = 0;
+        _misses = 0;
+
+        _adminLock.Unlock();
+    }
+
+    void DNSStub::Reply(const Core::NodeId& client, const uint16_t id, string message)
+    {
+        Put16(reinterpret_cast<uint8_t*>(&message[0]), id);
+        _listener.Send(client, message);
+    }
+
+    void DNSStub::Query(const Core::NodeId& client, const uint8_t message[], const uint16_t length)
+    {
+        string key;
+
+        if ((length <= HeaderSize) || (IsResponse(message) == true) || (Opcode(message) != 0) || (Question(message, length, key) == false)) {
+            TRACE_L1("DNS stub dropped a malformed query from %s", client.HostAddress().c_str());
+            return;
+        }
+
+        const uint16_t id = Get16(message);
+        const uint64_t now = Core::Time::Now().Ticks();
+
+        _adminLock.Lock();
+
+        Purge(now);
+
+        std::map<string, Entry>::iterator cached(_cache.find(key));
+
+        if ((cached != _cache.end()) && (cached->second.Expires > now)) {
+            // Serve from the cache, with the TTLs aged by the time the answer was kept here.
+            const uint32_t age = static_cast<uint32_t>((now - cached->second.Stored) / Core::Time::MicroSecondsPerSecond);
+            string answer(cached->second.Message);
+            uint8_t* data = reinterpret_cast<uint8_t*>(&answer[0]);
+
+            Walk(data, static_cast<uint16_t>(answer.length()), [&](const uint8_t, const uint16_t type, const uint16_t ttl, const uint16_t, const uint16_t) {
+                if (type != TYPE_OPT) {
+                    const uint32_t value = Get32(&data[ttl]);
+                    Put32(&data[ttl], (value > age ? value - age : 0));
+                }
+            });
+
+            _hits++;
+            Reply(client, id, answer);
+        } else {
+            std::map<uint16_t, Pending>::iterator pending(_pending.begin());
+
+            if (cached != _cache.end()) {
+                _cache.erase(cached);
+            }
+
+            _misses++;
+
+            while ((pending != _pending.end()) && (pending->second.Key != key)) {
+                pending++;
+            }
+
+            if (pending != _pending.end()) {
+                // Already asked upstream, answer this one together with the others.
+                pending->second.Waiters.emplace_back(client, id);
+            } else if (_servers.empty() == true) {
+                // Nowhere to go, tell the client right away instead of letting it time out.
+                string answer(reinterpret_cast<const char*>(message), length);
+                answer[2] = static_cast<char>(answer[2] | 0x80);
+                answer[3] = static_cast<char>((answer[3] & 0x70) | 0x80 | RCODE_SERVFAIL);
+                Reply(client, id, answer);
+            } else {
+                uint16_t upstreamId;
+
+                // Random transaction ids, to make spoofed answers harder to get accepted.
+                do {
+                    upstreamId = static_cast<uint16_t>(_random() & 0xFFFF);
+                } while (_pending.find(upstreamId) != _pending.end());
+
+                Pending& entry(_pending[upstreamId]);
+                entry.Key = key;
+                entry.Request.assign(reinterpret_cast<const char*>(message), length);
+                entry.Waiters.emplace_back(client, id);
+                entry.Sent = now;
+                entry.Outstanding = static_cast<uint8_t>(std::min(_servers.size(), static_cast<size_t>(0xFF)));
+
+                Put16(reinterpret_cast<uint8_t*>(&entry.Request[0]), upstreamId);
+
+                // Ask everybody, the first useful answer wins.
+                for (const Core::NodeId& server : _servers) {
+                    if (server.Type() == Core::NodeId::TYPE_IPV6) {
+                        _upstreamIPv6.Send(server, entry.Request);
+                    } else {
+                        _upstreamIPv4.Send(server, entry.Request);
+                    }
+                }
+            }
+        }
+
+        _adminLock.Unlock();
+    }
+
+    void DNSStub::Answer(const Core::NodeId& server, const uint8_t message[], const uint16_t length)
+    {
+        string key;
+
+        if ((length <= HeaderSize) || (IsResponse(message) == false) || (Question(message, length, key) == false)) {
+            TRACE_L1("DNS stub dropped a malformed answer from %s", server.HostAddress().c_str());
+            return;
+        }
+
+        _adminLock.Lock();
+
+        std::map<uint16_t, Pending>::iterator pending(_pending.find(Get16(message)));
+
+        if ((pending != _pending.end()) && (pending->second.Key == key)) {
+            const uint8_t code = ResponseCode(message);
+
+            if (((code == RCODE_SERVFAIL) || (code == RCODE_REFUSED)) && (--(pending->second.Outstanding) != 0)) {
+                // Somebody else might still know, wait for the others.
+                TRACE_L1("DNS stub got error %d from %s, waiting for the others", code, server.HostAddress().c_str());
+            } else if (IsTruncated(message) == true) {
+                if (pending->second.Truncated.empty() == true) {
+                    // Our clients can not retry over TCP with us, so ask this server again over TCP ourselves.
+                    TRACE_L1("DNS stub got a truncated answer from %s, retrying over TCP", server.HostAddress().c_str());
+
+                    pending->second.Truncated.assign(reinterpret_cast<const char*>(message), length);
+
+                    Core::ProxyType<Stream> stream(Core::ProxyType<Stream>::Create(*this, server, pending->first, pending->second.Request));
+                    uint32_t status = stream->Open(0);
+
+                    if ((status == Core::ERROR_NONE) || (status == Core::ERROR_INPROGRESS)) {
+                        _streams.push_back(stream);
+                    } else {
+                        for (const std::pair<Core::NodeId, uint16_t>& waiter : pending->second.Waiters) {
+                            Reply(waiter.first, waiter.second, pending->second.Truncated);
+                        }
+                        _pending.erase(pending);
+                    }
+                }
+            } else {
+                // If the full answer does not fit a datagram, the truncated one is the best we can do.
+                const string answer((length <= MaxMessageSize) || (pending->second.Truncated.empty() == true) ? string(reinterpret_cast<const char*>(message), length) : pending->second.Truncated);
+
+                for (const std::pair<Core::NodeId, uint16_t>& waiter : pending->second.Waiters) {
+                    Reply(waiter.first, waiter.second, answer);
+                }
+
+                if ((length <= MaxMessageSize) && ((code == RCODE_NOERROR) || (code == RCODE_NXDOMAIN))) {
+                    Store(key, message, length);
+                }
+
+                _pending.erase(pending);
+            }
+        }
+
+        _adminLock.Unlock();
+    }
+
+    void DNSStub::Failed(const uint16_t id)
+    {
+        _adminLock.Lock();
+
+        std::map<uint16_t, Pending>::iterator pending(_pending.find(id));
+
+        if (pending != _pending.end()) {
+            // The TCP retry did not work out, the client gets what we had and can try another server.
+            TRACE_L1("DNS stub could not retry over TCP, passing on the truncated answer");
+
+            for (const std::pair<Core::NodeId, uint16_t>& waiter : pending->second.Waiters) {
+                Reply(waiter.first, waiter.second, pending->second.Truncated);
+            }
+
+            _pending.erase(pending);
+        }
+
+        _adminLock.Unlock();
+    }
+
+    void DNSStub::Store(const string& key, const uint8_t message[], const uint16_t length)
+    {
+        // runs always in the context of the adminlock
+
+        const uint32_t ttl = TimeToLive(message, length);
+
+        if (ttl != 0) {
+            const uint64_t now = Core::Time::Now().Ticks();
+
+            if (_cache.size() >= CacheSize) {
+                // Make room, first by dropping whatever expired, otherwise whatever expires first.
+                std::map<string, Entry>::iterator index(_cache.begin());
+
+                while (index != _cache.end()) {
+                    if (index->second.Expires <= now) {
+                        index = _cache.erase(index);
+                    } else {
+                        index++;
+                    }
+                }
+
+                if (_cache.size() >= CacheSize) {
+                    std::map<string, Entry>::iterator oldest(_cache.begin());
+
+                    for (index = _cache.begin(); index != _cache.end(); index++) {
+                        if (index->second.Expires < oldest->second.Expires) {
+                            oldest = index;
+                        }
+                    }
+
+                    _cache.erase(oldest);
+                }
+            }
+
+            Entry& entry(_cache[key]);
+            entry.Message.assign(reinterpret_cast<const char*>(message), length);
+            entry.Stored = now;
+            entry.Expires = now + (static_cast<uint64_t>(ttl) * Core::Time::MicroSecondsPerSecond);
+        }
+    }
+
+    void DNSStub::Purge(const uint64_t now)
+    {
+        // runs always in the context of the adminlock
+
+        std::map<uint16_t, Pending>::iterator index(_pending.begin());
+
+        while (index != _pending.end()) {
+            if ((now - index->second.Sent) > (static_cast<uint64_t>(QueryTimeOut) * Core::Time::MicroSecondsPerMilliSecond)) {
+                index = _pending.erase(index);
+            } else {
+                index++;
+            }
+        }
+
+        // TCP retries that are done can go, they closed themselves.
+        std::list<Core::ProxyType<Stream>>::iterator stream(_streams.begin());
+
+        while (stream != _streams.end()) {
+            if ((*stream)->IsClosed() == true) {
+                stream = _streams.erase(stream);
+            } else {
+                stream++;
+            }
+        }
+    }
+
+} // namespace Plugin
+} // namespace WPEFramework
@@ -0,0 +1,256 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DNSSTUB__H
+#define DNSSTUB__H
+
+#include "Module.h"
+
+#include <random>
+
+namespace WPEFramework {
+
+namespace Plugin {
+
+    // A caching DNS forwarder. It listens for UDP queries (typically on the loopback address that is
+    // written as the first nameserver in the resolv.conf), answers from its cache when it can and
+    // otherwise forwards the query to all upstream servers at once, the first usable answer wins.
+    // Positive answers are cached for their (lowest) TTL, negative answers (NXDOMAIN/NODATA) for the
+    // TTL derived from the SOA record in the authority section (RFC 2308).
+    // A truncated answer is not handed to the client, the stub has no TCP listener to retry on. The
+    // question is asked again over TCP to the server that truncated it (RFC 7766) and the full answer
+    // is sent back over UDP.
+    class DNSStub {
+    public:
+        static constexpr uint16_t HeaderSize = 12;
+        static constexpr uint16_t MaxMessageSize = 4096;
+        static constexpr uint16_t CacheSize = 512;
+        static constexpr uint32_t QueryTimeOut = 5000; // ms
+        static constexpr uint32_t MaxTTL = 24 * 60 * 60; // s
+
+    private:
+        class Channel : public Core::SocketDatagram {
+        public:
+            Channel() = delete;
+            Channel(const Channel&) = delete;
+            Channel& operator=(const Channel&) = delete;
+
+            Channel(DNSStub& parent, const Core::NodeId& local, const bool upstream)
+                : Core::SocketDatagram(false, local, Core::NodeId(), MaxMessageSize, MaxMessageSize)
+                , _parent(parent)
+                , _upstream(upstream)
+                , _lock()
+                , _queue()
+            {
+            }
+            ~Channel() override
+            {
+                Close(Core::infinite);
+            }
+
+        public:
+            void Send(const Core::NodeId& remote, const string& message)
+            {
+                _lock.Lock();
+                _queue.emplace_back(remote, message);
+                _lock.Unlock();
+
+                Trigger();
+            }
+
+        private:
+            uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) override
+            {
+                uint16_t result = 0;
+
+                _lock.Lock();
+
+                if (_queue.empty() == false) {
+                    const std::pair<Core::NodeId, string>& entry(_queue.front());
+
+                    if (entry.second.length() <= maxSendSize) {
+                        RemoteNode(entry.first);
+                        result = static_cast<uint16_t>(entry.second.length());
+                        ::memcpy(dataFrame, entry.second.c_str(), result);
+                    }
+
+                    _queue.pop_front();
+                }
+
+                _lock.Unlock();
+
+                return (result);
+            }
+            uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) override
+            {
+                if (_upstream == true) {
+                    _parent.Answer(ReceivedNode(), dataFrame, receivedSize);
+                } else {
+                    _parent.Query(ReceivedNode(), dataFrame, receivedSize);
+                }
+                return (receivedSize);
+            }
+            void StateChange() override
+            {
+            }
+
+        private:
+            DNSStub& _parent;
+            const bool _upstream;
+            Core::CriticalSection _lock;
+            std::list<std::pair<Core::NodeId, string>> _queue;
+        };
+
+        // One DNS over TCP exchange (RFC 1035, section 4.2.2), used when a UDP answer was truncated.
+        class Stream : public Core::SocketStream {
+        public:
+            Stream() = delete;
+            Stream(const Stream&) = delete;
+            Stream& operator=(const Stream&) = delete;
+
+            Stream(DNSStub& parent, const Core::NodeId& remote, const uint16_t id, const string& request)
+                : Core::SocketStream(false, remote.AnyInterface(), remote, MaxMessageSize, MaxMessageSize)
+                , _parent(parent)
+                , _id(id)
+                , _request()
+                , _response()
+                , _offset(0)
+                , _done(false)
+            {
+                // On TCP every message is preceded by its length.
+                _request.reserve(request.length() + 2);
+                _request += static_cast<char>(request.length() >> 8);
+                _request += static_cast<char>(request.length() & 0xFF);
+                _request += request;
+            }
+            ~Stream() override
+            {
+                Close(Core::infinite);
+            }
+
+        private:
+            uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) override
+            {
+                uint16_t result = static_cast<uint16_t>(std::min(_request.length() - _offset, static_cast<size_t>(maxSendSize)));
+
+                ::memcpy(dataFrame, &(_request[_offset]), result);
+                _offset += result;
+
+                return (result);
+            }
+            uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) override
+            {
+                _response.append(reinterpret_cast<const char*>(dataFrame), receivedSize);
+
+                if ((_done == false) && (_response.length() >= 2)) {
+                    const size_t length = (static_cast<uint8_t>(_response[0]) << 8) | static_cast<uint8_t>(_response[1]);
+
+                    if (_response.length() >= (length + 2)) {
+                        _done = true;
+                        _parent.Answer(RemoteNode(), reinterpret_cast<const uint8_t*>(&(_response[2])), static_cast<uint16_t>(length));
+                        Close(0);
+                    }
+                }
+
+                return (receivedSize);
+            }
+            void StateChange() override
+            {
+                if (IsOpen() == true) {
+                    Trigger();
+                } else if (_done == false) {
+                    _done = true;
+                    _parent.Failed(_id);
+                }
+            }
+
+        private:
+            DNSStub& _parent;
+            const uint16_t _id;
+            string _request;
+            string _response;
+            size_t _offset;
+            bool _done;
+        };
+
+        struct Entry {
+            string Message;
+            uint64_t Stored;
+            uint64_t Expires;
+        };
+
+        struct Pending {
+            string Key;
+            string Request;
+            string Truncated;
+            std::list<std::pair<Core::NodeId, uint16_t>> Waiters;
+            uint64_t Sent;
+            uint8_t Outstanding;
+        };
+
+    public:
+        DNSStub() = delete;
+        DNSStub(const DNSStub&) = delete;
+        DNSStub& operator=(const DNSStub&) = delete;
+
+        DNSStub(const Core::NodeId& listen);
+        ~DNSStub();
+
+    public:
+        uint32_t Open();
+        void Close();
+
+        const Core::NodeId& Listen() const
+        {
+            return (_listen);
+        }
+
+        // Upstream servers to forward to, the cache is flushed if they differ from the current ones.
+        void Servers(const std::list<Core::NodeId>& servers);
+
+        // Drop everything learned so far, e.g. after an interface change or a DHCP renewal.
+        void Flush();
+
+    private:
+        void Query(const Core::NodeId& client, const uint8_t message[], const uint16_t length);
+        void Answer(const Core::NodeId& server, const uint8_t message[], const uint16_t length);
+        void Failed(const uint16_t id);
+        void Reply(const Core::NodeId& client, const uint16_t id, string message);
+        void Store(const string& key, const uint8_t message[], const uint16_t length);
+        void Purge(const uint64_t now);
+
+    private:
+        Core::CriticalSection _adminLock;
+        Core::NodeId _listen;
+        Channel _listener;
+        Channel _upstreamIPv4;
+        Channel _upstreamIPv6;
+        std::list<Core::NodeId> _servers;
+        std::map<string, Entry> _cache;
+        std::map<uint16_t, Pending> _pending;
+        std::list<Core::ProxyType<Stream>> _streams;
+        std::mt19937 _random;
+        uint32_t _hits;
+        uint32_t _misses;
+    };
+
+} // namespace Plugin
+} // namespace WPEFramework
+
+#endif // DNSSTUB__H
@@ -86,6 +86,7 @@ namespace Plugin
         , _interfaces()
         , _dhcpInterfaces()
         , _observer(Core::ProxyType<AdapterObserver>::Create(this))
+        , _stub()
     {
         RegisterAll();
     }
@@ -211,6 +212,26 @@ namespace Plugin
             }
         }
 
+        if (config.Stub.Value().empty() == false) {
+            Core::NodeId listen(config.Stub.Value().c_str());
+
+            if ((listen.IsValid() == true) && (listen.PortNumber() == 0)) {
+                // Without a port the stub takes the DNS port, that is the only one the resolver talks to.
+                listen = Core::NodeId(listen.HostAddress().c_str(), 53);
+            }
+
+            if (listen.IsValid() == false) {
+                SYSLOG(Logging::Startup, (_T("DNS stub address [%s] is not valid"), config.Stub.Value().c_str()));
+            } else {
+                _stub = Core::ProxyType<DNSStub>::Create(listen);
+
+                if (_stub->Open() != Core::ERROR_NONE) {
+                    SYSLOG(Logging::Startup, (_T("Could not start the DNS stub on [%s]"), config.Stub.Value().c_str()));
+                    _stub.Release();
+                }
+            }
+        }
+
         // Update the DNS information, before we set the new IP, Do not know who triggers
         // the re-read of this file....
         RefreshDNS();
@@ -235,6 +256,11 @@ namespace Plugin
             index++;
         }
 
+        if (_stub.IsValid() == true) {
+            _stub->Close();
+            _stub.Release();
+        }
+
         _dns.clear();
         _dhcpInterfaces.clear();
         _interfaces.clear();
@@ -469,6 +495,18 @@ namespace Plugin
         }
     }
     
+    /* Removes the saved lease, e.g. after it was declined */
+    void NetworkControl::DHCPEngine::RemoveLeases()
+    {
+        if (_leaseFilePath.empty() == false) {
+            Core::File leaseFile(_leaseFilePath);
+
+            if ((leaseFile.Exists() == true) && (leaseFile.Destroy() == false)) {
+                TRACE(Trace::Warning, ("Failed to remove leases file %s", leaseFile.Name().c_str()));
+            }
+        }
+    }
+
     /*
         Loads list of previously saved offers and adds it to unleased list 
         for requesting in future.
@@ -707,6 +745,9 @@ namespace Plugin
 
                 if (update == true) {
                     RefreshDNS();
+                } else if (_stub.IsValid() == true) {
+                    // Same servers, but a renewed lease might come with a different view on the world.
+                    _stub->Flush();
                 }
 
                 SetIP(adapter, Core::IPNode(offer.Address(), offer.Netmask()), offer.Gateway(), offer.Broadcast(), true);
@@ -746,6 +787,18 @@ namespace Plugin
 
     }
 
+    void NetworkControl::AddressConflict(const string& interfaceName, const DHCPClientImplementation::Offer& offer)
+    {
+        SYSLOG(Logging::Notification, (_T("Address %s on interface %s is in use by another host, declined it"), offer.Address().HostAddress().c_str(), interfaceName.c_str()));
+
+        Core::AdapterIterator adapter(interfaceName);
+
+        if (adapter.IsValid() == true) {
+            // The DHCP client starts over on its own, after the mandatory back off.
+            adapter.Delete(Core::IPNode(offer.Address(), offer.Netmask()));
+        }
+    }
+
     void NetworkControl::NoOffers(const string& interfaceName)
     {
         _adminLock.Lock();
@@ -827,6 +880,25 @@ namespace Plugin
 
             std::list<std::pair<uint16_t, Core::NodeId>>::const_iterator pointer(_dns.begin());
 
+            if (_stub.IsValid() == true) {
+                std::list<Core::NodeId> servers;
+
+                while (pointer != _dns.end()) {
+                    servers.push_back(pointer->second);
+                    pointer++;
+                }
+
+                _stub->Servers(servers);
+
+                // The resolver only talks to port 53, if the stub runs elsewhere it is for explicit use only.
+                // The real servers stay listed after the stub, so the resolver can fall back on them.
+                if (_stub->Listen().PortNumber() == 53) {
+                    data += string(NAMESERVER, sizeof(NAMESERVER) - 1) + _stub->Listen().HostAddress() + '\n';
+                }
+
+                pointer = _dns.begin();
+            }
+
             while (pointer != _dns.end()) {
                 data += string(NAMESERVER, sizeof(NAMESERVER) - 1) + pointer->second.HostAddress() + '\n';
                 pointer++;
@@ -889,6 +961,11 @@ namespace Plugin
                 Core::AdapterIterator::Flush();
             }
 
+            if (_stub.IsValid() == true) {
+                // Whatever was resolved over the old setup might not be reachable anymore.
+                _stub->Flush();
+            }
+
             _adminLock.Unlock();
 
         } else {
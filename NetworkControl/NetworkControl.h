@@ -21,6 +21,7 @@
 #define PLUGIN_NETWORKCONTROL_H
 
 #include "DHCPClientImplementation.h"
+#include "DNSStub.h"
 #include "Module.h"
 
 #include <interfaces/IIPNetwork.h>
@@ -211,6 +212,7 @@ namespace Plugin {
                 , TimeOut(5)
                 , Retries(4)
                 , Open(true)
+                , Stub()
             {
                 Add(_T("dnsfile"), &DNSFile);
                 Add(_T("interfaces"), &Interfaces);
@@ -218,6 +220,7 @@ namespace Plugin {
                 Add(_T("retries"), &Retries);
                 Add(_T("open"), &Open);
                 Add(_T("dns"), &DNS);
+                Add(_T("dnsstub"), &Stub);
             }
             ~Config()
             {
@@ -230,6 +233,7 @@ namespace Plugin {
             Core::JSON::DecUInt8 TimeOut;
             Core::JSON::DecUInt8 Retries;
             Core::JSON::Boolean Open;
+            Core::JSON::String Stub;
         };
 
         class StaticInfo {
@@ -305,6 +309,10 @@ namespace Plugin {
         };
         class DHCPEngine : public Core::IDispatch {
         private:
+            // A previous lease is confirmed in a single shot, a server that does not know us stays
+            // silent (RFC 2131 section 4.3.2) and we rather start a fresh DISCOVER than keep waiting.
+            static constexpr uint8_t RebootRetries = 0;
+
             DHCPEngine() = delete;
             DHCPEngine(const DHCPEngine&) = delete;
             DHCPEngine& operator=(const DHCPEngine&) = delete;
@@ -318,7 +326,8 @@ namespace Plugin {
                 , _retries(0)
                 , _client(interfaceName, std::bind(&DHCPEngine::NewOffer, this, std::placeholders::_1), 
                           std::bind(&DHCPEngine::RequestResult, this, std::placeholders::_1, std::placeholders::_2),
-                          std::bind(&DHCPEngine::LeaseExpired, this, std::placeholders::_1))
+                          std::bind(&DHCPEngine::LeaseExpired, this, std::placeholders::_1),
+                          std::bind(&DHCPEngine::AddressConflict, this, std::placeholders::_1))
                 , _leaseFilePath((persistentStoragePath.empty()) ? "" :  (persistentStoragePath + _client.Interface() + ".json"))
             {
 
@@ -333,6 +342,7 @@ namespace Plugin {
             // Permanent IP storage
             void SaveLeases();
             bool LoadLeases();
+            void RemoveLeases();
 
             inline void MakeUnleased()
             {
@@ -417,8 +427,16 @@ namespace Plugin {
                 }
             }
 
+            void AddressConflict(const DHCPClientImplementation::Offer& offer) {
+                // Never offer the conflicting address again with an INIT-REBOOT after a restart.
+                RemoveLeases();
+
+                _parent.AddressConflict(_client.Interface(), offer);
+                _parent.event_connectionchange(_client.Interface().c_str(), offer.Address().HostAddress().c_str(), JsonData::NetworkControl::ConnectionchangeParamsData::StatusType::CONNECTIONFAILED);
+            }
+
             inline void Request(const DHCPClientImplementation::Offer& offer) {
-                SetupWatchdog();
+                SetupWatchdog(offer.Bound() == true ? RebootRetries : _parent.Retries());
                 _client.Request(offer);
             }
 
@@ -441,11 +459,16 @@ namespace Plugin {
                 _client.RemoveUnleasedOffer(offer);
             }
 
-            void SetupWatchdog() 
+            inline void SetupWatchdog()
+            {
+                SetupWatchdog(_parent.Retries());
+            }
+
+            void SetupWatchdog(const uint8_t retries) 
             {
                 const uint16_t responseMS = _parent.ResponseTime() * 1000;
                 Core::Time entry(Core::Time::Now().Add(responseMS));
-                _retries = _parent.Retries();
+                _retries = retries;
 
                 Core::ProxyType<Core::IDispatch> job(*this);    
 
@@ -544,6 +567,7 @@ namespace Plugin {
         bool NewOffer(const string& interfaceName, const DHCPClientImplementation::Offer& offer);
         void RequestAccepted(const string& interfaceName, const DHCPClientImplementation::Offer& offer);
         void RequestFailed(const string& interfaceName, const DHCPClientImplementation::Offer& offer);
+        void AddressConflict(const string& interfaceName, const DHCPClientImplementation::Offer& offer);
         void NoOffers(const string& interfaceName);
         void RefreshDNS();
         void Activity(const string& interface);
@@ -595,6 +619,7 @@ namespace Plugin {
         std::map<const string, StaticInfo> _interfaces;
         std::map<const string, Core::ProxyType<DHCPEngine>> _dhcpInterfaces;
         Core::ProxyType<AdapterObserver> _observer;
+        Core::ProxyType<DNSStub> _stub;
     };
 
 } // namespace Plugin
@@ -21,11 +21,17 @@
 
 #if defined (DO_NOT_USE_DEPRECATED_API)
 #include <opkg_cmd.h>
+#include <pkg_hash.h>
 #else
 #include <opkg.h>
 #endif
 #include <opkg_download.h>
 
+#include <sys/stat.h>
+#include <ctime>
+#include <map>
+#include <memory>
+
 
 namespace WPEFramework {
 namespace Plugin {
@@ -98,6 +104,8 @@ namespace Plugin {
              _volatileCache = config.MakeCacheVolatile.Value();
          }
 
+        _listsValidity = config.ListsValidity.Value();
+
         if (Core::File(_configFile).Exists() == false) {
             result = Core::ERROR_GENERAL;
         } else if (Core::Directory(_tempPath.c_str()).CreatePath() == false) {
@@ -126,9 +134,11 @@ namespace Plugin {
         _adminLock.Lock();
         notification->AddRef();
         _notifications.push_back(notification);
-        if (_inProgress.Install != nullptr) {
-            ASSERT(_inProgress.Package != nullptr);
-            notification->StateChange(_inProgress.Package, _inProgress.Install);
+        for (const InstallationData& installation : _batch) {
+            notification->StateChange(installation.Package, installation.Install);
+        }
+        for (const InstallationData& installation : _queue) {
+            notification->StateChange(installation.Package, installation.Install);
         }
         _adminLock.Unlock();
     }
@@ -159,28 +169,18 @@ namespace Plugin {
         uint32_t result = Core::ERROR_INPROGRESS;
 
         _adminLock.Lock();
-        if (_inProgress.Install == nullptr && _isSyncing == false) {
-            ASSERT(_inProgress.Package == nullptr);
-            result = Core::ERROR_NONE;
-            // OPKG bug: it marks it checked dependency for a package as cyclic dependency handling fix
-            // but since in our case it's not an process which dies when done, this info survives and makes the
-            // deps check to be skipped on subsequent calls. This is why hash_deinit() is called below
-            // and needs to be initialized here agian.
-            if (_opkgInitialized == true)  // it was initialized
-                FreeOPKG();
-            _opkgInitialized = InitOPKG();
-
-            if (_opkgInitialized) {
-                if (name && version && arch) {
-                    _inProgress.Package = Core::Service<PackageInfo>::Create<PackageInfo>(*name, *version, *arch);
-                    _inProgress.Install = Core::Service<InstallInfo>::Create<InstallInfo>();
-                } else {
-                    _isSyncing = true;
-                }
+        if (name && version && arch) {
+            // Installs are queued, whatever is queued by the time the feed is set up is installed as one transaction.
+            if (_queue.size() < MaxQueued) {
+                result = Core::ERROR_NONE;
+                _queue.emplace_back(Core::Service<PackageInfo>::Create<PackageInfo>(*name, *version, *arch),
+                                    Core::Service<InstallInfo>::Create<InstallInfo>());
                 _worker.Run();
-            } else {
-                result = Core::ERROR_GENERAL;
             }
+        } else if ((_isSyncing == false) && (_batch.empty() == true)) {
+            result = Core::ERROR_NONE;
+            _isSyncing = true;
+            _worker.Run();
         }
         _adminLock.Unlock();
 
@@ -188,56 +188,113 @@ namespace Plugin {
 
     }
 
+    bool PackagerImplementation::ReinitOPKG()
+    {
+        // OPKG bug: it marks it checked dependency for a package as cyclic dependency handling fix
+        // but since in our case it's not an process which dies when done, this info survives and makes the
+        // deps check to be skipped on subsequent calls. This is why hash_deinit() is called below
+        // and needs to be initialized here agian.
+        if (_opkgInitialized == true)  // it was initialized
+            FreeOPKG();
+        _opkgInitialized = InitOPKG();
+
+        return (_opkgInitialized);
+    }
+
+    void PackagerImplementation::FailQueued(const bool isSync)
+    {
+        _adminLock.Lock();
+        _batch.splice(_batch.end(), _queue);
+        _adminLock.Unlock();
+
+        for (const InstallationData& installation : _batch) {
+            installation.Install->SetError(Core::ERROR_GENERAL);
+            NotifyStateChange(installation);
+        }
+
+        _adminLock.Lock();
+        _batch.clear();
+        _adminLock.Unlock();
+
+        if (isSync == true) {
+            NotifyRepoSynced(Core::ERROR_GENERAL);
+        }
+    }
+
     void PackagerImplementation::BlockingInstallUntilCompletionNoLock() {
-        ASSERT(_inProgress.Install != nullptr && _inProgress.Package != nullptr);
+        ASSERT(_batch.empty() == false);
 
 #if defined (DO_NOT_USE_DEPRECATED_API)
+        // A single install command for the whole batch, so the dependencies are resolved once.
         opkg_cmd_t* command = opkg_cmd_find("install");
         if (command) {
-            _inProgress.Install->SetState(Exchange::IPackager::INSTALLING);
-            NotifyStateChange();
+            std::vector<std::unique_ptr<char[]>> targets;
+            std::vector<const char*> argv;
+            for (InstallationData& installation : _batch) {
+                const string name(installation.Package->Name());
+                std::unique_ptr<char[]> targetCopy(new char [name.length() + 1]);
+                std::copy_n(name.begin(), name.length(), targetCopy.get());
+                (targetCopy.get())[name.length()] = 0;
+                argv.push_back(targetCopy.get());
+                targets.push_back(std::move(targetCopy));
+
+                installation.Install->SetState(Exchange::IPackager::INSTALLING);
+                NotifyStateChange(installation);
+            }
             opkg_config->pfm = command->pfm;
-            std::unique_ptr<char[]> targetCopy(new char [_inProgress.Package->Name().length() + 1]);
-            std::copy_n(_inProgress.Package->Name().begin(), _inProgress.Package->Name().length(), targetCopy.get());
-            (targetCopy.get())[_inProgress.Package->Name().length()] = 0;
-            const char* argv[1];
-            argv[0] = targetCopy.get();
-            if (opkg_cmd_exec(command, 1, argv) == 0) {
-                _inProgress.Install->SetProgress(100);
-                _inProgress.Install->SetState(Exchange::IPackager::INSTALLED);
-            } else {
-                _inProgress.Install->SetError(Core::ERROR_GENERAL);
+            if (opkg_cmd_exec(command, static_cast<int>(argv.size()), argv.data()) != 0) {
+                // One bad package fails the whole transaction, give the others their own chance.
+                TRACE_L1("Batch install failed, retrying the %d packages one by one", static_cast<int>(argv.size()));
+                for (const char*& target : argv) {
+                    opkg_cmd_exec(command, 1, &target);
+                }
+            }
+            for (InstallationData& installation : _batch) {
+                const pkg_t* package = pkg_hash_fetch_installed_by_name(installation.Package->Name().c_str());
+                if ((package != nullptr) && (package->state_status == SS_INSTALLED)) {
+                    installation.Install->SetProgress(100);
+                    installation.Install->SetState(Exchange::IPackager::INSTALLED);
+                } else {
+                    installation.Install->SetError(Core::ERROR_GENERAL);
+                }
+                NotifyStateChange(installation);
             }
-            NotifyStateChange();
         } else {
-            _inProgress.Install->SetError(Core::ERROR_GENERAL);
-            NotifyStateChange();
+            for (InstallationData& installation : _batch) {
+                installation.Install->SetError(Core::ERROR_GENERAL);
+                NotifyStateChange(installation);
+            }
         }
 #else
-        _isUpgrade = false;
-        opkg_package_callback_t checkUpgrade = [](pkg* pkg, void* user_data) {
-            PackagerImplementation* self = static_cast<PackagerImplementation*>(user_data);
-            if (self->_isUpgrade == false) {
-                self->_isUpgrade = self->_inProgress.Package->Name() == pkg->name;
-                if (self->_isUpgrade && self->_inProgress.Package->Version().empty() == false) {
-                    self->_isUpgrade = opkg_compare_versions(pkg->version,
-                                                             self->_inProgress.Package->Version().c_str()) < 0;
-                }
-            }
+        // Ask OPKG once for the whole batch what it could upgrade.
+        std::map<string, string> upgradable;
+        opkg_package_callback_t collectUpgradable = [](pkg* pkg, void* user_data) {
+            static_cast<std::map<string, string>*>(user_data)->emplace(pkg->name, pkg->version);
         };
-        opkg_list_upgradable_packages(checkUpgrade, this);
+        opkg_list_upgradable_packages(collectUpgradable, &upgradable);
 
         typedef int (*InstallFunction)(const char *, opkg_progress_callback_t, void *);
-        InstallFunction installFunction = opkg_install_package;
-        if (_isUpgrade) {
-            installFunction = opkg_upgrade_package;
-        }
-        _isUpgrade = false;
 
-        if (installFunction(_inProgress.Package->Name().c_str(), PackagerImplementation::InstallationProgessNoLock,
-                            this) != 0) {
-            _inProgress.Install->SetError(Core::ERROR_GENERAL);
-            NotifyStateChange();
+        for (InstallationData& installation : _batch) {
+            const string name(installation.Package->Name());
+            const string version(installation.Package->Version());
+            std::map<string, string>::const_iterator found(upgradable.find(name));
+
+            bool isUpgrade = (found != upgradable.end());
+            if ((isUpgrade == true) && (version.empty() == false)) {
+                isUpgrade = opkg_compare_versions(found->second.c_str(), version.c_str()) < 0;
+            }
+
+            InstallFunction installFunction = (isUpgrade ? opkg_upgrade_package : opkg_install_package);
+
+            _adminLock.Lock();
+            _inProgress = &installation;
+            _adminLock.Unlock();
+
+            if (installFunction(name.c_str(), PackagerImplementation::InstallationProgessNoLock, this) != 0) {
+                installation.Install->SetError(Core::ERROR_GENERAL);
+                NotifyStateChange();
+            }
         }
 #endif
     }
@@ -247,23 +304,24 @@ namespace Plugin {
                                                                         void* data)
     {
         PackagerImplementation* self = static_cast<PackagerImplementation*>(data);
-        self->_inProgress.Install->SetProgress(progress->percentage);
+        InstallInfo* install = self->_inProgress->Install;
+        install->SetProgress(progress->percentage);
         if (progress->action == OPKG_INSTALL &&
-            self->_inProgress.Install->State() == Exchange::IPackager::DOWNLOADING) {
-            self->_inProgress.Install->SetState(Exchange::IPackager::DOWNLOADED);
+            install->State() == Exchange::IPackager::DOWNLOADING) {
+            install->SetState(Exchange::IPackager::DOWNLOADED);
             self->NotifyStateChange();
         }
         bool stateChanged = false;
         switch (progress->action) {
             case OPKG_DOWNLOAD:
-                if (self->_inProgress.Install->State() != Exchange::IPackager::DOWNLOADING) {
-                    self->_inProgress.Install->SetState(Exchange::IPackager::DOWNLOADING);
+                if (install->State() != Exchange::IPackager::DOWNLOADING) {
+                    install->SetState(Exchange::IPackager::DOWNLOADING);
                     stateChanged = true;
                 }
                 break;
             case OPKG_INSTALL:
-                if (self->_inProgress.Install->State() != Exchange::IPackager::INSTALLING) {
-                    self->_inProgress.Install->SetState(Exchange::IPackager::INSTALLING);
+                if (install->State() != Exchange::IPackager::INSTALLING) {
+                    install->SetState(Exchange::IPackager::INSTALLING);
                     stateChanged = true;
                 }
                 break;
@@ -272,18 +330,24 @@ namespace Plugin {
         if (stateChanged == true)
             self->NotifyStateChange();
         if (progress->percentage == 100) {
-            self->_inProgress.Install->SetState(Exchange::IPackager::INSTALLED);
+            install->SetState(Exchange::IPackager::INSTALLED);
             self->NotifyStateChange();
         }
     }
 #endif
 
     void PackagerImplementation::NotifyStateChange()
+    {
+        ASSERT(_inProgress != nullptr);
+        NotifyStateChange(*_inProgress);
+    }
+
+    void PackagerImplementation::NotifyStateChange(const InstallationData& installation)
     {
         _adminLock.Lock();
-        TRACE_L1("State for %s changed to %d (%d %%, %d)", _inProgress.Package->Name().c_str(), _inProgress.Install->State(), _inProgress.Install->Progress(), _inProgress.Install->ErrorCode());
+        TRACE_L1("State for %s changed to %d (%d %%, %d)", installation.Package->Name().c_str(), installation.Install->State(), installation.Install->Progress(), installation.Install->ErrorCode());
         for (auto* notification : _notifications) {
-            notification->StateChange(_inProgress.Package, _inProgress.Install);
+            notification->StateChange(installation.Package, installation.Install);
         }
         _adminLock.Unlock();
     }
@@ -317,18 +381,39 @@ namespace Plugin {
         }
     }
 
-    void PackagerImplementation::BlockingSetupLocalRepoNoLock(RepoSyncMode mode)
+    bool PackagerImplementation::ListsUpToDate() const
     {
+        // The feed index is reused as long as the newest list is younger than the configured validity. Without
+        // one, lists that are there are good enough unless asked to always update first.
         string dirPath = Core::ToString(opkg_config->lists_dir);
         Core::Directory dir(dirPath.c_str());
-        bool containFiles = false;
-        if (mode == RepoSyncMode::SETUP && _alwaysUpdateFirst == false) {
+        bool upToDate = false;
+        time_t newest = 0;
+
+        if ((_alwaysUpdateFirst == false) || (_listsValidity > 0)) {
             while (dir.Next() == true) {
                 if (dir.Name() != _T(".") && dir.Name() != _T("..") && dir.Name() != dirPath) {
-                    containFiles = true;
-                    break;
+                    struct stat info;
+                    if ((::stat(dir.Current().c_str(), &info) == 0) && (info.st_mtime > newest)) {
+                        newest = info.st_mtime;
+                    }
+                    upToDate = true;
                 }
             }
+
+            if ((upToDate == true) && (_listsValidity > 0)) {
+                upToDate = (static_cast<uint64_t>(::time(nullptr) - newest) < _listsValidity);
+            }
+        }
+
+        return (upToDate);
+    }
+
+    void PackagerImplementation::BlockingSetupLocalRepoNoLock(RepoSyncMode mode)
+    {
+        bool containFiles = false;
+        if (mode == RepoSyncMode::SETUP) {
+            containFiles = ListsUpToDate();
         }
         ASSERT(mode == RepoSyncMode::SETUP || _isSyncing == true);
         if (containFiles == false) {
@@ -345,7 +430,10 @@ namespace Plugin {
                 TRACE_L1("Failed to set up local repo. Installing might not work");
                 result = Core::ERROR_GENERAL;
             }
-            NotifyRepoSynced(result);
+            // Only a forced sync was requested by a client, the implicit setup before an install reports nothing.
+            if (mode == RepoSyncMode::FORCED) {
+                NotifyRepoSynced(result);
+            }
         }
     }
 
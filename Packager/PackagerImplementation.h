@@ -48,6 +48,7 @@ namespace Plugin {
                 , NoDeps()
                 , NoSignatureCheck()
                 , AlwaysUpdateFirst()
+                , ListsValidity(0)
             {
                 Add(_T("config"), &ConfigFile);
                 Add(_T("temppath"), &TempDir);
@@ -57,6 +58,7 @@ namespace Plugin {
                 Add(_T("nodeps"), &NoDeps);
                 Add(_T("nosignaturecheck"), &NoSignatureCheck);
                 Add(_T("alwaysupdatefirst"), &AlwaysUpdateFirst);
+                Add(_T("listsvalidity"), &ListsValidity);
             }
 
             ~Config() override
@@ -74,6 +76,7 @@ namespace Plugin {
             Core::JSON::Boolean NoDeps;
             Core::JSON::Boolean NoSignatureCheck;
             Core::JSON::Boolean AlwaysUpdateFirst;
+            Core::JSON::DecUInt32 ListsValidity; // Seconds a synchronized feed index is reused before an install syncs again
         };
 
         PackagerImplementation()
@@ -86,9 +89,12 @@ namespace Plugin {
             , _skipSignatureChecking(false)
             , _alwaysUpdateFirst(false)
             , _volatileCache(false)
+            , _listsValidity(0)
             , _opkgInitialized(false)
+            , _queue()
+            , _batch()
+            , _inProgress(nullptr)
             , _worker(this)
-            , _isUpgrade(false)
             , _isSyncing(false)
         {
         }
@@ -215,6 +221,11 @@ namespace Plugin {
             InstallationData(const InstallationData& other) = delete;
             InstallationData& operator=(const InstallationData& other) = delete;
             InstallationData() = default;
+            InstallationData(PackageInfo* package, InstallInfo* install)
+                : Package(package)
+                , Install(install)
+            {
+            }
 
             ~InstallationData()
             {
@@ -227,6 +238,8 @@ namespace Plugin {
             InstallInfo* Install = nullptr;
         };
 
+        using Installations = std::list<InstallationData>;
+
         class InstallThread : public Core::Thread {
         public:
             InstallThread(PackagerImplementation* parent)
@@ -239,26 +252,41 @@ namespace Plugin {
             uint32_t Worker() override {
                 while(IsRunning() == true) {
                     _parent->_adminLock.Lock(); // The parent may have lock when this starts so wait for it to release.
-                    bool isInstall = _parent->_inProgress.Install != nullptr;
-                    ASSERT(isInstall != true || _parent->_inProgress.Package != nullptr);
+                    bool isSync = _parent->_isSyncing;
+                    bool isInstall = (_parent->_queue.empty() == false);
                     _parent->_adminLock.Unlock();
 
-                    // After this point locking is not needed because API running on other threads only read if in
-                    // progress is filled in.
-                    _parent->BlockingSetupLocalRepoNoLock(isInstall == true ? RepoSyncMode::SETUP : RepoSyncMode::FORCED);
-                    if (isInstall)
-                        _parent->BlockingInstallUntilCompletionNoLock();
-
-                    if (isInstall) {
-                        _parent->_adminLock.Lock();
-                        _parent->_inProgress.Install->Release();
-                        _parent->_inProgress.Package->Release();
-                        _parent->_inProgress.Install = nullptr;
-                        _parent->_inProgress.Package = nullptr;
-                        _parent->_adminLock.Unlock();
+                    // Only this thread touches OPKG. The installations are moved from the queue into the batch
+                    // under the lock, after that the batch is only read by other threads.
+                    if (_parent->ReinitOPKG() == false) {
+                        _parent->FailQueued(isSync);
+                    } else {
+                        if (isSync == true) {
+                            _parent->BlockingSetupLocalRepoNoLock(RepoSyncMode::FORCED);
+                        }
+                        if (isInstall == true) {
+                            _parent->BlockingSetupLocalRepoNoLock(RepoSyncMode::SETUP);
+
+                            // Everything queued while the feed was being set up goes into the same transaction.
+                            _parent->_adminLock.Lock();
+                            _parent->_batch.splice(_parent->_batch.end(), _parent->_queue);
+                            _parent->_adminLock.Unlock();
+
+                            _parent->BlockingInstallUntilCompletionNoLock();
+
+                            _parent->_adminLock.Lock();
+                            _parent->_inProgress = nullptr;
+                            _parent->_batch.clear();
+                            _parent->_adminLock.Unlock();
+                        }
                     }
 
-                    Block();
+                    _parent->_adminLock.Lock();
+                    if ((_parent->_queue.empty() == true) && (_parent->_isSyncing == false)) {
+                        // Under the lock, so a request coming in now can not get lost in between.
+                        Block();
+                    }
+                    _parent->_adminLock.Unlock();
                 }
 
                 return Core::infinite;
@@ -268,6 +296,8 @@ namespace Plugin {
             PackagerImplementation* _parent;
         };
 
+        static constexpr uint8_t MaxQueued = 32;
+
         enum class RepoSyncMode {
             FORCED,
             SETUP
@@ -279,9 +309,13 @@ namespace Plugin {
         static void InstallationProgessNoLock(const _opkg_progress_data_t* progress, void* data);
 #endif
         void NotifyStateChange();
+        void NotifyStateChange(const InstallationData& installation);
         void NotifyRepoSynced(uint32_t status);
         void BlockingInstallUntilCompletionNoLock();
         void BlockingSetupLocalRepoNoLock(RepoSyncMode mode);
+        bool ListsUpToDate() const;
+        void FailQueued(const bool isSync);
+        bool ReinitOPKG();
         bool InitOPKG();
         void FreeOPKG();
 
@@ -294,11 +328,13 @@ namespace Plugin {
         bool _skipSignatureChecking;
         bool _alwaysUpdateFirst;
         bool _volatileCache;
+        uint32_t _listsValidity;
         bool _opkgInitialized;
         std::vector<Exchange::IPackager::INotification*> _notifications;
-        InstallationData _inProgress;
+        Installations _queue;
+        Installations _batch;
+        InstallationData* _inProgress;
         InstallThread _worker;
-        bool _isUpgrade;
         bool _isSyncing;
     };
 
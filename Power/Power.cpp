@@ -197,17 +197,8 @@ namespace Plugin {
             result = Core::ERROR_DUPLICATE_KEY;
             TRACE(Trace::Information, (_T("No need to change power states, we are already at this stage!")));
         } else if (is_power_state_supported(state)) {
-            _adminLock.Unlock();
+            Notify(state);
 
-            std::list<Exchange::IPower::INotification*>::iterator index(_notificationClients.begin());
-
-            while (index != _notificationClients.end()) {
-                (*index)->StateChange(state);
-                index++;
-            }
-
-            _adminLock.Unlock();
- 
             if (state != Exchange::IPower::PCState::On) {
                 ControlClients(state);
             }
@@ -228,16 +219,7 @@ namespace Plugin {
             ControlClients(state);
         }
 
-        _adminLock.Lock();
-
-        std::list<Exchange::IPower::INotification*>::iterator index(_notificationClients.begin());
-
-        while (index != _notificationClients.end()) {
-            (*index)->StateChange(state);
-            index++;
-        }
-
-        _adminLock.Unlock();
+        Notify(state);
 
         /* May be resuming from another power state; lets update persisted state. */
         power_set_persisted_state(state);
@@ -251,6 +233,26 @@ namespace Plugin {
             SetState(Exchange::IPower::PCState::On, 0);
         }
     }
+    void Power::Notify(const Exchange::IPower::PCState state)
+    {
+        // Delivered synchronously, the sinks must have heard about a transition before the box
+        // suspends. They are called without the lock, so a sink may unregister from its callback.
+        std::list<Exchange::IPower::INotification*> sinks;
+
+        _adminLock.Lock();
+
+        for (Exchange::IPower::INotification* sink : _notificationClients) {
+            sink->AddRef();
+            sinks.push_back(sink);
+        }
+
+        _adminLock.Unlock();
+
+        for (Exchange::IPower::INotification* sink : sinks) {
+            sink->StateChange(state);
+            sink->Release();
+        }
+    }
     void Power::KeyEvent(const uint32_t keyCode)
     {
         // We only subscribed for the KEY_POWER event so do not
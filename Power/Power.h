@@ -245,6 +245,7 @@ namespace Plugin {
 
     private:
         void KeyEvent(const uint32_t keyCode);
+        void Notify(const Exchange::IPower::PCState state);
         void StateChange(PluginHost::IShell* plugin);
         void ControlClients(Exchange::IPower::PCState state);
 
@@ -41,8 +41,7 @@ void ProcessMonitor::Deinitialize(PluginHost::IShell* service)
 
 string ProcessMonitor::Information() const
 {
-    string emptyString;
-    return emptyString;
+    return (_notification.Information());
 }
 }
 }
@@ -25,6 +25,8 @@
 #include <string>
 #include <syslog.h>
 #include <unordered_map>
+#include <sys/epoll.h>
+#include <sys/syscall.h>
 
 namespace WPEFramework {
 namespace Plugin {
@@ -55,7 +57,8 @@ public:
     };
 
     class Notification: public PluginHost::IPlugin::INotification,
-            public RPC::IRemoteConnection::INotification
+            public RPC::IRemoteConnection::INotification,
+            public Core::IResource
     {
     public:
         Notification() = delete;
@@ -73,41 +76,153 @@ public:
 
         public:
             ProcessObject(
-                const uint32_t processId)
+                const uint32_t processId, const int descriptor)
                 : _processId(processId)
+                , _descriptor(descriptor)
                 , _exitTime(0)
+                , _deactivated(0)
             {
                 ASSERT(_processId != 0);
             }
             ~ProcessObject()
             {
             }
-            uint32_t ProcessId()
+            uint32_t ProcessId() const
             {
                 return _processId;
             }
-            void SetExitTime(const uint64_t exitTime)
+            int Descriptor() const
             {
+                return _descriptor;
+            }
+            void SetExitTime(const uint64_t deactivated, const uint64_t exitTime)
+            {
+                _deactivated = deactivated;
                 _exitTime = exitTime;
             }
-            uint64_t ExitTime()
+            uint64_t ExitTime() const
             {
                 return _exitTime;
             }
+            uint64_t Deactivated() const
+            {
+                return _deactivated;
+            }
 
         private:
-            const uint32_t _processId;
+            uint32_t _processId;
+            int _descriptor; // pidfd, -1 if the kernel does not support it
             uint64_t _exitTime;
+            uint64_t _deactivated;
+        };
+
+        // Time it took processes of a callsign to go after the plugin was deactivated.
+        class Statistics
+        {
+        public:
+            Statistics()
+                : Exits(0)
+                , Kills(0)
+                , Last(0)
+                , Max(0)
+                , Total(0)
+            {
+            }
+
+            void Exited(const uint64_t duration)
+            {
+                const uint32_t ms = static_cast<uint32_t>(duration / Core::Time::TicksPerMillisecond);
+
+                Exits++;
+                Last = ms;
+                Total += ms;
+                if (ms > Max) {
+                    Max = ms;
+                }
+            }
+
+        public:
+            uint32_t Exits;
+            uint32_t Kills;
+            uint32_t Last; // ms
+            uint32_t Max; // ms
+            uint64_t Total; // ms
+        };
+
+        class Metrics : public Core::JSON::Container
+        {
+        public:
+            class Entry : public Core::JSON::Container
+            {
+            public:
+                Entry()
+                    : Core::JSON::Container()
+                {
+                    Init();
+                }
+                Entry(const Entry& copy)
+                    : Core::JSON::Container()
+                    , Callsign(copy.Callsign)
+                    , Exits(copy.Exits)
+                    , Kills(copy.Kills)
+                    , Last(copy.Last)
+                    , Max(copy.Max)
+                    , Average(copy.Average)
+                {
+                    Init();
+                }
+                Entry& operator=(const Entry&) = delete;
+                ~Entry() override
+                {
+                }
+
+            private:
+                void Init()
+                {
+                    Add(_T("callsign"), &Callsign);
+                    Add(_T("exits"), &Exits);
+                    Add(_T("kills"), &Kills);
+                    Add(_T("last"), &Last);
+                    Add(_T("max"), &Max);
+                    Add(_T("average"), &Average);
+                }
+
+            public:
+                Core::JSON::String Callsign;
+                Core::JSON::DecUInt32 Exits;
+                Core::JSON::DecUInt32 Kills;
+                Core::JSON::DecUInt32 Last;
+                Core::JSON::DecUInt32 Max;
+                Core::JSON::DecUInt32 Average;
+            };
+
+        public:
+            Metrics(const Metrics&) = delete;
+            Metrics& operator=(const Metrics&) = delete;
+
+            Metrics()
+                : Core::JSON::Container()
+            {
+                Add(_T("exittimes"), &ExitTimes);
+            }
+            ~Metrics() override
+            {
+            }
+
+        public:
+            Core::JSON::ArrayType<Entry> ExitTimes;
         };
 
     public:
         Notification(ProcessMonitor* parent)
             : _adminLock()
             , _processMap()
+            , _statistics()
             , _job(*this)
             , _service(nullptr)
             , _parent(*parent)
-            ,_exittimeout(10000000)
+            , _exittimeout(10000000)
+            , _epoll(-1)
         {
             ASSERT(parent != nullptr);
         }
@@ -123,6 +238,14 @@ public:
             
             _exittimeout = exittimeout * 1000 * 1000; // microseconds
 
+            _epoll = ::epoll_create1(EPOLL_CLOEXEC);
+
+            if (_epoll != -1) {
+                Core::ResourceMonitor::Instance().Register(*this);
+            } else {
+                TRACE(Trace::Error, (_T("No epoll available, exits are only detected on the exit timeout")));
+            }
+
             _service = service;
             _service->AddRef();
 
@@ -143,7 +266,26 @@ public:
 
             _job.Revoke();
 
+            if (_epoll != -1) {
+                Core::ResourceMonitor::Instance().Unregister(*this);
+            }
+
+            _adminLock.Lock();
+
+            for (std::pair<const string, ProcessObject>& entry : _processMap) {
+                if (entry.second.Descriptor() != -1) {
+                    ::close(entry.second.Descriptor());
+                }
+            }
             _processMap.clear();
+            _statistics.clear();
+
+            if (_epoll != -1) {
+                ::close(_epoll);
+                _epoll = -1;
+            }
+
+            _adminLock.Unlock();
         }
         void StateChange(PluginHost::IShell* service) override
         {
@@ -157,8 +299,9 @@ public:
                 std::unordered_map<string, ProcessObject>::iterator itr(
                         _processMap.find(service->Callsign()));
                 if (itr != _processMap.end()) {
-                    exitTime = Core::Time::Now().Ticks() + _exittimeout;
-                    itr->second.SetExitTime(exitTime);
+                    uint64_t now = Core::Time::Now().Ticks();
+                    exitTime = now + _exittimeout;
+                    itr->second.SetExitTime(now, exitTime);
                 }
 
                 if (exitTime != 0) {
@@ -170,9 +313,15 @@ public:
         }
         void AddProcess(const string callsign, const uint32_t processId)
         {
+            int descriptor = Watch(processId);
+
             _adminLock.Lock();
 
-            _processMap.emplace(callsign, ProcessObject(processId));
+            auto result = _processMap.emplace(callsign, ProcessObject(processId, descriptor));
+
+            if ((result.second == false) && (descriptor != -1)) {
+                ::close(descriptor);
+            }
 
             _adminLock.Unlock();
         }
@@ -189,11 +338,13 @@ public:
                 if ((exitTime != 0) && (exitTime <= currTime)) {
                     Core::Process proc(itr->second.ProcessId());
                     if (proc.IsActive()) {
-                        proc.Kill(true);
+                        Kill(itr->second.ProcessId());
+                        _statistics[itr->first].Kills++;
                         SYSLOG(Logging::Notification,
                                 (_T("ProcessMonitor killed: [%s]!"),
                                         itr->first.c_str()));
                     }
+                    Forget(itr->second);
                     itr = _processMap.erase(itr);
                 }
                 else {
@@ -234,6 +385,47 @@ public:
         }
         void Deactivated(RPC::IRemoteConnection* connection) override
         {
+            if (_epoll == -1) {
+                // Without exit notifications, at least drop the ones that are already gone.
+                _adminLock.Lock();
+
+                auto itr = _processMap.begin();
+                while (itr != _processMap.end()) {
+                    if ((itr->second.ProcessId() == connection->RemoteId()) && (Core::Process(itr->second.ProcessId()).IsActive() == false)) {
+                        if (itr->second.ExitTime() != 0) {
+                            _statistics[itr->first].Exited(Core::Time::Now().Ticks() - itr->second.Deactivated());
+                        }
+                        itr = _processMap.erase(itr);
+                    } else {
+                        itr++;
+                    }
+                }
+
+                _adminLock.Unlock();
+            }
+        }
+        string Information() const
+        {
+            Metrics metrics;
+            string result;
+
+            _adminLock.Lock();
+
+            for (const std::pair<const string, Statistics>& entry : _statistics) {
+                Metrics::Entry& element(metrics.ExitTimes.Add());
+                element.Callsign = entry.first;
+                element.Exits = entry.second.Exits;
+                element.Kills = entry.second.Kills;
+                element.Last = entry.second.Last;
+                element.Max = entry.second.Max;
+                element.Average = (entry.second.Exits > 0 ? static_cast<uint32_t>(entry.second.Total / entry.second.Exits) : 0);
+            }
+
+            _adminLock.Unlock();
+
+            metrics.ToString(result);
+
+            return (result);
         }
 
         BEGIN_INTERFACE_MAP(Notification)
@@ -242,12 +434,102 @@ public:
         END_INTERFACE_MAP
 
     private:
-        Core::CriticalSection _adminLock;
+        // Core::IResource, the epoll descriptor becomes readable once any of the pidfds signals an exit.
+        Core::IResource::handle Descriptor() const override
+        {
+            return (_epoll);
+        }
+        uint16_t Events() override
+        {
+            return (POLLIN);
+        }
+        void Handle(const uint16_t events) override
+        {
+            if ((events & POLLIN) != 0) {
+                struct epoll_event exited[8];
+                int count = ::epoll_wait(_epoll, exited, sizeof(exited) / sizeof(exited[0]), 0);
+                uint64_t now = Core::Time::Now().Ticks();
+
+                _adminLock.Lock();
+
+                for (int index = 0; index < count; index++) {
+                    auto itr = _processMap.begin();
+                    while ((itr != _processMap.end()) && (itr->second.ProcessId() != exited[index].data.u32)) {
+                        itr++;
+                    }
+
+                    if (itr != _processMap.end()) {
+                        if (itr->second.ExitTime() != 0) {
+                            _statistics[itr->first].Exited(now - itr->second.Deactivated());
+                        }
+                        // A pending exit deadline, if any, goes with it. The scheduled job finds nothing
+                        // to do, it is not revoked here as that would have to happen under the lock it takes.
+                        Forget(itr->second);
+                        _processMap.erase(itr);
+                    }
+                }
+
+                _adminLock.Unlock();
+            }
+        }
+        int Watch(const uint32_t processId)
+        {
+            int descriptor = -1;
+
+#ifdef __NR_pidfd_open
+            if (_epoll != -1) {
+                descriptor = static_cast<int>(::syscall(__NR_pidfd_open, static_cast<pid_t>(processId), 0));
+
+                if (descriptor != -1) {
+                    struct epoll_event event;
+                    event.events = EPOLLIN;
+                    event.data.u64 = 0;
+                    event.data.u32 = processId;
+
+                    if (::epoll_ctl(_epoll, EPOLL_CTL_ADD, descriptor, &event) != 0) {
+                        ::close(descriptor);
+                        descriptor = -1;
+                    }
+                }
+            }
+#endif
+            return (descriptor);
+        }
+        void Forget(const ProcessObject& process)
+        {
+            if (process.Descriptor() != -1) {
+                ::epoll_ctl(_epoll, EPOLL_CTL_DEL, process.Descriptor(), nullptr);
+                ::close(process.Descriptor());
+            }
+        }
+        void Kill(const uint32_t processId)
+        {
+            // Take the whole tree, helpers spawned by the process would otherwise survive it.
+            Core::ProcessTree tree(processId);
+            std::list<::ThreadId> processes;
+            tree.GetProcessIds(processes);
+
+            // Descendants first, so nothing gets reparented before it is found.
+            for (const ::ThreadId id : processes) {
+                if (static_cast<uint32_t>(id) != processId) {
+                    Core::Process child(static_cast<uint32_t>(id));
+                    child.Kill(true);
+                }
+            }
+
+            Core::Process proc(processId);
+            proc.Kill(true);
+        }
+
+    private:
+        mutable Core::CriticalSection _adminLock;
         std::unordered_map<string, ProcessObject> _processMap;
+        std::map<string, Statistics> _statistics;
         Job  _job;
         PluginHost::IShell* _service;
         ProcessMonitor& _parent;
         uint32_t _exittimeout;
+        int _epoll;
     };
 
 public:
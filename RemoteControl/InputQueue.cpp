@@ -0,0 +1,362 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "InputQueue.h"
+
+#include <thread>
+
+namespace WPEFramework {
+namespace Remotes {
+
+    uint32_t InputQueue::Channel::KeyEvent(const bool pressed, const uint32_t code, const string& mapName)
+    {
+        Event event;
+        event.Type = Event::KEY;
+        event.Pressed = pressed;
+        event.Code = code;
+        event.Map = mapName;
+        return (Post(event));
+    }
+
+    void InputQueue::Channel::ProducerEvent(const string& producerName, const Exchange::ProducerEvents event)
+    {
+        // Not on the key path, passed on as is.
+        _parent._adminLock.Lock();
+        if (_parent._keyHandler != nullptr) {
+            _parent._keyHandler->ProducerEvent(producerName, event);
+        }
+        _parent._adminLock.Unlock();
+    }
+
+    Exchange::IKeyProducer* InputQueue::Channel::Producer(const string& name)
+    {
+        Exchange::IKeyProducer* result = nullptr;
+        _parent._adminLock.Lock();
+        if (_parent._keyHandler != nullptr) {
+            result = _parent._keyHandler->Producer(name);
+        }
+        _parent._adminLock.Unlock();
+        return (result);
+    }
+
+    uint32_t InputQueue::Channel::AxisEvent(const int16_t x, const int16_t y)
+    {
+        Event event;
+        event.Type = Event::AXIS;
+        event.X = x;
+        event.Y = y;
+        return (Post(event));
+    }
+
+    Exchange::IWheelProducer* InputQueue::Channel::WheelProducer(const string& name)
+    {
+        Exchange::IWheelProducer* result = nullptr;
+        _parent._adminLock.Lock();
+        if (_parent._wheelHandler != nullptr) {
+            result = _parent._wheelHandler->WheelProducer(name);
+        }
+        _parent._adminLock.Unlock();
+        return (result);
+    }
+
+    uint32_t InputQueue::Channel::PointerButtonEvent(const bool pressed, const uint8_t button)
+    {
+        Event event;
+        event.Type = Event::POINTER_BUTTON;
+        event.Pressed = pressed;
+        event.Index = button;
+        return (Post(event));
+    }
+
+    uint32_t InputQueue::Channel::PointerMotionEvent(const int16_t x, const int16_t y)
+    {
+        Event event;
+        event.Type = Event::POINTER_MOTION;
+        event.X = x;
+        event.Y = y;
+        return (Post(event));
+    }
+
+    Exchange::IPointerProducer* InputQueue::Channel::PointerProducer(const string& name)
+    {
+        Exchange::IPointerProducer* result = nullptr;
+        _parent._adminLock.Lock();
+        if (_parent._pointerHandler != nullptr) {
+            result = _parent._pointerHandler->PointerProducer(name);
+        }
+        _parent._adminLock.Unlock();
+        return (result);
+    }
+
+    uint32_t InputQueue::Channel::TouchEvent(const uint8_t index, const Exchange::ITouchHandler::touchstate state, const uint16_t x, const uint16_t y)
+    {
+        Event event;
+        event.Type = Event::TOUCH;
+        event.Index = index;
+        event.State = static_cast<uint8_t>(state);
+        event.X = x;
+        event.Y = y;
+        return (Post(event));
+    }
+
+    Exchange::ITouchProducer* InputQueue::Channel::TouchProducer(const string& name)
+    {
+        Exchange::ITouchProducer* result = nullptr;
+        _parent._adminLock.Lock();
+        if (_parent._touchHandler != nullptr) {
+            result = _parent._touchHandler->TouchProducer(name);
+        }
+        _parent._adminLock.Unlock();
+        return (result);
+    }
+
+    uint32_t InputQueue::Channel::Post(Event& event)
+    {
+        uint32_t result = Core::ERROR_NONE;
+        uint16_t attempts = PushAttempts;
+
+        event.Time = Core::Time::Now().Ticks();
+
+        // A full ring means the delivery is lagging, give it a chance to catch up rather than losing
+        // a release (and have the key repeat forever).
+        while ((_ring.Push(event) == false) && (--attempts != 0)) {
+            _parent.Signal();
+            std::this_thread::yield();
+        }
+
+        if (attempts == 0) {
+            _dropped++;
+            TRACE(Trace::Error, (_T("Input queue is full, dropped an event of type %d (%u dropped so far)"), event.Type, _dropped));
+            result = Core::ERROR_UNAVAILABLE;
+        } else {
+            _parent.Signal();
+        }
+
+        return (result);
+    }
+
+    InputQueue::InputQueue()
+        : Core::Thread(Core::Thread::DefaultStackSize(), _T("InputQueue"))
+        , _adminLock()
+        , _signal(false, true)
+        , _channels(std::make_shared<const Channels>())
+        , _detached()
+        , _keyHandler(nullptr)
+        , _wheelHandler(nullptr)
+        , _pointerHandler(nullptr)
+        , _touchHandler(nullptr)
+    {
+    }
+
+    InputQueue::~InputQueue()
+    {
+        Block();
+        _signal.SetEvent();
+        Wait(Core::Thread::BLOCKED | Core::Thread::STOPPED, Core::infinite);
+    }
+
+    InputQueue::Channel& InputQueue::Attach(const void* producer)
+    {
+        _adminLock.Lock();
+
+        Channels::const_iterator index(_channels->begin());
+        while ((index != _channels->end()) && ((*index)->Producer() != producer)) {
+            index++;
+        }
+
+        Channel* result = nullptr;
+
+        if (index != _channels->end()) {
+            result = index->get();
+        } else {
+            Channels channels(*_channels);
+            Channels::iterator detached(_detached.begin());
+            while ((detached != _detached.end()) && ((*detached)->Producer() != producer)) {
+                detached++;
+            }
+
+            if (detached != _detached.end()) {
+                channels.push_back(*detached);
+                _detached.erase(detached);
+            } else {
+                channels.push_back(std::make_shared<Core::Sink<Channel>>(*this, producer));
+            }
+
+            result = channels.back().get();
+            Update(channels);
+        }
+
+        _adminLock.Unlock();
+
+        return (*result);
+    }
+
+    void InputQueue::Detach(const void* producer)
+    {
+        _adminLock.Lock();
+
+        Channels channels(*_channels);
+        Channels::iterator index(channels.begin());
+        while ((index != channels.end()) && ((*index)->Producer() != producer)) {
+            index++;
+        }
+
+        if (index != channels.end()) {
+            // The producer might still be reporting through it, see Attach().
+            _detached.push_back(*index);
+            channels.erase(index);
+            Update(channels);
+        }
+
+        _adminLock.Unlock();
+    }
+
+    void InputQueue::DetachAll()
+    {
+        _adminLock.Lock();
+        _detached.insert(_detached.end(), _channels->begin(), _channels->end());
+        Update(Channels());
+        _adminLock.Unlock();
+    }
+
+    void InputQueue::Handler(Exchange::IKeyHandler* handler)
+    {
+        _adminLock.Lock();
+        _keyHandler = handler;
+        _adminLock.Unlock();
+
+        if (handler != nullptr) {
+            Run();
+        }
+    }
+
+    void InputQueue::Handler(Exchange::IWheelHandler* handler)
+    {
+        _adminLock.Lock();
+        _wheelHandler = handler;
+        _adminLock.Unlock();
+
+        if (handler != nullptr) {
+            Run();
+        }
+    }
+
+    void InputQueue::Handler(Exchange::IPointerHandler* handler)
+    {
+        _adminLock.Lock();
+        _pointerHandler = handler;
+        _adminLock.Unlock();
+
+        if (handler != nullptr) {
+            Run();
+        }
+    }
+
+    void InputQueue::Handler(Exchange::ITouchHandler* handler)
+    {
+        _adminLock.Lock();
+        _touchHandler = handler;
+        _adminLock.Unlock();
+
+        if (handler != nullptr) {
+            Run();
+        }
+    }
+
+    // Should be called with the _adminLock taken.
+    void InputQueue::Update(const Channels& channels)
+    {
+        std::atomic_store(&_channels, std::shared_ptr<const Channels>(std::make_shared<const Channels>(channels)));
+    }
+
+    void InputQueue::Signal()
+    {
+        _signal.SetEvent();
+    }
+
+    uint32_t InputQueue::Worker()
+    {
+        _signal.Lock(Core::infinite);
+        _signal.ResetEvent();
+
+        if (IsRunning() == true) {
+            std::shared_ptr<const Channels> channels(std::atomic_load(&_channels));
+            const Event* next;
+
+            // Deliver the oldest event of all channels first, till they are all empty. The lock is only
+            // taken per event, so attaching producers or changing handlers does not wait for a burst.
+            do {
+                Channel* source = nullptr;
+                next = nullptr;
+
+                for (const std::shared_ptr<Core::Sink<Channel>>& channel : *channels) {
+                    const Event* event(channel->Events().Front());
+
+                    if ((event != nullptr) && ((next == nullptr) || (event->Time < next->Time))) {
+                        next = event;
+                        source = channel.get();
+                    }
+                }
+
+                if (next != nullptr) {
+                    _adminLock.Lock();
+                    Deliver(*next);
+                    _adminLock.Unlock();
+
+                    source->Events().Pop();
+                }
+            } while (next != nullptr);
+        }
+
+        return (0);
+    }
+
+    // Should be called with the _adminLock taken.
+    void InputQueue::Deliver(const Event& event)
+    {
+        switch (event.Type) {
+        case Event::KEY:
+            if (_keyHandler != nullptr) {
+                _keyHandler->KeyEvent(event.Pressed, event.Code, event.Map);
+            }
+            break;
+        case Event::AXIS:
+            if (_wheelHandler != nullptr) {
+                _wheelHandler->AxisEvent(static_cast<int16_t>(event.X), static_cast<int16_t>(event.Y));
+            }
+            break;
+        case Event::POINTER_BUTTON:
+            if (_pointerHandler != nullptr) {
+                _pointerHandler->PointerButtonEvent(event.Pressed, event.Index);
+            }
+            break;
+        case Event::POINTER_MOTION:
+            if (_pointerHandler != nullptr) {
+                _pointerHandler->PointerMotionEvent(static_cast<int16_t>(event.X), static_cast<int16_t>(event.Y));
+            }
+            break;
+        case Event::TOUCH:
+            if (_touchHandler != nullptr) {
+                _touchHandler->TouchEvent(event.Index, static_cast<Exchange::ITouchHandler::touchstate>(event.State), static_cast<uint16_t>(event.X), static_cast<uint16_t>(event.Y));
+            }
+            break;
+        }
+    }
+}
+}
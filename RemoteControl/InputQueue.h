@@ -0,0 +1,205 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Module.h"
+#include <interfaces/IKeyHandler.h>
+
+#include <atomic>
+#include <memory>
+
+namespace WPEFramework {
+namespace Remotes {
+
+    // Decouples the input producers from the delivery to the handlers (the VirtualInput). Every producer
+    // gets a channel of its own, reporting an event only writes to the ring of that channel (single
+    // producer, single consumer, no locks). One thread merges the rings in the order the events were
+    // reported and delivers them, so producers never wait on each other or on the handlers.
+    class InputQueue : public Core::Thread {
+    public:
+        static constexpr uint16_t RingSize = 64; // Must be a power of 2.
+        static constexpr uint16_t PushAttempts = 100;
+
+    private:
+        struct Event {
+            enum type : uint8_t {
+                KEY,
+                AXIS,
+                POINTER_BUTTON,
+                POINTER_MOTION,
+                TOUCH
+            };
+
+            uint64_t Time;
+            type Type;
+            bool Pressed;
+            uint8_t Index;
+            uint8_t State;
+            uint32_t Code;
+            int32_t X;
+            int32_t Y;
+            string Map;
+        };
+
+        class Ring {
+        public:
+            Ring(const Ring&) = delete;
+            Ring& operator=(const Ring&) = delete;
+
+            Ring()
+                : _head(0)
+                , _tail(0)
+                , _events()
+            {
+            }
+            ~Ring() = default;
+
+        public:
+            // Producer side.
+            bool Push(const Event& event)
+            {
+                const uint16_t head(_head.load(std::memory_order_relaxed));
+                bool result = (static_cast<uint16_t>(head - _tail.load(std::memory_order_acquire)) < RingSize);
+
+                if (result == true) {
+                    _events[head & (RingSize - 1)] = event;
+                    _head.store(head + 1, std::memory_order_release);
+                }
+
+                return (result);
+            }
+            // Consumer side.
+            const Event* Front() const
+            {
+                const uint16_t tail(_tail.load(std::memory_order_relaxed));
+
+                return (tail == _head.load(std::memory_order_acquire) ? nullptr : &(_events[tail & (RingSize - 1)]));
+            }
+            void Pop()
+            {
+                _tail.store(_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+            }
+
+        private:
+            std::atomic<uint16_t> _head;
+            std::atomic<uint16_t> _tail;
+            Event _events[RingSize];
+        };
+
+        class Channel : public Exchange::IKeyHandler
+                      , public Exchange::IWheelHandler
+                      , public Exchange::IPointerHandler
+                      , public Exchange::ITouchHandler {
+        public:
+            Channel() = delete;
+            Channel(const Channel&) = delete;
+            Channel& operator=(const Channel&) = delete;
+
+            Channel(InputQueue& parent, const void* producer)
+                : _parent(parent)
+                , _producer(producer)
+                , _ring()
+                , _dropped(0)
+            {
+            }
+            ~Channel() override = default;
+
+            BEGIN_INTERFACE_MAP(Channel)
+            INTERFACE_ENTRY(Exchange::IKeyHandler)
+            INTERFACE_ENTRY(Exchange::IWheelHandler)
+            INTERFACE_ENTRY(Exchange::IPointerHandler)
+            INTERFACE_ENTRY(Exchange::ITouchHandler)
+            END_INTERFACE_MAP
+
+        public:
+            const void* Producer() const
+            {
+                return (_producer);
+            }
+            Ring& Events()
+            {
+                return (_ring);
+            }
+
+            uint32_t KeyEvent(const bool pressed, const uint32_t code, const string& mapName) override;
+            void ProducerEvent(const string& producerName, const Exchange::ProducerEvents event) override;
+            Exchange::IKeyProducer* Producer(const string& name) override;
+
+            uint32_t AxisEvent(const int16_t x, const int16_t y) override;
+            Exchange::IWheelProducer* WheelProducer(const string& name) override;
+
+            uint32_t PointerButtonEvent(const bool pressed, const uint8_t button) override;
+            uint32_t PointerMotionEvent(const int16_t x, const int16_t y) override;
+            Exchange::IPointerProducer* PointerProducer(const string& name) override;
+
+            uint32_t TouchEvent(const uint8_t index, const Exchange::ITouchHandler::touchstate state, const uint16_t x, const uint16_t y) override;
+            Exchange::ITouchProducer* TouchProducer(const string& name) override;
+
+        private:
+            uint32_t Post(Event& event);
+
+        private:
+            InputQueue& _parent;
+            const void* _producer;
+            Ring _ring;
+            uint32_t _dropped;
+        };
+
+        // Copy-on-write, the delivery thread walks a snapshot without taking a lock.
+        using Channels = std::vector<std::shared_ptr<Core::Sink<Channel>>>;
+
+    public:
+        InputQueue(const InputQueue&) = delete;
+        InputQueue& operator=(const InputQueue&) = delete;
+
+        InputQueue();
+        ~InputQueue() override;
+
+    public:
+        // The channel to hand out to a producer (as its handler), created on first use. A producer
+        // keeps a plain pointer to its channel, so a detached channel lives as long as the queue and
+        // is handed out again if the producer attaches again.
+        Channel& Attach(const void* producer);
+        void Detach(const void* producer);
+        void DetachAll();
+
+        void Handler(Exchange::IKeyHandler* handler);
+        void Handler(Exchange::IWheelHandler* handler);
+        void Handler(Exchange::IPointerHandler* handler);
+        void Handler(Exchange::ITouchHandler* handler);
+
+    private:
+        uint32_t Worker() override;
+        void Signal();
+        void Deliver(const Event& event);
+        void Update(const Channels& channels);
+
+    private:
+        Core::CriticalSection _adminLock;
+        Core::Event _signal;
+        std::shared_ptr<const Channels> _channels;
+        Channels _detached;
+        Exchange::IKeyHandler* _keyHandler;
+        Exchange::IWheelHandler* _wheelHandler;
+        Exchange::IPointerHandler* _pointerHandler;
+        Exchange::ITouchHandler* _touchHandler;
+    };
+}
+}
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "Module.h"
+#include "InputQueue.h"
 #include <interfaces/IKeyHandler.h>
 
 namespace WPEFramework {
@@ -39,6 +40,7 @@ namespace Remotes {
             , _wheels()
             , _pointers()
             , _touchpanels()
+            , _queue()
         {
         }
 
@@ -239,7 +241,7 @@ namespace Remotes {
                 _remotes.push_back(&remoteControl);
 
                 if (_keyCallback != nullptr) {
-                    remoteControl.Callback(_keyCallback);
+                    remoteControl.Callback(static_cast<Exchange::IKeyHandler*>(&_queue.Attach(&remoteControl)));
                 }
             }
 
@@ -256,7 +258,7 @@ namespace Remotes {
                 _wheels.push_back(&wheel);
 
                 if (_wheelCallback != nullptr) {
-                    wheel.Callback(_wheelCallback);
+                    wheel.Callback(static_cast<Exchange::IWheelHandler*>(&_queue.Attach(&wheel)));
                 }
             }
 
@@ -273,7 +275,7 @@ namespace Remotes {
                 _pointers.push_back(&pointer);
 
                 if (_pointerCallback != nullptr) {
-                    pointer.Callback(_pointerCallback);
+                    pointer.Callback(static_cast<Exchange::IPointerHandler*>(&_queue.Attach(&pointer)));
                 }
             }
 
@@ -290,7 +292,7 @@ namespace Remotes {
                 _touchpanels.push_back(&touchPanel);
 
                 if (_touchCallback != nullptr) {
-                    touchPanel.Callback(_touchCallback);
+                    touchPanel.Callback(static_cast<Exchange::ITouchHandler*>(&_queue.Attach(&touchPanel)));
                 }
             }
 
@@ -311,6 +313,8 @@ namespace Remotes {
                 if (_keyCallback != nullptr) {
                     remoteControl.Callback(nullptr);
                 }
+
+                _queue.Detach(&remoteControl);
             }
 
             _adminLock.Unlock();
@@ -328,6 +332,8 @@ namespace Remotes {
                 if (_wheelCallback != nullptr) {
                     wheel.Callback(nullptr);
                 }
+
+                _queue.Detach(&wheel);
             }
 
             _adminLock.Unlock();
@@ -345,6 +351,8 @@ namespace Remotes {
                 if (_pointerCallback != nullptr) {
                     pointer.Callback(nullptr);
                 }
+
+                _queue.Detach(&pointer);
             }
 
             _adminLock.Unlock();
@@ -362,6 +370,8 @@ namespace Remotes {
                 if (_touchCallback != nullptr) {
                     touchpanel.Callback(nullptr);
                 }
+
+                _queue.Detach(&touchpanel);
             }
 
             _adminLock.Unlock();
@@ -414,6 +424,8 @@ namespace Remotes {
                 _touchpanels.clear();
             }
 
+            _queue.DetachAll();
+
             _adminLock.Unlock();
         }
         void Callback(Exchange::IKeyHandler* callback)
@@ -425,8 +437,10 @@ namespace Remotes {
             auto index(_remotes.begin());
             _keyCallback = callback;
 
+            _queue.Handler(callback);
+
             while (index != _remotes.end()) {
-                uint32_t result = (*index)->Callback(callback);
+                uint32_t result = (*index)->Callback(callback == nullptr ? nullptr : static_cast<Exchange::IKeyHandler*>(&_queue.Attach(*index)));
 
                 if (result != Core::ERROR_NONE) {
                     if (callback == nullptr) {
@@ -450,8 +464,10 @@ namespace Remotes {
             auto index(_wheels.begin());
             _wheelCallback = callback;
 
+            _queue.Handler(callback);
+
             while (index != _wheels.end()) {
-                uint32_t result = (*index)->Callback(callback);
+                uint32_t result = (*index)->Callback(callback == nullptr ? nullptr : static_cast<Exchange::IWheelHandler*>(&_queue.Attach(*index)));
 
                 if (result != Core::ERROR_NONE) {
                     if (callback == nullptr) {
@@ -475,8 +491,10 @@ namespace Remotes {
             auto index(_pointers.begin());
             _pointerCallback = callback;
 
+            _queue.Handler(callback);
+
             while (index != _pointers.end()) {
-                uint32_t result = (*index)->Callback(callback);
+                uint32_t result = (*index)->Callback(callback == nullptr ? nullptr : static_cast<Exchange::IPointerHandler*>(&_queue.Attach(*index)));
 
                 if (result != Core::ERROR_NONE) {
                     if (callback == nullptr) {
@@ -500,8 +518,10 @@ namespace Remotes {
             auto index(_touchpanels.begin());
             _touchCallback = callback;
 
+            _queue.Handler(callback);
+
             while (index != _touchpanels.end()) {
-                uint32_t result = (*index)->Callback(callback);
+                uint32_t result = (*index)->Callback(callback == nullptr ? nullptr : static_cast<Exchange::ITouchHandler*>(&_queue.Attach(*index)));
 
                 if (result != Core::ERROR_NONE) {
                     if (callback == nullptr) {
@@ -527,6 +547,7 @@ namespace Remotes {
         std::list<Exchange::IWheelProducer*> _wheels;
         std::list<Exchange::IPointerProducer*> _pointers;
         std::list<Exchange::ITouchProducer*> _touchpanels;
+        InputQueue _queue;
     };
 }
 }
@@ -338,6 +338,7 @@ namespace Plugin {
         };
 
         using URLList = std::list<std::pair<string, Filter&>>;
+        using URLCache = std::map<string, const Filter*>;
         using Iterator = Core::IteratorType<const std::list<string>, const string&, std::list<string>::const_iterator>;
 
     public:
@@ -349,6 +350,8 @@ namespace Plugin {
             , _filterMap()
             , _unusedRoles()
             , _undefinedURLS()
+            , _urlLock()
+            , _urlCache()
         {
         }
         ~AccessControlList()
@@ -370,25 +373,30 @@ namespace Plugin {
             _filterMap.clear();
             _unusedRoles.clear();
             _undefinedURLS.clear();
+            FlushCache();
         }
         const Filter* FilterMapFromURL(const string& URL) const
         {
             const Filter* result = nullptr;
-            std::smatch matchList;
-            URLList::const_iterator index = _urlMap.begin();
 
-            while ((index != _urlMap.end()) && (result == nullptr)) {
-                // regex_search() for searching the regex pattern
-                // 'r' in the string 's'. 'm' is flag for determining
-                // matching behavior.
-                std::regex expression(index->first.c_str());
+            _urlLock.Lock();
+            URLCache::const_iterator cached(_urlCache.find(URL));
+            bool found = (cached != _urlCache.end());
+            if (found == true) {
+                result = cached->second;
+            }
+            _urlLock.Unlock();
 
-                if (std::regex_search(URL, matchList, expression) == true) {
-                    result = &(index->second);
-                }
-                else {
-                    index++;
+            if (found == false) {
+                result = Lookup(URL);
+
+                _urlLock.Lock();
+                if (_urlCache.size() >= URLCacheSize) {
+                    // Origins are typically a handful, if this overflows, just start over.
+                    _urlCache.clear();
                 }
+                _urlCache.emplace(URL, result);
+                _urlLock.Unlock();
             }
 
             return (result);
@@ -396,6 +404,9 @@ namespace Plugin {
         uint32_t Load(Core::File& source)
         {
             JSONACL controlList;
+
+            FlushCache();
+
             Core::OptionalType<Core::JSON::Error> error;
             controlList.IElement::FromFile(source, error);
             if (error.IsSet() == true) {
@@ -449,12 +460,48 @@ namespace Plugin {
             return ((_unusedRoles.empty() && _undefinedURLS.empty()) ? Core::ERROR_NONE : Core::ERROR_INCOMPLETE_CONFIG);
         }
 
+    private:
+        static constexpr uint16_t URLCacheSize = 64;
+
+        void FlushCache()
+        {
+            _urlLock.Lock();
+            _urlCache.clear();
+            _urlLock.Unlock();
+        }
+        const Filter* Lookup(const string& URL) const
+        {
+            const Filter* result = nullptr;
+            std::smatch matchList;
+            URLList::const_iterator index = _urlMap.begin();
+
+            while ((index != _urlMap.end()) && (result == nullptr)) {
+                // regex_search() for searching the regex pattern
+                // 'r' in the string 's'. 'm' is flag for determining
+                // matching behavior.
+                std::regex expression(index->first.c_str());
+
+                if (std::regex_search(URL, matchList, expression) == true) {
+                    result = &(index->second);
+                }
+                else {
+                    index++;
+                }
+            }
+
+            return (result);
+        }
+
     private:
 	//_urlMap contains list of entries of urls under "groups" to the allow/block filters set for that role under "thunder"
         URLList _urlMap; 
         std::map<string, Filter> _filterMap;
         std::list<string> _unusedRoles;
         std::list<string> _undefinedURLS;
+
+        // Resolved filters (or the lack of one) per URL, saves the regex walk over _urlMap.
+        mutable Core::CriticalSection _urlLock;
+        mutable URLCache _urlCache;
     };
 }
 }
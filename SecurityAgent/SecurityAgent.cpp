@@ -74,7 +74,12 @@ namespace Plugin {
         }
     }
 
-    SecurityAgent::SecurityAgent() : _dispatcher(nullptr)
+    SecurityAgent::SecurityAgent()
+        : _dispatcher(nullptr)
+        , _adminLock()
+        , _tokens()
+        , _used()
+        , _tokenCacheSize(0)
     {
         RegisterAll();
 
@@ -86,6 +91,7 @@ namespace Plugin {
     /* virtual */ SecurityAgent::~SecurityAgent()
     {
         UnregisterAll();
+        Flush();
     }
 
     /* virtual */ const string SecurityAgent::Initialize(PluginHost::IShell* service)
@@ -95,6 +101,10 @@ namespace Plugin {
         string version = service->Version();
 
         _skipURL = static_cast<uint8_t>(service->WebPrefix().length());
+        _tokenCacheSize = config.TokenCache.Value();
+
+        // Contexts refer to the filters of the ACL that is about to be (re)loaded.
+        Flush();
         Core::File aclFile(service->PersistentPath() + config.ACL.Value(), true);
 
         if (aclFile.Exists() == false) {
@@ -155,6 +165,9 @@ namespace Plugin {
             subSystem->Set(PluginHost::ISubSystem::NOT_SECURITY, nullptr);
             subSystem->Release();
         }
+
+        // Cached contexts point into the ACL, drop them before it goes.
+        Flush();
         _acl.Clear();
     }
 
@@ -175,25 +188,108 @@ namespace Plugin {
     /* virtual */ PluginHost::ISecurity* SecurityAgent::Officer(const string& token)
     {
         PluginHost::ISecurity* result = nullptr;
+        const string key(_tokenCacheSize > 0 ? Digest(token) : string());
 
-        Web::JSONWebToken webToken(Web::JSONWebToken::SHA256, sizeof(_secretKey), _secretKey);
-        uint16_t load = webToken.PayloadLength(token);
-
-        // Validate the token
-        if (load != static_cast<uint16_t>(~0)) {
-            // It is potentially a valid token, extract the payload.
-            uint8_t* payload = reinterpret_cast<uint8_t*>(ALLOCA(load));
+        if (key.empty() == false) {
+            result = Cached(key);
+        }
 
-            load = webToken.Decode(token, load, payload);
+        if (result == nullptr) {
+            Web::JSONWebToken webToken(Web::JSONWebToken::SHA256, sizeof(_secretKey), _secretKey);
+            uint16_t load = webToken.PayloadLength(token);
 
+            // Validate the token
             if (load != static_cast<uint16_t>(~0)) {
-                // Seems like we extracted a valid payload, time to create an security context
-                result = Core::Service<SecurityContext>::Create<SecurityContext>(&_acl, load, payload);
+                // It is potentially a valid token, extract the payload.
+                uint8_t* payload = reinterpret_cast<uint8_t*>(ALLOCA(load));
+
+                load = webToken.Decode(token, load, payload);
+
+                if (load != static_cast<uint16_t>(~0)) {
+                    // Seems like we extracted a valid payload, time to create an security context
+                    result = Core::Service<SecurityContext>::Create<SecurityContext>(&_acl, load, payload);
+
+                    if (key.empty() == false) {
+                        Cache(key, result);
+                    }
+                }
             }
         }
         return (result);
     }
 
+    /* static */ string SecurityAgent::Digest(const string& token)
+    {
+        Crypto::SHA256 hash;
+        hash.Input(reinterpret_cast<const uint8_t*>(token.c_str()), static_cast<uint16_t>(token.length()));
+
+        return (string(reinterpret_cast<const char*>(hash.Result()), Crypto::SHA256::Length));
+    }
+
+    PluginHost::ISecurity* SecurityAgent::Cached(const string& key)
+    {
+        PluginHost::ISecurity* result = nullptr;
+
+        _adminLock.Lock();
+
+        std::map<string, CachedToken>::iterator index(_tokens.find(key));
+
+        if (index != _tokens.end()) {
+            result = index->second.Context;
+            result->AddRef();
+
+            // Mark it as the most recently used one.
+            _used.splice(_used.begin(), _used, index->second.Used);
+        }
+
+        _adminLock.Unlock();
+
+        return (result);
+    }
+
+    void SecurityAgent::Cache(const string& key, PluginHost::ISecurity*& context)
+    {
+        _adminLock.Lock();
+
+        std::map<string, CachedToken>::iterator index(_tokens.find(key));
+
+        if (index != _tokens.end()) {
+            // Someone else was verifying the same token, share the context that made it first.
+            context->Release();
+            context = index->second.Context;
+            context->AddRef();
+        } else {
+            while (_tokens.size() >= _tokenCacheSize) {
+                std::map<string, CachedToken>::iterator oldest(_tokens.find(_used.back()));
+
+                ASSERT(oldest != _tokens.end());
+
+                oldest->second.Context->Release();
+                _tokens.erase(oldest);
+                _used.pop_back();
+            }
+
+            _used.push_front(key);
+            context->AddRef();
+            _tokens.emplace(key, CachedToken { context, _used.begin() });
+        }
+
+        _adminLock.Unlock();
+    }
+
+    void SecurityAgent::Flush()
+    {
+        _adminLock.Lock();
+
+        for (std::pair<const string, CachedToken>& entry : _tokens) {
+            entry.second.Context->Release();
+        }
+        _tokens.clear();
+        _used.clear();
+
+        _adminLock.Unlock();
+    }
+
     /* virtual */ void SecurityAgent::Inbound(Web::Request& request)
     {
         request.Body(textFactory.Element());
@@ -91,9 +91,11 @@ namespace Plugin {
                 : Core::JSON::Container()
                 , ACL(_T("acl.json"))
                 , Connector()
+                , TokenCache(64)
             {
                 Add(_T("acl"), &ACL);
                 Add(_T("connector"), &Connector);
+                Add(_T("tokencache"), &TokenCache);
             }
             ~Config()
             {
@@ -102,6 +104,13 @@ namespace Plugin {
         public:
             Core::JSON::String ACL;
             Core::JSON::String Connector;
+            Core::JSON::DecUInt16 TokenCache;
+        };
+
+        // A verified token and the (immutable) context created for it.
+        struct CachedToken {
+            PluginHost::ISecurity* Context;
+            std::list<string>::iterator Used;
         };
 
     public:
@@ -157,12 +166,22 @@ namespace Plugin {
         #endif // DEBUG
         uint32_t endpoint_validate(const JsonData::SecurityAgent::CreatetokenResultInfo& params, JsonData::SecurityAgent::ValidateResultData& response);
 
+        static string Digest(const string& token);
+        PluginHost::ISecurity* Cached(const string& key);
+        void Cache(const string& key, PluginHost::ISecurity*& context);
+        void Flush();
 
     private:
         uint8_t _secretKey[Crypto::SHA256::Length];
         AccessControlList _acl;
         uint8_t _skipURL;
         TokenDispatcher* _dispatcher;
+
+        // Bounded cache of verified tokens (keyed by their SHA256 digest), most recently used first.
+        Core::CriticalSection _adminLock;
+        std::map<string, CachedToken> _tokens;
+        std::list<string> _used;
+        uint16_t _tokenCacheSize;
     };
 
 } // namespace Plugin
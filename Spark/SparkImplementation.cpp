@@ -79,7 +79,7 @@ namespace Plugin {
             Core::JSON::String EGLProvider;
         };
 
-       class NotificationSink : public Core::Thread {
+       class NotificationSink {
         private:
             NotificationSink() = delete;
             NotificationSink(const NotificationSink&) = delete;
@@ -88,14 +88,13 @@ namespace Plugin {
         public:
             NotificationSink(SparkImplementation& parent)
                 : _parent(parent)
-                , _waitTime(0)
+                , _job(*this)
                 , _command(PluginHost::IStateControl::SUSPEND)
             {
             }
-            virtual ~NotificationSink()
+            ~NotificationSink()
             {
-                Block();
-                Wait(Thread::STOPPED | Thread::BLOCKED, Core::infinite);
+                _job.Revoke();
             }
 
         public:
@@ -104,30 +103,22 @@ namespace Plugin {
 
                 _command = command;
 
-                Run();
+                _job.Submit();
             }
 
         private:
-            virtual uint32_t Worker()
-            {
-
-                bool success = false;
-
-                if ((IsRunning() == true) && (success == false)) {
+            friend Core::ThreadPool::JobType<NotificationSink&>;
 
-                    success = _parent.RequestForStateChange(_command);
-                }
-
-                Block();
+            void Dispatch()
+            {
+                bool success = _parent.RequestForStateChange(_command);
 
                 _parent.StateChangeCompleted(success, _command);
-
-                return (Core::infinite);
             }
 
         private:
             SparkImplementation& _parent;
-            uint32_t _waitTime;
+            Core::WorkerPool::JobType<NotificationSink&> _job;
             PluginHost::IStateControl::command _command;
         };
 
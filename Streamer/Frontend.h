@@ -22,6 +22,7 @@
 #include "Module.h"
 #include "Geometry.h"
 #include "Element.h"
+#include "PlaybackState.h"
 #include "PlayerPlatform.h"
 #include "Administrator.h"
 
@@ -132,50 +133,48 @@ namespace Player {
                     _parent.Lock();
                     ASSERT(_player != nullptr);
                     _player->Speed(request);
+                    _parent.Refresh();
                     _parent.Unlock();
                 }
                 int32_t Speed() const override
                 {
-                    uint32_t result = 0;
-                    _parent.Lock();
-                    ASSERT(_player != nullptr);
-                    result = _player->Speed();
-                    _parent.Unlock();
-                    return (result);
+                    // Served from the playback state cache, no need to contend with the player callbacks.
+                    return (_parent.Playback().Speed);
                 }
                 void Position(const uint64_t absoluteTime) override
                 {
                     _parent.Lock();
                     ASSERT(_player != nullptr);
                     _player->Position(absoluteTime);
+                    _parent.Refresh();
                     _parent.Unlock();
                 }
                 uint64_t Position() const override
                 {
-                    uint64_t result = 0;
-                    _parent.Lock();
-                    ASSERT(_player != nullptr);
-                    result = _player->Position();
-                    _parent.Unlock();
+                    PlaybackState::Snapshot snapshot(_parent.Playback());
+                    uint64_t result = snapshot.Position;
+
+                    // Players that do not report time updates, need to be asked.
+                    if (snapshot.Timed == false) {
+                        _parent.Lock();
+                        ASSERT(_player != nullptr);
+                        result = _player->Position();
+                        _parent.Unlock();
+                    }
                     return (result);
                 }
                 void TimeRange(uint64_t& begin, uint64_t& end) const override
                 {
-                    _parent.Lock();
-                    ASSERT(_player != nullptr);
-                    _player->TimeRange(begin, end);
-                    _parent.Unlock();
+                    PlaybackState::Snapshot snapshot(_parent.Playback());
+                    begin = snapshot.Begin;
+                    end = snapshot.End;
                 }
                 IGeometry* Geometry() const override
                 {
-                    IGeometry* result = nullptr;
-                    _parent.Lock();
-                    ASSERT(_player != nullptr);
-                    _geometry.Window(_player->Window());
-                    _geometry.Order(_player->Order());
-                    result = &_geometry;
-                    _parent.Unlock();
-                    return (result);
+                    PlaybackState::Snapshot snapshot(_parent.Playback());
+                    _geometry.Window(snapshot.Window);
+                    _geometry.Order(snapshot.Order);
+                    return (&_geometry);
                 }
                 void Geometry(const IGeometry* settings) override
                 {
@@ -188,6 +187,7 @@ namespace Player {
                     window.Height = settings->Height();
                     _player->Window(window);
                     _player->Order(settings->Z());
+                    _parent.Refresh();
                     _parent.Unlock();
                 }
                 void Callback(IControl::ICallback* callback) override
@@ -245,11 +245,13 @@ namespace Player {
                 , _sink(this)
                 , _player(player)
                 , _elements()
+                , _playback()
             {
                 ASSERT(_administrator != nullptr);
                 ASSERT(_player != nullptr);
 
                 _player->Callback(&_sink);
+                _playback.Update(*_player);
             }
             ~Frontend() override
             {
@@ -331,6 +333,7 @@ namespace Player {
 
                         if (_decoder != nullptr) {
                             _player->AttachDecoder(decoderId);
+                            Refresh();
 
                             // AddRef ourselves as the Control, being handed out, needs the
                             // Frontend created in this class. This is his parent class.....
@@ -357,17 +360,15 @@ namespace Player {
             }
             state State() const override
             {
-                _adminLock.Lock();
-                ASSERT(_player != nullptr);
-                state result = _player->State();
-                _adminLock.Unlock();
-                return (result);
+                return (_playback.Get().State);
             }
             uint32_t Load(const string& configuration) override
             {
                 _adminLock.Lock();
                 ASSERT(_player != nullptr);
                 uint32_t result = _player->Load(configuration);
+                _playback.Reset();
+                Refresh();
                 _adminLock.Unlock();
                 return (result);
             }
@@ -398,6 +399,7 @@ namespace Player {
             void StateChange(Exchange::IStream::state newState)
             {
                 _adminLock.Lock();
+                Refresh();
                 if (_callback != nullptr) {
                     _callback->StateChange(newState);
                 }
@@ -409,6 +411,9 @@ namespace Player {
             void TimeUpdate(uint64_t position)
             {
                 _adminLock.Lock();
+                _playback.Position(position);
+                // Speed (e.g. at end of stream) and the range of a live stream change without a state change.
+                Refresh();
                 if (_decoder != nullptr) {
                     _decoder->TimeUpdate(position);
                 }
@@ -447,6 +452,7 @@ namespace Player {
                     ASSERT(_administrator != nullptr);
                     ReleaseElements();
                     _player->DetachDecoder(_decoder->Index());
+                    Refresh();
                     _administrator->Deallocate(_decoder->Index());
                     _decoder = nullptr;
                     Release();
@@ -465,6 +471,16 @@ namespace Player {
             {
                 _adminLock.Unlock();
             }
+            PlaybackState::Snapshot Playback() const
+            {
+                return (_playback.Get());
+            }
+            // Must be called with the lock taken.
+            void Refresh()
+            {
+                ASSERT(_player != nullptr);
+                _playback.Update(*_player);
+            }
 
             // Helper functions, not interlocked
             void PopulateElements()
@@ -494,6 +510,7 @@ namespace Player {
             CallbackImplementation _sink;
             IPlayerPlatform* _player;
             std::list<Implementation::Element*> _elements;
+            PlaybackState _playback;
         };
 
     } // Implementation
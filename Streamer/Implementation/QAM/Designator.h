@@ -40,6 +40,7 @@ namespace Broadcast {
             : _header()
             , _frequency(0)
             , _symbolRate(0)
+            , _program(0)
             , _modulation()
             , _spectral(SpectralInversion::Auto)
         {
@@ -83,7 +84,7 @@ namespace Broadcast {
                             } else if (key == _T("pgmno")) {
                                 _program = Core::NumberType<uint16_t>(index.Current()).Value();
                             } else if (key == _T("spectral")) {
-                                _symbolRate = static_cast<Broadcast::SpectralInversion>(
+                                _spectral = static_cast<Broadcast::SpectralInversion>(
                                     Core::NumberType<uint32_t>(index.Current()).Value());
                             }
                         }
@@ -108,6 +109,102 @@ namespace Broadcast {
         Broadcast::Modulation _modulation;
         Broadcast::SpectralInversion _spectral;
     };
+
+    // The parsed outcome of a designator, it identifies the transport (Frequency, Modulation,
+    // SymbolRate, Spectral) and the program on it.
+    struct Tuning {
+        uint32_t Frequency;
+        Broadcast::Modulation Modulation;
+        uint32_t SymbolRate;
+        uint16_t ProgramNumber;
+        Broadcast::SpectralInversion Spectral;
+
+        inline bool IsValid() const
+        {
+            return (Frequency != 0);
+        }
+        inline bool SameTransport(const Tuning& rhs) const
+        {
+            return ((Frequency == rhs.Frequency) && (Modulation == rhs.Modulation) && (SymbolRate == rhs.SymbolRate) && (Spectral == rhs.Spectral));
+        }
+        inline bool operator==(const Tuning& rhs) const
+        {
+            return ((SameTransport(rhs) == true) && (ProgramNumber == rhs.ProgramNumber));
+        }
+        inline bool operator!=(const Tuning& rhs) const
+        {
+            return (!operator==(rhs));
+        }
+    };
+
+    // Zapping through channels presents the same designators over and over again. Keep the
+    // outcome of the last parsed designators, so they only need to be parsed once.
+    class DesignatorCache {
+    private:
+        DesignatorCache(const DesignatorCache&) = delete;
+        DesignatorCache& operator=(const DesignatorCache&) = delete;
+
+        static constexpr uint16_t Capacity = 64;
+
+    public:
+        DesignatorCache()
+            : _adminLock()
+            , _entries()
+            , _usage()
+        {
+        }
+        ~DesignatorCache() = default;
+
+        static DesignatorCache& Instance()
+        {
+            static DesignatorCache _singleton;
+            return (_singleton);
+        }
+
+    public:
+        Tuning Get(const string& designator)
+        {
+            Tuning result;
+
+            _adminLock.Lock();
+
+            std::map<string, Entry>::iterator index(_entries.find(designator));
+
+            if (index != _entries.end()) {
+                // Most recently used, move it to the front.
+                _usage.splice(_usage.begin(), _usage, index->second.Usage);
+                result = index->second.Value;
+            } else {
+                Designator parser(designator);
+
+                result = { parser.Frequency(), parser.Modulation(), parser.SymbolRate(), parser.ProgramNumber(), parser.Spectral() };
+
+                if (_entries.size() >= Capacity) {
+                    _entries.erase(_usage.back());
+                    _usage.pop_back();
+                }
+
+                _usage.push_front(designator);
+                _entries.emplace(std::piecewise_construct,
+                    std::forward_as_tuple(designator),
+                    std::forward_as_tuple(Entry { result, _usage.begin() }));
+            }
+
+            _adminLock.Unlock();
+
+            return (result);
+        }
+
+    private:
+        struct Entry {
+            Tuning Value;
+            std::list<string>::iterator Usage;
+        };
+
+        Core::CriticalSection _adminLock;
+        std::map<string, Entry> _entries;
+        std::list<string> _usage;
+    };
 } // namespace Broadcast
 } // namespace WPEFramework
 
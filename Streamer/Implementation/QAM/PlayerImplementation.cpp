@@ -29,6 +29,64 @@ namespace Implementation {
 
         static Exchange::IStream::streamtype _supported;
 
+        // Standby tuners ("pretune" of them) are the tuners following the ones of the frontends, any
+        // player can claim a free one. They never collide with a tuner a player is created on.
+        class StandbyPool {
+        public:
+            StandbyPool(const StandbyPool&) = delete;
+            StandbyPool& operator=(const StandbyPool&) = delete;
+
+            StandbyPool()
+                : _lock()
+                , _first(0)
+                , _count(0)
+                , _used(0)
+            {
+            }
+
+        public:
+            void Reset(const uint8_t first, const uint8_t count)
+            {
+                _lock.Lock();
+                ASSERT(_used == 0);
+                _first = first;
+                _count = std::min(count, static_cast<uint8_t>(sizeof(_used) * 8));
+                _used = 0;
+                _lock.Unlock();
+            }
+            // Returns the tuner index, or ~0 if all standby tuners are taken.
+            uint8_t Allocate()
+            {
+                uint8_t result = static_cast<uint8_t>(~0);
+
+                _lock.Lock();
+                for (uint8_t index = 0; (index < _count) && (result == static_cast<uint8_t>(~0)); index++) {
+                    if ((_used & (1UL << index)) == 0) {
+                        _used |= (1UL << index);
+                        result = _first + index;
+                    }
+                }
+                _lock.Unlock();
+
+                return (result);
+            }
+            void Release(const uint8_t tuner)
+            {
+                _lock.Lock();
+                ASSERT((tuner >= _first) && (tuner < (_first + _count)));
+                _used &= ~(1UL << (tuner - _first));
+                _lock.Unlock();
+            }
+
+        private:
+            Core::CriticalSection _lock;
+            uint8_t _first;
+            uint8_t _count;
+            uint32_t _used;
+        };
+
+        static StandbyPool _standbyPool;
+
         class QAM : public IPlayerPlatform {
         private:
             QAM() = delete;
@@ -71,6 +129,12 @@ namespace Implementation {
                 , _player(nullptr)
                 , _sink(*this)
                 , _index(index)
+                , _secondary(nullptr)
+                , _standbyIndex(static_cast<uint8_t>(~0))
+                , _tuned()
+                , _standby()
+                , _attached(static_cast<uint8_t>(~0))
+                , _loadTime(0)
             {
                 _speeds.push_back(100);
             }
@@ -94,6 +158,19 @@ namespace Implementation {
                     _state = Exchange::IStream::state::Idle;
                     result = Core::ERROR_NONE;
                     _error = result;
+
+                    // A standby tuner keeps the transport we left locked, so zapping back is just a Prepare.
+                    _standbyIndex = _standbyPool.Allocate();
+
+                    if (_standbyIndex != static_cast<uint8_t>(~0)) {
+                        _secondary = Broadcast::ITuner::Create(Core::NumberType<uint8_t>(_standbyIndex).Text());
+
+                        if (_secondary == nullptr) {
+                            TRACE(Trace::Information, (_T("Standby tuner %d could not be opened for player %d"), _standbyIndex, _index));
+                            _standbyPool.Release(_standbyIndex);
+                            _standbyIndex = static_cast<uint8_t>(~0);
+                        }
+                    }
                 }
 
                 return result;
@@ -103,8 +180,21 @@ namespace Implementation {
                 if (_player != nullptr) {
                     _player->Callback(nullptr);
                     delete _player;
+                    _player = nullptr;
+                }
+                if (_secondary != nullptr) {
+                    _secondary->Callback(nullptr);
+                    delete _secondary;
+                    _secondary = nullptr;
+                }
+                if (_standbyIndex != static_cast<uint8_t>(~0)) {
+                    _standbyPool.Release(_standbyIndex);
+                    _standbyIndex = static_cast<uint8_t>(~0);
                 }
 
+                _tuned = Broadcast::Tuning();
+                _standby = Broadcast::Tuning();
+
                 _state = Exchange::IStream::state::Error;
                 _error = Core::ERROR_UNAVAILABLE;
 
@@ -148,27 +238,69 @@ namespace Implementation {
 
                 if (_state != Exchange::IStream::state::Error) {
 
-                    Broadcast::Designator parser(configuration);
+                    const Broadcast::Tuning target(Broadcast::DesignatorCache::Instance().Get(configuration));
+
+                    uint8_t decoder = static_cast<uint8_t>(~0);
+
+                    _loadTime = Core::Time::Now().Ticks();
 
-                    TRACE(Trace::Information, (_T("Tuning to %u MHz mode=%s sym=%d Annex=%s spectralMode=%s"),
-                        parser.Frequency(),
-                        Core::EnumerateType<Broadcast::Modulation>(parser.Modulation()).Data(),
-                        parser.SymbolRate(),
-                        Core::EnumerateType<Broadcast::ITuner::annex>(_player->Annex()).Data(),
-                        Core::EnumerateType<Broadcast::SpectralInversion>(parser.Spectral()).Data()));
+                    if ((_secondary != nullptr) && (_tuned.SameTransport(target) == false)) {
+                        // Whatever happens, the transport we are leaving stays locked on the standby tuner.
+                        bool hit = ((_standby.SameTransport(target) == true) && (_secondary->State() != Broadcast::ITuner::IDLE));
 
-                    result = _player->Tune(parser.Frequency(), parser.Modulation(),
-                        parser.SymbolRate(), Broadcast::FEC_INNER_UNKNOWN, parser.Spectral());
+                        decoder = Swap();
+
+                        if (hit == true) {
+                            TRACE(Trace::Information, (_T("Transport %u MHz is still locked on the standby tuner"), target.Frequency));
+                        }
+                    }
+
+                    result = Core::ERROR_NONE;
+
+                    if ((_tuned.SameTransport(target) == false) || (_player->State() == Broadcast::ITuner::IDLE)) {
+                        TRACE(Trace::Information, (_T("Tuning to %u MHz mode=%s sym=%d Annex=%s spectralMode=%s"),
+                            target.Frequency,
+                            Core::EnumerateType<Broadcast::Modulation>(target.Modulation).Data(),
+                            target.SymbolRate,
+                            Core::EnumerateType<Broadcast::ITuner::annex>(_player->Annex()).Data(),
+                            Core::EnumerateType<Broadcast::SpectralInversion>(target.Spectral).Data()));
+
+                        _tuned = Broadcast::Tuning();
+
+                        result = _player->Tune(target.Frequency, target.Modulation,
+                            target.SymbolRate, Broadcast::FEC_INNER_UNKNOWN, target.Spectral);
+                    }
 
                     if (result != Core::ERROR_NONE) {
                         _state = Exchange::IStream::state::Error;
                         TRACE(Trace::Error, (_T("Error in player load :%d"), result));
                         _error = result;
+                        _loadTime = 0;
                         _callback->StateChange(_state);
                     } else {
-                        TRACE(Trace::Information, (_T("Tuning to ProgramNumber %d"), parser.ProgramNumber()));
-                        _player->Prepare(parser.ProgramNumber());
+                        if ((_tuned != target) || (_player->State() != Broadcast::ITuner::PREPARED)) {
+                            TRACE(Trace::Information, (_T("Tuning to ProgramNumber %d"), target.ProgramNumber));
+                            _player->Prepare(target.ProgramNumber);
+                        } else {
+                            // Already prepared, no PREPARED state change will report the channel change.
+                            _loadTime = 0;
+                        }
+                        _tuned = target;
                         _state = Exchange::IStream::state::Prepared;
+
+                        if (decoder != static_cast<uint8_t>(~0)) {
+                            // The decoder is still attached as far as the frontend knows, it follows the swapped in tuner.
+                            const uint32_t attach = _player->Attach(decoder);
+
+                            if (attach == Core::ERROR_NONE) {
+                                _attached = decoder;
+                            } else {
+                                TRACE(Trace::Error, (_T("Error in re-attaching decoder %d after a tuner swap: %d"), decoder, attach));
+                                _error = attach;
+                                _state = Exchange::IStream::state::Error;
+                                _callback->StateChange(_state);
+                            }
+                        }
                     }
                 }
 
@@ -253,7 +385,9 @@ namespace Implementation {
                 if (_state == Exchange::IStream::state::Prepared) {
 
                     result = _player->Attach(index);
-                    if (result != Core::ERROR_NONE) {
+                    if (result == Core::ERROR_NONE) {
+                        _attached = index;
+                    } else {
                         TRACE(Trace::Error, (_T("Error in attach decoder %d"), result));
                         _error = result;
                         _state = Exchange::IStream::state::Error;
@@ -274,6 +408,7 @@ namespace Implementation {
                 if ( (_state > Exchange::IStream::state::Prepared) && (_state != Exchange::IStream::state::Error) ) {
 
                     result = _player->Detach(index);
+                    _attached = static_cast<uint8_t>(~0);
                     if (result != Core::ERROR_NONE) {
                         TRACE(Trace::Error, (_T("Error in detach decoder %d"), result));
                         _error = result;
@@ -303,6 +438,10 @@ namespace Implementation {
                     }
                 }
                 else if (result == Broadcast::ITuner::PREPARED) {
+                    if (_loadTime != 0) {
+                        TRACE(Trace::Information, (_T("Channel change took %u ms"), static_cast<uint32_t>((Core::Time::Now().Ticks() - _loadTime) / Core::Time::MicroSecondsPerMilliSecond)));
+                        _loadTime = 0;
+                    }
                     if (_state == Exchange::IStream::state::Loading) {
                         _state = Exchange::IStream::state::Prepared;
                     }
@@ -331,6 +470,31 @@ namespace Implementation {
                 }
             }
 
+        private:
+            // Returns the decoder that was detached from the tuner swapped out, it needs to be
+            // attached to the swapped in tuner once that one is prepared.
+            uint8_t Swap()
+            {
+                ASSERT(_secondary != nullptr);
+
+                const uint8_t decoder = _attached;
+
+                // A decoder can only be fed from the tuner it was attached to.
+                if (_attached != static_cast<uint8_t>(~0)) {
+                    _player->Detach(_attached);
+                    _attached = static_cast<uint8_t>(~0);
+                }
+
+                _player->Callback(nullptr);
+
+                std::swap(_player, _secondary);
+                std::swap(_tuned, _standby);
+
+                _player->Callback(&_sink);
+
+                return (decoder);
+            }
+
         private:
             Exchange::IStream::state _state;
             Exchange::IStream::drmtype _drmType;
@@ -352,10 +516,39 @@ namespace Implementation {
             Broadcast::ITuner* _player;
             Sink _sink;
             uint8_t _index;
+
+            Broadcast::ITuner* _secondary;
+            uint8_t _standbyIndex;
+            Broadcast::Tuning _tuned;
+            Broadcast::Tuning _standby;
+            uint8_t _attached;
+            uint64_t _loadTime;
         };
 
         static PlayerPlatformRegistrationType<QAM, Exchange::IStream::streamtype::Undefined> Register(
             /*  Initialize */ [](const string& configuration) -> uint32_t {
+                class Config : public Core::JSON::Container {
+                public:
+                    Config(const Config&) = delete;
+                    Config& operator=(const Config&) = delete;
+
+                    Config()
+                        : Core::JSON::Container()
+                        , Frontends(0)
+                        , PreTune(0)
+                    {
+                        Add(_T("frontends"), &Frontends);
+                        Add(_T("pretune"), &PreTune);
+                    }
+
+                public:
+                    Core::JSON::DecUInt8 Frontends;
+                    Core::JSON::DecUInt8 PreTune;
+                } config;
+
+                config.FromString(configuration);
+                _standbyPool.Reset(config.Frontends.Value(), config.PreTune.Value());
+
                 Broadcast::ITuner::Initialize(configuration);
                 _supported = static_cast<Exchange::IStream::streamtype>(
                     (Broadcast::ITuner::IsSupported(Broadcast::ITuner::Cable)       ? static_cast<int>(Exchange::IStream::streamtype::Cable)       : 0) |
@@ -0,0 +1,178 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+#pragma once
+
+#include "Module.h"
+#include "Geometry.h"
+#include "PlayerPlatform.h"
+
+#include <atomic>
+#include <thread>
+
+namespace WPEFramework {
+
+namespace Player {
+
+    namespace Implementation {
+
+        // Copy of the playback state of a player that can be read without taking any lock.
+        // It is a sequence lock: the writer makes the sequence odd while updating, readers
+        // retry if the sequence was odd or changed during their read. Writers must be
+        // serialized by the caller (the Frontend lock).
+        class PlaybackState {
+        private:
+            PlaybackState(const PlaybackState&) = delete;
+            PlaybackState& operator=(const PlaybackState&) = delete;
+
+        public:
+            struct Snapshot {
+                Exchange::IStream::state State;
+                int32_t Speed;
+                uint64_t Position;
+                uint64_t Begin;
+                uint64_t End;
+                Rectangle Window;
+                uint32_t Order;
+                bool Timed;
+            };
+
+        public:
+            PlaybackState()
+                : _sequence(0)
+                , _state(Exchange::IStream::state::Error)
+                , _speed(0)
+                , _position(0)
+                , _begin(0)
+                , _end(0)
+                , _x(0)
+                , _y(0)
+                , _width(0)
+                , _height(0)
+                , _order(0)
+                , _timed(false)
+            {
+            }
+            ~PlaybackState() = default;
+
+        public:
+            // Writer side, take over everything the player reports.
+            void Update(const IPlayerPlatform& player)
+            {
+                uint64_t begin = 0;
+                uint64_t end = 0;
+                player.TimeRange(begin, end);
+                const Rectangle& window(player.Window());
+
+                Begin();
+                _state.store(player.State(), std::memory_order_relaxed);
+                _speed.store(player.Speed(), std::memory_order_relaxed);
+                _begin.store(begin, std::memory_order_relaxed);
+                _end.store(end, std::memory_order_relaxed);
+                _x.store(window.X, std::memory_order_relaxed);
+                _y.store(window.Y, std::memory_order_relaxed);
+                _width.store(window.Width, std::memory_order_relaxed);
+                _height.store(window.Height, std::memory_order_relaxed);
+                _order.store(player.Order(), std::memory_order_relaxed);
+
+                if (_timed.load(std::memory_order_relaxed) == false) {
+                    _position.store(player.Position(), std::memory_order_relaxed);
+                }
+                End();
+            }
+            // Writer side, the player reported a new position.
+            void Position(const uint64_t position)
+            {
+                Begin();
+                _position.store(position, std::memory_order_relaxed);
+                _timed.store(true, std::memory_order_relaxed);
+                End();
+            }
+            // Writer side, a new stream is loaded, positions are not reported for it (yet).
+            void Reset()
+            {
+                Begin();
+                _timed.store(false, std::memory_order_relaxed);
+                End();
+            }
+
+            // Reader side, never blocks.
+            Snapshot Get() const
+            {
+                Snapshot result;
+                uint32_t sequence;
+
+                do {
+                    sequence = _sequence.load(std::memory_order_acquire);
+
+                    while ((sequence & 1) != 0) {
+                        std::this_thread::yield();
+                        sequence = _sequence.load(std::memory_order_acquire);
+                    }
+
+                    result.State = _state.load(std::memory_order_relaxed);
+                    result.Speed = _speed.load(std::memory_order_relaxed);
+                    result.Position = _position.load(std::memory_order_relaxed);
+                    result.Begin = _begin.load(std::memory_order_relaxed);
+                    result.End = _end.load(std::memory_order_relaxed);
+                    result.Window.X = _x.load(std::memory_order_relaxed);
+                    result.Window.Y = _y.load(std::memory_order_relaxed);
+                    result.Window.Width = _width.load(std::memory_order_relaxed);
+                    result.Window.Height = _height.load(std::memory_order_relaxed);
+                    result.Order = _order.load(std::memory_order_relaxed);
+                    result.Timed = _timed.load(std::memory_order_relaxed);
+
+                    std::atomic_thread_fence(std::memory_order_acquire);
+
+                } while (sequence != _sequence.load(std::memory_order_relaxed));
+
+                return (result);
+            }
+
+        private:
+            void Begin()
+            {
+                _sequence.store(_sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+            }
+            void End()
+            {
+                _sequence.store(_sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+            }
+
+        private:
+            std::atomic<uint32_t> _sequence;
+            std::atomic<Exchange::IStream::state> _state;
+            std::atomic<int32_t> _speed;
+            std::atomic<uint64_t> _position;
+            std::atomic<uint64_t> _begin;
+            std::atomic<uint64_t> _end;
+            std::atomic<uint32_t> _x;
+            std::atomic<uint32_t> _y;
+            std::atomic<uint32_t> _width;
+            std::atomic<uint32_t> _height;
+            std::atomic<uint32_t> _order;
+            std::atomic<bool> _timed;
+        };
+
+    } // Implementation
+
+} // Player
+
+}
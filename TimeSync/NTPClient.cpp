@@ -25,6 +25,10 @@ namespace Plugin {
 
     constexpr uint32_t WaitForResponse = 2000;
 
+    // After the first answer is reported, this many extra request rounds are sent to the fastest
+    // servers to refine the offset.
+    constexpr uint8_t RefineRounds = 3;
+
 #ifdef __WINDOWS__
 #pragma warning(disable : 4355)
 #endif
@@ -34,9 +38,15 @@ namespace Plugin {
         , _packet()
         , _syncedTimestamp()
         , _state(INITIAL)
-        , _fired(true)
         , _WaitForNetwork(2000) // Wait for 2 Seconds for a new attempt
         , _retryAttempts(5)
+        , _currentAttempt(0)
+        , _parallel(3)
+        , _rounds(0)
+        , _reported(false)
+        , _cursor(0)
+        , _peers()
+        , _source()
         , _activity(Core::ProxyType<Activity>::Create(this))
         , _clients()
     {
@@ -61,11 +71,12 @@ namespace Plugin {
         Close(Core::infinite);
     }
 
-    void NTPClient::Initialize(SourceIterator& sources, const uint16_t retries, const uint16_t delay)
+    void NTPClient::Initialize(SourceIterator& sources, const uint16_t retries, const uint16_t delay, const uint8_t parallel)
     {
         _retryAttempts = retries;
         _WaitForNetwork = (delay * 1000); /* in ms */
-        _servers.clear();
+        _parallel = (parallel == 0 ? 1 : parallel);
+        _peers.clear();
 
         while (sources.Next() == true) {
             Core::URL url(sources.Current().Value());
@@ -82,11 +93,11 @@ namespace Plugin {
                     hostname += ':' + Core::NumberType<uint16_t>(Core::URL::Port(url.Type())).Text();
                 }
 
-                _servers.push_back(hostname);
+                _peers.emplace_back(hostname);
             }
         }
 
-        _serverIndex = ServerIterator(_servers);
+        _cursor = 0;
     }
 
     /* virtual */ uint32_t NTPClient::Synchronize()
@@ -97,11 +108,12 @@ namespace Plugin {
 
         _adminLock.Lock();
 
-        if ((_state == INITIAL) || (_state == SUCCESS) || ((_state == FAILED) && (_serverIndex.IsValid() == false))) {
+        if ((_state == INITIAL) || (_state == SUCCESS) || (_state == FAILED)) {
             result = Core::ERROR_NONE;
+            _reported = false;
             _state = SENDREQUEST;
             Core::IWorkerPool::Instance().Submit(_activity);
-        } else if (_state == SENDREQUEST || _state == INPROGRESS) {
+        } else if ((_state == SENDREQUEST) || (_state == INPROGRESS) || (_state == REFINE)) {
             result = Core::ERROR_INPROGRESS;
         }
 
@@ -121,7 +133,8 @@ namespace Plugin {
                 Close(0);
             }
 
-            _state = FAILED;
+            // If a first time was already reported, it is still the best we have.
+            _state = (_state == REFINE ? SUCCESS : FAILED);
 
             Core::IWorkerPool::Instance().Revoke(_activity);
             Core::IWorkerPool::Instance().Submit(_activity);
@@ -136,7 +149,7 @@ namespace Plugin {
 
     /* virtual */ string NTPClient::Source() const
     {
-        return (_serverIndex.IsValid() == true ? string(_T("NTP://")) + (*_serverIndex) + '/' : _T("NTP:///"));
+        return (_source.empty() == false ? string(_T("NTP://")) + _source + '/' : _T("NTP:///"));
     }
 
     /* virtual */ void NTPClient::Register(Exchange::ITimeSync::INotification* notification)
@@ -174,9 +187,17 @@ namespace Plugin {
 
         _adminLock.Lock();
 
-        if (_fired == false) {
+        // One request per call, the socket keeps asking until every selected server has its request.
+        Peers::iterator index(_peers.begin());
+
+        while ((index != _peers.end()) && (index->IsQueued() == false)) {
+            index++;
+        }
+
+        if (index != _peers.end()) {
 
-            _fired = true;
+            index->Sent();
+            RemoteNode(index->Remote());
 
             DataFrame newFrame(dataFrame, maxSendSize);
             DataFrame::Writer writer(newFrame, 0);
@@ -184,7 +205,7 @@ namespace Plugin {
             _packet.Serialize(writer);
 
             result = newFrame.Size();
-            TRACE_L1("Timesync: Send data: %d bytes", result);
+            TRACE_L1("Timesync: Send data: %d bytes to %s", result, index->Hostname().c_str());
         }
 
         _adminLock.Unlock();
@@ -192,20 +213,27 @@ namespace Plugin {
         return result;
     }
 
-    inline static uint64_t SecondsToTicks(double seconds)
+    inline static int64_t SecondsToTicks(double seconds)
     {
-        return static_cast<uint64_t>(seconds * NTPClient::MicroSeconds);
+        return static_cast<int64_t>(seconds * NTPClient::MicroSeconds);
     }
 
     /* virtual */ uint16_t NTPClient::ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize)
     {
-        double received = static_cast<double>(Core::Time::Now().Ticks() / MicroSeconds);
+        double received = static_cast<double>(Core::Time::Now().Ticks()) / MicroSeconds;
 
         TRACE_L1("Timesync: Received data: %d bytes", receivedSize);
 
         _adminLock.Lock();
 
-        if (receivedSize == NTPPacket::PacketSize) {
+        const Core::NodeId& source(ReceivedNode());
+        Peers::iterator peer(_peers.begin());
+
+        while ((peer != _peers.end()) && ((peer->IsPending() == false) || (peer->Remote() != source))) {
+            peer++;
+        }
+
+        if ((receivedSize == NTPPacket::PacketSize) && (peer != _peers.end()) && ((_state == INPROGRESS) || (_state == REFINE))) {
 
             DataFrame frame(dataFrame, receivedSize, receivedSize);
             NTPPacket packet;
@@ -222,42 +250,52 @@ namespace Plugin {
             double diffRequest = receivedServerTS - sentTS;
             double diffResponse = sentServerTS - received;
             double offset = (diffRequest + diffResponse) / 2;
-
-#ifdef __DEBUG__
-            double elapsedServer = sentServerTS - receivedServerTS;
-            double elapsedTotal = received - sentTS;
-            double roundTrip = elapsedTotal - elapsedServer;
-#endif
+            double roundTrip = (received - sentTS) - (sentServerTS - receivedServerTS);
 
             TRACE_L1("Request time diff  = %lf", diffRequest);
             TRACE_L1("Response time diff = %lf", diffResponse);
             TRACE_L1("Offset time        = %lf", offset);
+            TRACE_L1("Round trip time    = %lf", roundTrip);
+
+            if (packet.Stratum() == 0) {
+                // Kiss-o'-death, this server does not want to serve us now.
+                TRACE(Trace::Warning, (_T("TimeSync: NTP Server [%s] refused the request: %s"), peer->Hostname().c_str(), packet.ReferenceID().c_str()));
+            } else if ((roundTrip < 0) || (roundTrip > (static_cast<double>(WaitForResponse) / MilliSeconds))) {
+                // Either a stale answer or the local clock was stepped while it was underway.
+                TRACE(Trace::Warning, (_T("TimeSync: Dropped sample from [%s], round trip %lf s"), peer->Hostname().c_str(), roundTrip));
+            } else {
+                peer->Add(offset, roundTrip);
 
-#ifdef __DEBUG__
-            TRACE_L1("Server elapsed time = %lf", elapsedServer);
-            TRACE_L1("Total elapsed time  = %lf", elapsedTotal);
-            TRACE_L1("Round trip time     = %lf", roundTrip);
-#endif
-            TRACE(Trace::Information, (_T("TimeSync: Request time diff   = %lf s"), diffRequest));
-            TRACE(Trace::Information, (_T("TimeSync: Response time diff  = %lf s"), diffResponse));
-            TRACE(Trace::Information, (_T("TimeSync: Offset time         = %lf s"), offset));
+                TRACE(Trace::Information, (_T("TimeSync: [%s] offset = %lf s, delay = %lf s"), peer->Hostname().c_str(), offset, roundTrip));
 
-            uint64_t receivedTicks = SecondsToTicks(received);
-            TRACE(Trace::Information, (_T("TimeSync: Current time: %s"), Core::Time(receivedTicks).ToRFC1123(false).c_str()));
-            _syncedTimestamp = Core::Time(receivedTicks + SecondsToTicks(offset));
-            TRACE(Trace::Information, (_T("TimeSync: New time:     %s"), _syncedTimestamp.ToRFC1123(false).c_str()));
+                if (_state == INPROGRESS) {
+                    // First good sample, report it right away and refine afterwards.
+                    uint64_t receivedTicks = static_cast<uint64_t>(SecondsToTicks(received));
+                    TRACE(Trace::Information, (_T("TimeSync: Current time: %s"), Core::Time(receivedTicks).ToRFC1123(false).c_str()));
+                    _syncedTimestamp = Core::Time(receivedTicks + SecondsToTicks(offset));
+                    TRACE(Trace::Information, (_T("TimeSync: New time:     %s"), _syncedTimestamp.ToRFC1123(false).c_str()));
 
-            _state = SUCCESS;
+                    _source = peer->Hostname();
+                    _state = REFINE;
+                    _rounds = 0;
 
-            // We don't need the socket anymore, so close it
-            TRACE_L1("TimeSync: %s", "Closing socket, no longer needed");
-            Close(0);
+                    // Lets remove the watchdog subject, we do not want to wait anymore, we got an answer.
+                    Core::IWorkerPool::Instance().Revoke(_activity);
+                    Core::IWorkerPool::Instance().Submit(_activity);
+                } else {
+                    Peers::const_iterator index(_peers.begin());
 
-            // Lets remove the watchdog subject, we do not want to wait anymore, we got an answer.
-            Core::IWorkerPool::Instance().Revoke(_activity);
+                    while ((index != _peers.end()) && (index->IsPending() == false)) {
+                        index++;
+                    }
 
-            // Schedule it again to broadcast the successfull update of the time.
-            Core::IWorkerPool::Instance().Submit(_activity);
+                    if (index == _peers.end()) {
+                        // Everybody answered, no need to wait for the timeout of this round.
+                        Core::IWorkerPool::Instance().Revoke(_activity);
+                        Core::IWorkerPool::Instance().Submit(_activity);
+                    }
+                }
+            }
         }
 
         _adminLock.Unlock();
@@ -277,61 +315,100 @@ namespace Plugin {
 
     bool NTPClient::FireRequest()
     {
+        // runs always in the context of the adminlock
 
-        bool activated = false;
+        std::vector<Peer*> selection;
 
-        // Make sure socket is closed otherwise an assert will fire.
-        if (!IsClosed()) {
-            TRACE(Trace::Information, (_T("Lingering socket, closing")));
-            Close(1000);
+        if (_state == REFINE) {
+            // Refine with the servers that answered, fastest first.
+            for (Peer& peer : _peers) {
+                if (peer.Delay() >= 0) {
+                    selection.push_back(&peer);
+                }
+            }
+            std::sort(selection.begin(), selection.end(), [](const Peer* lhs, const Peer* rhs) {
+                return (lhs->Delay() < rhs->Delay());
+            });
+            if (selection.size() > _parallel) {
+                selection.resize(_parallel);
+            }
+        } else if (_peers.empty() == false) {
+            // Ask the next batch of servers in parallel, so dead ones do not hold up the others.
+            uint32_t tried = 0;
+
+            while ((tried < _peers.size()) && (selection.size() < _parallel)) {
+                Peer& peer(_peers[(_cursor + tried) % _peers.size()]);
+
+                if (peer.Resolve() == true) {
+                    selection.push_back(&peer);
+                } else {
+                    TRACE(Trace::Warning, (_T("Could not resolve NTP Server [%s]"), peer.Hostname().c_str()));
+                }
+                tried++;
+            }
+
+            _cursor = (_cursor + tried) % _peers.size();
         }
 
-        if (true == IsClosed() && (_serverIndex.Count() > 0)) {
+        if ((selection.empty() == false) && (IsClosed() == true)) {
+            // One socket serves all servers, the remote is set per request.
+            LocalNode(selection.front()->Remote().AnyInterface());
 
-            uint32_t lastonetried = _serverIndex.Index();
+            // UDP should open by definition directly...
+            uint32_t status = Open(100);
 
-            do {
+            if ((status != Core::ERROR_NONE) && (status != Core::ERROR_INPROGRESS)) {
+                TRACE(Trace::Warning, (_T("Could not open the NTP socket")));
+                selection.clear();
+            }
+        }
 
-                // next server
-                if( _serverIndex.Index() >= _serverIndex.Count() ) {
-                    _serverIndex.Reset(0);
-                }
-                _serverIndex.Next();
-                ASSERT(_serverIndex.IsValid());
+        for (Peer* peer : selection) {
+            TRACE(Trace::Information, (_T("Trying NTP Server: [%s]"), peer->Hostname().c_str()));
+            peer->Request();
+        }
 
-                TRACE(Trace::Information, (_T("Trying NTP Server: [%s]"), (*_serverIndex).c_str()));
+        if (selection.empty() == false) {
+            Trigger();
+        }
 
-                // Set the socket to send to the remote
-                Core::NodeId remote((*_serverIndex).c_str(), Core::NodeId::TYPE_IPV4);
+        return (selection.empty() == false);
+    }
 
-                if (remote.IsValid() == true) {
-                    // Set the remote endpoint for the socket to the selected NTP server
-                    RemoteNode(remote);
-                    LocalNode(remote.AnyInterface());
+    void NTPClient::Conclude()
+    {
+        // runs always in the context of the adminlock
 
-                    // UDP should open by definition directly...
-                    uint32_t status = Open(100);
+        const Peer* best = nullptr;
 
-                    if ((status == Core::ERROR_NONE) || (status == Core::ERROR_INPROGRESS)) {
+        for (const Peer& peer : _peers) {
+            if ((peer.HasSamples() == true) && ((best == nullptr) || (peer.Best().Delay < best->Best().Delay))) {
+                best = &peer;
+            }
+        }
 
-                        activated = true;
-                        _fired = false;
-                        Trigger();
-                    }
-                    else {
-                        TRACE(Trace::Warning, (_T("Could not open connection to NTP Server [%s]"), (*_serverIndex).c_str()));
-                    }
-                }
-                else {
-                    TRACE(Trace::Warning, (_T("Could not resolve NTP Server [%s]"), (*_serverIndex).c_str()));
-                }
+        _state = SUCCESS;
+
+        // We don't need the socket anymore, so close it
+        TRACE_L1("TimeSync: %s", "Closing socket, no longer needed");
+        Close(0);
+
+        if (best != nullptr) {
+            // The clock was set with the first sample, this is what remains after filtering.
+            int64_t correction = SecondsToTicks(best->Best().Offset);
+
+            _syncedTimestamp = Core::Time(static_cast<uint64_t>(Core::Time::Now().Ticks() + correction));
+            _source = best->Hostname();
+
+            TRACE(Trace::Information, (_T("TimeSync: Refined with [%s], correction %lf s, delay %lf s"), _source.c_str(), best->Best().Offset, best->Best().Delay));
+
+            if (_reported == true) {
+                // The clients already heard about this sync, only step the clock by what was left.
+                Core::SystemInfo::Instance().SetTime(_syncedTimestamp);
             }
-            while ((activated == false) && ( ((lastonetried != 0) && (lastonetried != _serverIndex.Index())) ||
-                                             ((lastonetried == 0) && (_serverIndex.Index() != _serverIndex.Count())) 
-                                           ) );
         }
 
-        return (activated);
+        Update();
     }
 
     void NTPClient::Update()
@@ -339,17 +416,21 @@ namespace Plugin {
 
         // runs always in the context of the adminlock
 
-        if(_state == FAILED){
-            TRACE(Trace::Error, (_T("Could not determine a valid time")));
-        }
+        if (_reported == false) {
+            // Only report once per sync, the refinement and the final state follow the first report.
+            _reported = true;
 
-        std::list<Exchange::ITimeSync::INotification*>::iterator index(_clients.begin());
+            if(_state == FAILED){
+                TRACE(Trace::Error, (_T("Could not determine a valid time")));
+            }
 
-        while (index != _clients.end()) {
-            (*index)->Completed();
-            index++;
-        }
+            std::list<Exchange::ITimeSync::INotification*>::iterator index(_clients.begin());
 
+            while (index != _clients.end()) {
+                (*index)->Completed();
+                index++;
+            }
+        }
     }
 
     void NTPClient::Dispatch()
@@ -361,14 +442,17 @@ namespace Plugin {
         switch (_state) {
         case SENDREQUEST: {
             // This case means that nothing has started yet, let reset the list of servers and start at the beginning...
-            _serverIndex.Reset(0);
+            for (Peer& peer : _peers) {
+                peer.Clear();
+            }
+            _cursor = 0;
             _state = INPROGRESS;
             _currentAttempt = _retryAttempts;
         }
         case INPROGRESS: {
-            // If we end up here in this state, it means that the package was send but no response was received,
+            // If we end up here in this state, it means that the requests were send but no response was received,
             // or a response was received but is was not properly formatted...
-            // Lets move to the next server in the list, see if that one responds correctly, if we tried all servers let's
+            // Lets move to the next batch of servers in the list, see if those respond correctly, if we tried all servers let's
             // start at the first one again, this time it might work
             if (FireRequest() == true) {
               result = WaitForResponse;
@@ -389,6 +473,24 @@ namespace Plugin {
             }
             break;
         }
+        case REFINE: {
+            if (_rounds == 0) {
+                // Report the first time we got, the clock is stepped now so earlier samples are meaningless.
+                Update();
+
+                for (Peer& peer : _peers) {
+                    peer.Clear();
+                }
+            }
+
+            if ((_rounds < RefineRounds) && (FireRequest() == true)) {
+                _rounds++;
+                result = WaitForResponse;
+            } else {
+                Conclude();
+            }
+            break;
+        }
         case FAILED:
         case SUCCESS: {
             Update();
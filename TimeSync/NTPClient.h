@@ -35,8 +35,6 @@ namespace Plugin {
         using SourceIterator = Core::JSON::ArrayType<Core::JSON::String>::Iterator;
 
     private:
-        using ServerList = std::vector<string>;
-        using ServerIterator = Core::IteratorType<const ServerList, const string&, ServerList::const_iterator>;
         using DataFrame = Core::FrameType<0>;
 
         // This enum tracks the state for actions begin performed. As the Worker() method is re-entered,
@@ -44,7 +42,8 @@ namespace Plugin {
         enum state {
             INITIAL, // Initial state
             SENDREQUEST, // Let send out an NTP request to a legitimate server.
-            INPROGRESS, // A request has been sent to a NTP server, waiting for a response
+            INPROGRESS, // Requests have been sent to a set of NTP servers, waiting for the first response
+            REFINE, // A first time has been reported, collecting more samples from the fastest servers
             SUCCESS, // Action succeeded, we received a valid response from an NTP server
             FAILED // Action failed, we did not receive any valid response from any of the NTP servers
         };
@@ -328,6 +327,137 @@ namespace Plugin {
                 // bit (NTP time)
         };
 
+        // Every configured NTP server is a peer. For each peer the last few (offset, delay) samples are kept
+        // and, as in the NTP clock filter, the offset of the sample with the lowest round-trip delay is trusted,
+        // as that one suffered the least from queuing in the network.
+        class Peer {
+        public:
+            static constexpr uint8_t FilterDepth = 8;
+
+            struct Sample {
+                double Offset;
+                double Delay;
+            };
+
+        public:
+            Peer() = delete;
+            Peer& operator=(const Peer&) = delete;
+
+            Peer(const string& hostname)
+                : _hostname(hostname)
+                , _remote()
+                , _samples()
+                , _count(0)
+                , _head(0)
+                , _delay(-1.0)
+                , _pending(false)
+                , _queued(false)
+            {
+            }
+            Peer(const Peer& copy)
+                : _hostname(copy._hostname)
+                , _remote(copy._remote)
+                , _samples()
+                , _count(0)
+                , _head(0)
+                , _delay(copy._delay)
+                , _pending(false)
+                , _queued(false)
+            {
+            }
+            ~Peer()
+            {
+            }
+
+        public:
+            const string& Hostname() const
+            {
+                return (_hostname);
+            }
+            const Core::NodeId& Remote() const
+            {
+                return (_remote);
+            }
+            bool Resolve()
+            {
+                if (_remote.IsValid() == false) {
+                    _remote = Core::NodeId(_hostname.c_str(), Core::NodeId::TYPE_IPV4);
+                }
+                return (_remote.IsValid());
+            }
+            // Delay of the best sample seen from this server, negative if it never answered.
+            double Delay() const
+            {
+                return (_delay);
+            }
+            bool IsPending() const
+            {
+                return (_pending);
+            }
+            bool IsQueued() const
+            {
+                return (_queued);
+            }
+            void Request()
+            {
+                _pending = true;
+                _queued = true;
+            }
+            void Sent()
+            {
+                _queued = false;
+            }
+            void Clear()
+            {
+                _count = 0;
+                _head = 0;
+                _pending = false;
+                _queued = false;
+            }
+            void Add(const double offset, const double delay)
+            {
+                _samples[_head].Offset = offset;
+                _samples[_head].Delay = delay;
+                _head = (_head + 1) % FilterDepth;
+                if (_count < FilterDepth) {
+                    _count++;
+                }
+                _pending = false;
+
+                if ((_delay < 0) || (delay < _delay)) {
+                    _delay = delay;
+                }
+            }
+            bool HasSamples() const
+            {
+                return (_count != 0);
+            }
+            const Sample& Best() const
+            {
+                ASSERT(_count != 0);
+
+                uint8_t best = 0;
+                for (uint8_t index = 1; index < _count; index++) {
+                    if (_samples[index].Delay < _samples[best].Delay) {
+                        best = index;
+                    }
+                }
+                return (_samples[best]);
+            }
+
+        private:
+            string _hostname;
+            Core::NodeId _remote;
+            Sample _samples[FilterDepth];
+            uint8_t _count;
+            uint8_t _head;
+            double _delay;
+            bool _pending;
+            bool _queued;
+        };
+
+        using Peers = std::vector<Peer>;
+
         class Activity : public Core::IDispatchType<void> {
         private:
             Activity() = delete;
@@ -363,7 +493,7 @@ namespace Plugin {
         virtual ~NTPClient();
 
     public:
-        void Initialize(SourceIterator& sources, const uint16_t retries, const uint16_t delay);
+        void Initialize(SourceIterator& sources, const uint16_t retries, const uint16_t delay, const uint8_t parallel);
         virtual void Register(Exchange::ITimeSync::INotification* notification) override;
         virtual void Unregister(Exchange::ITimeSync::INotification* notification) override;
 
@@ -394,18 +524,22 @@ namespace Plugin {
         void Update();
         void Dispatch();
         bool FireRequest();
+        void Conclude();
 
     private:
         Core::CriticalSection _adminLock;
         NTPPacket _packet;
         Core::Time _syncedTimestamp;
         state _state;
-        bool _fired;
         uint32_t _WaitForNetwork;
         uint32_t _retryAttempts;
         uint32_t _currentAttempt;
-        ServerList _servers;
-        ServerIterator _serverIndex;
+        uint8_t _parallel;
+        uint8_t _rounds;
+        bool _reported;
+        uint32_t _cursor;
+        Peers _peers;
+        string _source;
         Core::ProxyType<Core::IDispatchType<void>> _activity;
         std::list<Exchange::ITimeSync::INotification*> _clients;
     };
@@ -65,7 +65,7 @@ namespace Plugin {
 
         NTPClient::SourceIterator index(config.Sources.Elements());
 
-        static_cast<NTPClient*>(_client)->Initialize(index, config.Retries.Value(), config.Interval.Value());
+        static_cast<NTPClient*>(_client)->Initialize(index, config.Retries.Value(), config.Interval.Value(), config.Parallel.Value());
 
         ASSERT(service != nullptr);
         ASSERT(_service == nullptr);
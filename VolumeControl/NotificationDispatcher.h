@@ -0,0 +1,156 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <vector>
+
+namespace WPEFramework {
+namespace Plugin {
+
+    // Delivers property change notifications to the registered sinks from the worker pool, so the
+    // thread reporting the change (typically a platform callback) never waits for (remote) sinks.
+    // Changes posted within the window are coalesced per property, the last value wins. Properties
+    // are delivered in the order of their key, not in the order they changed.
+    template <typename INTERFACE, typename PROPERTY = uint8_t>
+    class NotificationDispatcher : private Core::WorkerPool::JobType<NotificationDispatcher<INTERFACE, PROPERTY>&> {
+    public:
+        using Deliver = std::function<void(INTERFACE*)>;
+
+    private:
+        using Job = Core::WorkerPool::JobType<NotificationDispatcher<INTERFACE, PROPERTY>&>;
+        using Sinks = std::vector<INTERFACE*>;
+        using Pending = std::map<PROPERTY, Deliver>;
+
+    public:
+        NotificationDispatcher() = delete;
+        NotificationDispatcher(const NotificationDispatcher&) = delete;
+        NotificationDispatcher& operator=(const NotificationDispatcher&) = delete;
+
+        // The window (ms) is counted from the first change after a delivery, 0 delivers as soon as
+        // a worker is available (changes arriving before that are still coalesced).
+        explicit NotificationDispatcher(const uint32_t window)
+            : Job(*this)
+            , _lock()
+            , _window(window)
+            , _sinks()
+            , _pending()
+        {
+        }
+        ~NotificationDispatcher()
+        {
+            Job::Revoke();
+
+            for (INTERFACE* sink : _sinks) {
+                sink->Release();
+            }
+        }
+
+    public:
+        void Register(INTERFACE* sink)
+        {
+            ASSERT(sink != nullptr);
+
+            _lock.Lock();
+
+            // Make sure a sink is not registered multiple times.
+            ASSERT(std::find(_sinks.begin(), _sinks.end(), sink) == _sinks.end());
+
+            sink->AddRef();
+            _sinks.push_back(sink);
+
+            _lock.Unlock();
+        }
+        bool Unregister(const INTERFACE* sink)
+        {
+            bool result = false;
+
+            _lock.Lock();
+
+            typename Sinks::iterator index(std::find(_sinks.begin(), _sinks.end(), sink));
+
+            if (index != _sinks.end()) {
+                (*index)->Release();
+                _sinks.erase(index);
+                result = true;
+            }
+
+            _lock.Unlock();
+
+            return (result);
+        }
+        void Post(const PROPERTY property, const Deliver& deliver)
+        {
+            _lock.Lock();
+
+            const bool idle = _pending.empty();
+
+            _pending[property] = deliver;
+
+            if (idle == true) {
+                if (_window == 0) {
+                    Job::Submit();
+                } else {
+                    Job::Schedule(Core::Time::Now().Add(_window));
+                }
+            }
+
+            _lock.Unlock();
+        }
+
+    private:
+        friend class Core::ThreadPool::JobType<NotificationDispatcher<INTERFACE, PROPERTY>&>;
+        void Dispatch()
+        {
+            Pending pending;
+            Sinks sinks;
+
+            _lock.Lock();
+
+            pending.swap(_pending);
+            sinks = _sinks;
+            for (INTERFACE* sink : sinks) {
+                sink->AddRef();
+            }
+
+            _lock.Unlock();
+
+            for (const std::pair<const PROPERTY, Deliver>& entry : pending) {
+                for (INTERFACE* sink : sinks) {
+                    entry.second(sink);
+                }
+            }
+
+            for (INTERFACE* sink : sinks) {
+                sink->Release();
+            }
+        }
+
+    private:
+        Core::CriticalSection _lock;
+        const uint32_t _window;
+        Sinks _sinks;
+        Pending _pending;
+    };
+
+} // namespace Plugin
+} // namespace WPEFramework
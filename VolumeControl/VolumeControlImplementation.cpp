@@ -27,7 +27,7 @@ namespace Plugin {
     SERVICE_REGISTRATION(VolumeControlImplementation, 1, 0);
 
     VolumeControlImplementation::VolumeControlImplementation()
-        : _adminLock{}
+        : _notifications{NotificationWindow}
         , _platform{std::move(VolumeControlPlatform::Create(
                                 [this]() { NotifyVolumeChange(); },
                                 [this]() { NotifyMutedChange(); }))}
@@ -39,21 +39,14 @@ namespace Plugin {
     void VolumeControlImplementation::Register(Exchange::IVolumeControl::INotification* notification)
     {
         ASSERT(notification);
-        _adminLock.Lock();
-        notification->AddRef();
-        _notifications.push_back(notification);
-        _adminLock.Unlock();
+        _notifications.Register(notification);
     }
 
     void VolumeControlImplementation::Unregister(const Exchange::IVolumeControl::INotification* notification)
     {
         ASSERT(notification);
-        _adminLock.Lock();
-        auto item = std::find(_notifications.begin(), _notifications.end(), notification);
-        ASSERT(item != _notifications.end());
-        _notifications.erase(item);
-        (*item)->Release();
-        _adminLock.Unlock();
+        bool VARIABLE_IS_NOT_USED removed = _notifications.Unregister(notification);
+        ASSERT(removed == true);
     }
 
 
@@ -81,20 +74,18 @@ namespace Plugin {
 
     void VolumeControlImplementation::NotifyVolumeChange()
     {
-        _adminLock.Lock();
-        for (auto* notification : _notifications) {
-            notification->Volume(_platform->Volume());
-        }
-        _adminLock.Unlock();
+        const uint8_t volume = _platform->Volume();
+        _notifications.Post(VOLUME, [volume](Exchange::IVolumeControl::INotification* notification) {
+            notification->Volume(volume);
+        });
     }
 
     void VolumeControlImplementation::NotifyMutedChange()
     {
-        _adminLock.Lock();
-        for (auto* notification : _notifications) {
-            notification->Muted(_platform->Muted());
-        }
-        _adminLock.Unlock();
+        const bool muted = _platform->Muted();
+        _notifications.Post(MUTED, [muted](Exchange::IVolumeControl::INotification* notification) {
+            notification->Muted(muted);
+        });
     }
 
 }  // namespace Plugin
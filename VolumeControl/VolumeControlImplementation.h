@@ -24,12 +24,23 @@
 #include "Module.h"
 #include <interfaces/IVolumeControl.h>
 
+#include "NotificationDispatcher.h"
+
 namespace WPEFramework {
 namespace Plugin {
 
     class VolumeControlPlatform;
 
     class VolumeControlImplementation : public Exchange::IVolumeControl {
+    private:
+        // Holding a volume key produces a burst of changes, the sinks get the latest value at most once per window (ms).
+        static constexpr uint32_t NotificationWindow = 50;
+
+        enum property : uint8_t {
+            VOLUME,
+            MUTED
+        };
+
     public:
         VolumeControlImplementation(const VolumeControlImplementation&) = delete;
         VolumeControlImplementation& operator=(const VolumeControlImplementation&) = delete;
@@ -53,8 +64,7 @@ namespace Plugin {
         void NotifyMutedChange();
         void NotifyVolumeChange();
 
-        Core::CriticalSection _adminLock;
-        std::vector<Exchange::IVolumeControl::INotification*> _notifications;
+        NotificationDispatcher<Exchange::IVolumeControl::INotification> _notifications;
 
         std::unique_ptr<VolumeControlPlatform> _platform;
     };
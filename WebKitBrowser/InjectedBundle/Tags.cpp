@@ -30,6 +30,8 @@ const char* const BridgeObjectQuery = "BridgeObjectQuery";
 const char* const BridgeObjectReply = "BridgeObjectReply";
 const char* const BridgeObjectEvent = "BridgeObjectEvent";
 const char* const Headers = "Headers";
+const char* const Whitelist = "Whitelist";
+const char* const Milestone = "Milestone";
 
 } } ;
 
@@ -27,6 +27,8 @@
 using std::unique_ptr;
 using std::vector;
 
+#include <algorithm>
+
 // For now we report errors to stderr.
 // TODO: does the injected bundle need a more formal way of dealing with errors?
 #include <iostream>
@@ -36,6 +38,96 @@ using std::endl;
 namespace WPEFramework {
 namespace WebKit {
 
+    // Splits "<protocol>://<host>[:port][/path]" in its protocol and (lower case) host.
+    static bool SplitDomain(const string& domain, string& protocol, string& host)
+    {
+        size_t separator = domain.find("://");
+
+        if ((separator != string::npos) && (separator > 0)) {
+            size_t begin = separator + 3;
+            size_t end;
+
+            if ((begin < domain.length()) && (domain[begin] == '[')) {
+                // An IPv6 literal, the colons in between the brackets are not a port separator.
+                end = domain.find(']', begin);
+                end = (end == string::npos ? begin : end + 1);
+            } else {
+                end = domain.find_first_of(":/?#", begin);
+            }
+
+            protocol = domain.substr(0, separator);
+            host = domain.substr(begin, (end == string::npos ? end : end - begin));
+
+            std::transform(protocol.begin(), protocol.end(), protocol.begin(), ::tolower);
+            std::transform(host.begin(), host.end(), host.begin(), ::tolower);
+        }
+
+        return ((separator != string::npos) && (separator > 0) && (host.empty() == false));
+    }
+
+    // An IPv6 ("[::1]") or IPv4 ("10.0.0.1") literal is matched as a whole, it has no labels or subdomains.
+    static bool IsAddressLiteral(const string& host)
+    {
+        return ((host[0] == '[') || (host.find_first_not_of("0123456789.") == string::npos));
+    }
+
+    void WhiteListedOriginDomainsList::DomainTrie::Insert(const string& protocol, const string& host, const bool subDomains)
+    {
+        Node* node = &_root;
+        size_t end = host.length();
+        const bool literal = IsAddressLiteral(host);
+        const bool allowSubDomains = ((subDomains == true) && (literal == false));
+
+        if (literal == true) {
+            node = &(node->Children[host]);
+            end = 0;
+        }
+
+        // Walk the labels from the top level domain down.
+        while (end > 0) {
+            size_t begin = host.rfind('.', end - 1);
+
+            if (begin == string::npos) {
+                node = &(node->Children[host.substr(0, end)]);
+                end = 0;
+            } else {
+                node = &(node->Children[host.substr(begin + 1, end - begin - 1)]);
+                end = begin;
+            }
+        }
+
+        std::pair<std::map<string, bool>::iterator, bool> entry(node->Protocols.emplace(protocol, allowSubDomains));
+
+        if (entry.second == false) {
+            entry.first->second = (entry.first->second || allowSubDomains);
+        }
+    }
+
+    void WhiteListedOriginDomainsList::DomainTrie::Compile(Domains& domains) const
+    {
+        Compile(_root, string(), std::set<string>(), domains);
+    }
+
+    /* static */ void WhiteListedOriginDomainsList::DomainTrie::Compile(const Node& node, const string& host, const std::set<string>& covered, Domains& domains)
+    {
+        std::set<string> scope(covered);
+
+        for (const std::pair<const string, bool>& protocol : node.Protocols) {
+            // If a parent domain allows all its subdomains for this protocol, WebKit does not need this one.
+            if (covered.find(protocol.first) == covered.end()) {
+                domains.push_back({ protocol.first, host, protocol.second });
+
+                if (protocol.second == true) {
+                    scope.insert(protocol.first);
+                }
+            }
+        }
+
+        for (const std::pair<const string, Node>& child : node.Children) {
+            Compile(child.second, (host.empty() == true ? child.first : child.first + '.' + host), scope, domains);
+        }
+    }
+
     // Parses JSON containing white listed CORS origin-domain pairs.
     static void ParseWhiteList(const string& jsonString, WhiteListedOriginDomainsList::WhiteMap& info)
     {
@@ -75,21 +167,32 @@ namespace WebKit {
         Core::JSON::ArrayType<JSONEntry> entries;
         entries.FromString(jsonString);
         Core::JSON::ArrayType<JSONEntry>::Iterator originIndex(entries.Elements());
+        std::map<string, WhiteListedOriginDomainsList::DomainTrie> tries;
 
         while (originIndex.Next() == true) {
 
             if ((originIndex.Current().Origin.IsSet() == true) && (originIndex.Current().Domain.IsSet() == true)) {
 
-                WhiteListedOriginDomainsList::Domains& domains(info[originIndex.Current().Origin.Value()]);
+                WhiteListedOriginDomainsList::DomainTrie& trie(tries[originIndex.Current().Origin.Value()]);
 
                 Core::JSON::ArrayType<Core::JSON::String>::Iterator domainIndex(originIndex.Current().Domain.Elements());
                 bool subDomain(originIndex.Current().SubDomain.Value());
 
                 while (domainIndex.Next()) {
-                    domains.emplace_back(subDomain, domainIndex.Current().Value());
+                    string protocol, host;
+
+                    if (SplitDomain(domainIndex.Current().Value(), protocol, host) == true) {
+                        trie.Insert(protocol, host, subDomain);
+                    } else {
+                        cerr << "Invalid domain in white list: " << domainIndex.Current().Value() << endl;
+                    }
                 }
             }
         }
+
+        for (const std::pair<const string, WhiteListedOriginDomainsList::DomainTrie>& trie : tries) {
+            trie.second.Compile(info[trie.first]);
+        }
     }
 
     // Gets white list from WPEFramework via synchronous message.
@@ -126,20 +229,22 @@ namespace WebKit {
     // Adds stored entries to WebKit.
     void WhiteListedOriginDomainsList::AddWhiteListToWebKit(WKBundleRef bundle)
     {
+        if (_applied == true) {
+            return;
+        }
+
         WhiteMap::const_iterator index(_whiteMap.begin());
+        uint32_t count = 0;
 
         while (index != _whiteMap.end()) {
 
 #ifdef WEBKIT_GLIB_API
             WebKitSecurityOrigin* origin = webkit_security_origin_new_for_uri(index->first.c_str());
 
-            for (const Domain& domainIndex : index->second) {
+            for (const Domain& domain : index->second) {
 
-                WebKitSecurityOrigin* domain = webkit_security_origin_new_for_uri(domainIndex.second.c_str());
                 webkit_web_extension_add_origin_access_whitelist_entry(bundle,
-                        origin, webkit_security_origin_get_protocol(domain),
-                        webkit_security_origin_get_host(domain), domainIndex.first);
-                webkit_security_origin_unref(domain);
+                        origin, domain.Protocol.c_str(), domain.Host.c_str(), domain.SubDomains);
             }
             webkit_security_origin_unref(origin);
 #else
@@ -147,25 +252,24 @@ namespace WebKit {
 
             for (const Domain& domain : index->second) {
 
-                std::string utf8Domain = Core::ToString(domain.second.c_str());
-                WKURLRef url = WKURLCreateWithUTF8CString(utf8Domain.c_str());
-                WKStringRef protocol = WKURLCopyScheme(url);
-                WKStringRef host = WKURLCopyHostName(url);
-
-                WKRelease(url);
+                WKStringRef protocol = WKStringCreateWithUTF8CString(domain.Protocol.c_str());
+                WKStringRef host = WKStringCreateWithUTF8CString(domain.Host.c_str());
 
-                WKBundleAddOriginAccessWhitelistEntry(bundle, wkOrigin, protocol, host, domain.first);
+                WKBundleAddOriginAccessWhitelistEntry(bundle, wkOrigin, protocol, host, domain.SubDomains);
 
                 WKRelease(host);
                 WKRelease(protocol);
-
-                cerr << "Added origin->domain pair to WebKit white list: " << index->first << " -> " << domain.second << endl;
             }
 
             WKRelease(wkOrigin);
 #endif
+            count += static_cast<uint32_t>(index->second.size());
             index++;
         }
+
+        _applied = true;
+
+        cerr << "Added " << count << " origin->domain pairs for " << _whiteMap.size() << " origins to WebKit white list." << endl;
     }
 }
 }
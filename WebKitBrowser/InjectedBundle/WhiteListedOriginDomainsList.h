@@ -29,6 +29,7 @@ typedef WebKitWebExtension* WKBundleRef;
 #include <WPE/WebKit.h>
 #endif
 
+#include <set>
 #include <vector>
 
 namespace WPEFramework {
@@ -40,10 +41,48 @@ namespace WebKit {
         WhiteListedOriginDomainsList& operator=(const WhiteListedOriginDomainsList&) = delete;
 
     public:
-        typedef std::pair<bool, string> Domain;
+        // A compiled whitelist entry, ready to be handed over to WebKit.
+        struct Domain {
+            string Protocol;
+            string Host;
+            bool SubDomains;
+        };
         typedef std::vector<Domain> Domains;
         typedef std::map<string, Domains> WhiteMap;
 
+        // Domains are stored in a trie on their reversed labels (com -> example -> www), so an entry
+        // that is already covered by a parent domain allowing subdomains (for the same protocol) or
+        // a duplicate is dropped when the trie is compiled to the list of entries for WebKit.
+        class DomainTrie {
+        private:
+            struct Node {
+                std::map<string, Node> Children;
+                std::map<string, bool> Protocols;
+            };
+
+        public:
+            DomainTrie(const DomainTrie&) = delete;
+            DomainTrie& operator=(const DomainTrie&) = delete;
+
+            DomainTrie()
+                : _root()
+            {
+            }
+            ~DomainTrie()
+            {
+            }
+
+        public:
+            void Insert(const string& protocol, const string& host, const bool subDomains);
+            void Compile(Domains& domains) const;
+
+        private:
+            static void Compile(const Node& node, const string& host, const std::set<string>& covered, Domains& domains);
+
+        private:
+            Node _root;
+        };
+
     public:
         static std::unique_ptr<WhiteListedOriginDomainsList> RequestFromWPEFramework(const char* whitelist = nullptr);
         ~WhiteListedOriginDomainsList()
@@ -51,14 +90,30 @@ namespace WebKit {
         }
 
     public:
+        // Only the first call pushes the entries to WebKit, WebKit keeps them for all pages of the
+        // bundle. A new list (generation) should be requested when the whitelist changes.
         void AddWhiteListToWebKit(WKBundleRef bundle);
 
+        uint64_t Generation() const
+        {
+            return (_generation);
+        }
+        void Generation(const uint64_t generation)
+        {
+            _generation = generation;
+        }
+
     private:
         WhiteListedOriginDomainsList()
+            : _whiteMap()
+            , _generation(0)
+            , _applied(false)
         {
         }
 
         WhiteMap _whiteMap;
+        uint64_t _generation;
+        bool _applied;
     };
 }
 }
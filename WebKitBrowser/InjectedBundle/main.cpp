@@ -149,12 +149,27 @@ public:
 
     void WhiteList(WKBundleRef bundle)
     {
-        // Whitelist origin/domain pairs for CORS, if set.
+        // Whitelist origin/domain pairs for CORS, if set. This is only done once, WebKit keeps them
+        // for all pages (and navigations) of this bundle.
         if (_whiteListedOriginDomainPairs) {
             _whiteListedOriginDomainPairs->AddWhiteListToWebKit(bundle);
         }
     }
 
+#ifndef WEBKIT_GLIB_API
+    // The plugin signals a new generation of the whitelist, only then it is fetched (and compiled) again.
+    void WhiteList(WKBundleRef bundle, const uint64_t generation)
+    {
+        if ((!_whiteListedOriginDomainPairs) || (_whiteListedOriginDomainPairs->Generation() < generation)) {
+            _whiteListedOriginDomainPairs = WhiteListedOriginDomainsList::RequestFromWPEFramework();
+            _whiteListedOriginDomainPairs->Generation(generation);
+
+            WKBundleResetOriginAccessWhitelists(bundle);
+            _whiteListedOriginDomainPairs->AddWhiteListToWebKit(bundle);
+        }
+    }
+#endif
+
 #ifdef WEBKIT_GLIB_API
 
 private:
@@ -298,6 +313,47 @@ static void InjectInJSWorld(ClassDefinition& classDef, WKBundleFrameRef frame, W
     JSStringRelease(extensionString);
 }
 
+// Not part of the public JavaScriptCore API, but exported by it (JSBasePrivate.h).
+extern "C" JSObjectRef JSGetMemoryUsageStatistics(JSContextRef ctx);
+
+// Page milestones are only known in the WebProcess, pass them on to WebKitImplementation.
+static void PostMilestone(const char name[], const uint64_t value)
+{
+    WKStringRef messageName = WKStringCreateWithUTF8CString(Tags::Milestone);
+    WKStringRef milestoneName = WKStringCreateWithUTF8CString(name);
+    WKUInt64Ref milestoneValue = WKUInt64Create(value);
+    WKMutableArrayRef messageBody = WKMutableArrayCreate();
+
+    WKArrayAppendItem(messageBody, milestoneName);
+    WKArrayAppendItem(messageBody, milestoneValue);
+
+    WKBundlePostMessage(g_Bundle, messageName, messageBody);
+
+    WKRelease(messageBody);
+    WKRelease(milestoneValue);
+    WKRelease(milestoneName);
+    WKRelease(messageName);
+}
+
+static uint64_t JavaScriptHeap(WKBundleFrameRef frame)
+{
+    uint64_t result = 0;
+    JSGlobalContextRef context = WKBundleFrameGetJavaScriptContext(frame);
+    JSObjectRef statistics = JSGetMemoryUsageStatistics(context);
+
+    if (statistics != nullptr) {
+        JSStringRef name = JSStringCreateWithUTF8CString("heapSize");
+        JSValueRef value = JSObjectGetProperty(context, statistics, name, nullptr);
+        JSStringRelease(name);
+
+        if ((value != nullptr) && (JSValueIsNumber(context, value) == true)) {
+            result = static_cast<uint64_t>(JSValueToNumber(context, value, nullptr));
+        }
+    }
+
+    return (result);
+}
+
 static bool shouldGoToBackForwardListItem(WKBundlePageRef, WKBundleBackForwardListItemRef item, WKTypeRef*, const void*)
 {
     bool result = true;
@@ -332,7 +388,12 @@ static WKBundlePageLoaderClientV6 s_pageLoaderClient = {
     nullptr, // didReceiveServerRedirectForProvisionalLoadForFrame
     nullptr, // didFailProvisionalLoadWithErrorForFrame
     nullptr, // didCommitLoadForFrame
-    nullptr, // didFinishDocumentLoadForFrame
+    // didFinishDocumentLoadForFrame
+    [](WKBundlePageRef, WKBundleFrameRef frame, WKTypeRef*, const void*) {
+        if (WKBundleFrameIsMainFrame(frame)) {
+            PostMilestone("domcontentloaded", Core::Time::Now().Ticks());
+        }
+    },
     // didFinishLoadForFrame
     [](WKBundlePageRef pageRef, WKBundleFrameRef frame, WKTypeRef*, const void*) {
 
@@ -342,12 +403,21 @@ static WKBundlePageLoaderClientV6 s_pageLoaderClient = {
         g_currentURL = WebKit::Utils::WKStringToString(urlString);
         WKRelease(urlString);
         WKRelease(mainFrameURL);
+
+        if (WKBundleFrameIsMainFrame(frame)) {
+            PostMilestone("jsheap", JavaScriptHeap(frame));
+        }
     },
     nullptr, // didFailLoadWithErrorForFrame
     nullptr, // didSameDocumentNavigationForFrame
     nullptr, // didReceiveTitleForFrame
     nullptr, // didFirstLayoutForFrame
-    nullptr, // didFirstVisuallyNonEmptyLayoutForFrame
+    // didFirstVisuallyNonEmptyLayoutForFrame
+    [](WKBundlePageRef, WKBundleFrameRef frame, WKTypeRef*, const void*) {
+        if (WKBundleFrameIsMainFrame(frame)) {
+            PostMilestone("firstpaint", Core::Time::Now().Ticks());
+        }
+    },
     nullptr, // didRemoveFrameFromHierarchy
     nullptr, // didDisplayInsecureContentForFrame
     nullptr, // didRunInsecureContentForFrame
@@ -435,6 +505,13 @@ static void didReceiveMessageToPage(
         return;
 }
 
+static void didReceiveMessage(WKBundleRef bundle, WKStringRef messageName, WKTypeRef messageBody, const void*)
+{
+    if ((WKStringIsEqualToUTF8CString(messageName, Tags::Whitelist)) && (messageBody != nullptr) && (WKGetTypeID(messageBody) == WKUInt64GetTypeID())) {
+        _wpeFrameworkClient.WhiteList(bundle, WKUInt64GetValue(static_cast<WKUInt64Ref>(messageBody)));
+    }
+}
+
 static void willDestroyPage(WKBundleRef, WKBundlePageRef page, const void*)
 {
     WebKit::RemoveRequestHeaders(page);
@@ -466,7 +543,7 @@ static WKBundleClientV1 s_bundleClient = {
     },
     willDestroyPage, // willDestroyPage
     nullptr, // didInitializePageGroup
-    nullptr, // didReceiveMessage
+    didReceiveMessage, // didReceiveMessage
     didReceiveMessageToPage, // didReceiveMessageToPage
 };
 
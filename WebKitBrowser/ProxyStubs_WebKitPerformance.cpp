@@ -0,0 +1,111 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// The plugin library is loaded by both the framework and the process hosting WebKitImplementation,
+// so registering the proxy and stub here makes the interface available on both sides.
+
+#include "Module.h"
+#include "interfaces/IWebKitPerformance.h"
+
+#include <com/com.h>
+
+namespace WPEFramework {
+
+namespace ProxyStubs {
+
+    // -----------------------------------------------------------------
+    // STUB
+    // -----------------------------------------------------------------
+
+    //
+    // IWebKitPerformance interface stub definitions
+    //
+    // Methods:
+    //  (0) virtual uint32_t PageLoads(string&) const = 0
+    //
+
+    ProxyStub::MethodHandler WebKitPerformanceStubMethods[] = {
+        // virtual uint32_t PageLoads(string&) const = 0
+        //
+        [](Core::ProxyType<Core::IPCChannel>& channel VARIABLE_IS_NOT_USED, Core::ProxyType<RPC::InvokeMessage>& message) {
+            RPC::Data::Input& input(message->Parameters());
+
+            // call implementation
+            const Exchange::IWebKitPerformance* implementation = reinterpret_cast<const Exchange::IWebKitPerformance*>(input.Implementation());
+            ASSERT((implementation != nullptr) && "Null IWebKitPerformance implementation pointer");
+            string param0{};
+            const uint32_t output = implementation->PageLoads(param0);
+
+            // write return values
+            RPC::Data::Frame::Writer writer(message->Response().Writer());
+            writer.Number<const uint32_t>(output);
+            writer.Text(param0);
+        },
+        nullptr
+    }; // WebKitPerformanceStubMethods[]
+
+    // -----------------------------------------------------------------
+    // PROXY
+    // -----------------------------------------------------------------
+
+    class WebKitPerformanceProxy final : public ProxyStub::UnknownProxyType<Exchange::IWebKitPerformance> {
+    public:
+        WebKitPerformanceProxy(const Core::ProxyType<Core::IPCChannel>& channel, void* implementation, const bool otherSideInformed)
+            : BaseClass(channel, implementation, otherSideInformed)
+        {
+        }
+
+        uint32_t PageLoads(string& param0) const override
+        {
+            IPCMessage newMessage(BaseClass::Message(0));
+
+            // invoke the method handler
+            uint32_t output{};
+            if ((output = Invoke(newMessage)) == Core::ERROR_NONE) {
+                // read return values
+                RPC::Data::Frame::Reader reader(newMessage->Response().Reader());
+                output = reader.Number<uint32_t>();
+                param0 = reader.Text();
+            }
+
+            return output;
+        }
+    }; // class WebKitPerformanceProxy
+
+    // -----------------------------------------------------------------
+    // REGISTRATION
+    // -----------------------------------------------------------------
+
+    namespace {
+
+        typedef ProxyStub::UnknownStubType<Exchange::IWebKitPerformance, WebKitPerformanceStubMethods> WebKitPerformanceStub;
+
+        static class Instantiation {
+        public:
+            Instantiation()
+            {
+                RPC::Administrator::Instance().Announce<Exchange::IWebKitPerformance, WebKitPerformanceProxy, WebKitPerformanceStub>();
+            }
+        } ProxyStubRegistration;
+
+    } // namespace
+
+} // namespace ProxyStubs
+
+}
@@ -27,7 +27,6 @@ namespace Plugin {
 
     /* virtual */ const string WebKitBrowser::Initialize(PluginHost::IShell* service)
     {
-        Config config;
         string message;
 
         ASSERT(_service == nullptr);
@@ -38,7 +37,6 @@ namespace Plugin {
         _service = service;
         _skipURL = _service->WebPrefix().length();
 
-        config.FromString(_service->ConfigLine());
         _persistentStoragePath = _service->PersistentPath();
 
         // Register the Connection::Notification stuff. The Remote process might die before we get a
@@ -61,6 +59,9 @@ namespace Plugin {
             } else {
                 _browser->Register(&_notification);
 
+                // The page load history is kept by the implementation, it is optional.
+                _performance = _browser->QueryInterface<Exchange::IWebKitPerformance>();
+
                 const RPC::IRemoteConnection *connection = _service->RemoteConnection(_connectionId);
                 _memory = WPEFramework::WebKitBrowser::MemoryObserver(connection);
                 ASSERT(_memory != nullptr);
@@ -98,6 +99,11 @@ namespace Plugin {
         _browser->Unregister(&_notification);
         _memory->Release();
 
+        if (_performance != nullptr) {
+            _performance->Release();
+            _performance = nullptr;
+        }
+
         PluginHost::IStateControl* stateControl(_browser->QueryInterface<PluginHost::IStateControl>());
 
         // In case WPE rpcprocess crashed, there is no access to the statecontrol interface, check it !!
@@ -213,6 +219,7 @@ namespace Plugin {
         _service->Notify(message);
         event_loadfinished(URL, code);
         URLChange(URL, true);
+        PageLoaded();
     }
 
     void WebKitBrowser::LoadFailed(const string& URL)
@@ -221,6 +228,7 @@ namespace Plugin {
         TRACE(Trace::Information, (_T("LoadFailed: %s"), message.c_str()));
         _service->Notify(message);
         event_loadfailed(URL);
+        PageLoaded();
     }
 
     void WebKitBrowser::URLChange(const string& URL, bool loaded)
@@ -231,6 +239,28 @@ namespace Plugin {
         event_urlchange(URL, loaded);
     }
 
+    void WebKitBrowser::PageLoaded()
+    {
+        string loads;
+
+        // The implementation recorded the load before it notified us, the last entry is this one.
+        if ((_performance != nullptr) && (_performance->PageLoads(loads) == Core::ERROR_NONE)) {
+            Core::JSON::ArrayType<PerformanceData> history;
+            history.FromString(loads);
+
+            Core::JSON::ArrayType<PerformanceData>::Iterator index(history.Elements());
+            const PerformanceData* last = nullptr;
+
+            while (index.Next() == true) {
+                last = &(index.Current());
+            }
+
+            if (last != nullptr) {
+                event_performance(*last);
+            }
+        }
+    }
+
     void WebKitBrowser::VisibilityChange(const bool hidden)
     {
         TRACE(Trace::Information, (_T("Hidden: %s }"), (hidden ? "true" : "false")));
@@ -29,6 +29,8 @@
 #include <interfaces/json/JsonData_WebKitBrowser.h>
 #include <interfaces/json/JsonData_StateControl.h>
 
+#include "interfaces/IWebKitPerformance.h"
+
 namespace WPEFramework {
 
 namespace WebKitBrowser {
@@ -109,6 +111,70 @@ namespace Plugin {
         };
 
     public:
+        class PerformanceData : public Core::JSON::Container {
+        public:
+            PerformanceData()
+                : Core::JSON::Container()
+            {
+                Init();
+            }
+            PerformanceData(const PerformanceData& copy)
+                : Core::JSON::Container()
+                , Url(copy.Url)
+                , Start(copy.Start)
+                , Load(copy.Load)
+                , Firstpaint(copy.Firstpaint)
+                , Domcontentloaded(copy.Domcontentloaded)
+                , Httpstatus(copy.Httpstatus)
+                , Failed(copy.Failed)
+                , Resident(copy.Resident)
+                , Jsheap(copy.Jsheap)
+            {
+                Init();
+            }
+            PerformanceData& operator=(const PerformanceData& rhs)
+            {
+                Url = rhs.Url;
+                Start = rhs.Start;
+                Load = rhs.Load;
+                Firstpaint = rhs.Firstpaint;
+                Domcontentloaded = rhs.Domcontentloaded;
+                Httpstatus = rhs.Httpstatus;
+                Failed = rhs.Failed;
+                Resident = rhs.Resident;
+                Jsheap = rhs.Jsheap;
+                return (*this);
+            }
+            ~PerformanceData()
+            {
+            }
+
+        private:
+            void Init()
+            {
+                Add(_T("url"), &Url);
+                Add(_T("start"), &Start);
+                Add(_T("load"), &Load);
+                Add(_T("firstpaint"), &Firstpaint);
+                Add(_T("domcontentloaded"), &Domcontentloaded);
+                Add(_T("httpstatus"), &Httpstatus);
+                Add(_T("failed"), &Failed);
+                Add(_T("resident"), &Resident);
+                Add(_T("jsheap"), &Jsheap);
+            }
+
+        public:
+            Core::JSON::String Url;
+            Core::JSON::DecUInt64 Start; // Request start, ms since the epoch
+            Core::JSON::DecUInt32 Load; // ms from the request start till the page was loaded (or failed)
+            Core::JSON::DecUInt32 Firstpaint; // ms from the request start till the first visually non-empty layout, 0 if unknown
+            Core::JSON::DecUInt32 Domcontentloaded; // ms from the request start till DOMContentLoaded, 0 if unknown
+            Core::JSON::DecSInt32 Httpstatus;
+            Core::JSON::Boolean Failed;
+            Core::JSON::DecUInt64 Resident; // Resident memory of the browser processes once loaded
+            Core::JSON::DecUInt64 Jsheap; // JavaScript heap size of the page once loaded, 0 if unknown
+        };
+
         class Data : public Core::JSON::Container {
         private:
             Data(const Data&) = delete;
@@ -149,6 +215,7 @@ namespace Plugin {
             , _memory(nullptr)
             , _notification(this)
             , _jsonBodyDataFactory(2)
+            , _performance(nullptr)
         {
         }
 
@@ -217,6 +284,7 @@ namespace Plugin {
         void PageClosure();
         void BridgeQuery(const string& message);
         void StateChange(const PluginHost::IStateControl::state state);
+        void PageLoaded();
 
         // JsonRpc
         void RegisterAll();
@@ -251,6 +319,8 @@ namespace Plugin {
         void event_loadfinished(const string& url, const int32_t& httpstatus);
         void event_loadfailed(const string& url);
         void event_bridgequery(const string& message);
+        uint32_t get_performance(Core::JSON::ArrayType<PerformanceData>& response) const;
+        void event_performance(const PerformanceData& data);
 
     private:
         uint8_t _skipURL;
@@ -261,6 +331,7 @@ namespace Plugin {
         Core::Sink<Notification> _notification;
         Core::ProxyPoolType<Web::JSONBodyType<WebKitBrowser::Data>> _jsonBodyDataFactory;
         string _persistentStoragePath;
+        Exchange::IWebKitPerformance* _performance;
     };
 }
 }
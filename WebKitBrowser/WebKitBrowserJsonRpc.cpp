@@ -50,6 +50,7 @@ namespace Plugin {
         Register<Core::JSON::String,void>(_T("bridgereply"), &WebKitBrowser::endpoint_bridgereply, this);
         Register<Core::JSON::String,void>(_T("bridgeevent"), &WebKitBrowser::endpoint_bridgeevent, this);
         Register<DeleteParamsData,void>(_T("delete"), &WebKitBrowser::endpoint_delete, this);
+        Property<Core::JSON::ArrayType<PerformanceData>>(_T("performance"), &WebKitBrowser::get_performance, nullptr, this);
     }
 
     void WebKitBrowser::UnregisterAll()
@@ -65,6 +66,7 @@ namespace Plugin {
         Unregister(_T("useragent"));
         Unregister(_T("bridgereply"));
         Unregister(_T("delete"));
+        Unregister(_T("performance"));
     }
 
     // API implementation
@@ -474,6 +476,28 @@ namespace Plugin {
         Notify(_T("bridgequery"), params);
     }
 
+    // Property: performance - Timing of the most recent page loads
+    // Return codes:
+    //  - ERROR_NONE: Success
+    //  - ERROR_UNAVAILABLE: The browser does not keep a page load history
+    uint32_t WebKitBrowser::get_performance(Core::JSON::ArrayType<PerformanceData>& response) const
+    {
+        uint32_t result = Core::ERROR_UNAVAILABLE;
+        string loads;
+
+        if ((_performance != nullptr) && ((result = _performance->PageLoads(loads)) == Core::ERROR_NONE)) {
+            response.FromString(loads);
+        }
+
+        return result;
+    }
+
+    // Event: performance - Signals the timing of a page load that just completed
+    void WebKitBrowser::event_performance(const PerformanceData& data)
+    {
+        Notify(_T("performance"), data);
+    }
+
     // Event: statechange - Signals a state change of the service
     void WebKitBrowser::event_statechange(const bool& suspended) /* StateControl */
     {
@@ -20,6 +20,7 @@
 #include <memory>
 #include <utility>
 #include <tuple>
+#include <deque>
 
 #include "Module.h"
 
@@ -59,6 +60,8 @@ namespace Plugin {
 #ifndef WEBKIT_GLIB_API
     static void onDidReceiveSynchronousMessageFromInjectedBundle(WKContextRef context, WKStringRef messageName,
         WKTypeRef messageBodyObj, WKTypeRef* returnData, const void* clientInfo);
+    static void onDidReceiveMessageFromInjectedBundle(WKContextRef context, WKStringRef messageName,
+        WKTypeRef messageBodyObj, const void* clientInfo);
     static void onNotificationShow(WKPageRef page, WKNotificationRef notification, const void* clientInfo);
     static void didStartProvisionalNavigation(WKPageRef page, WKNavigationRef navigation, WKTypeRef userData, const void* clientInfo);
     static void didFinishDocumentLoad(WKPageRef page, WKNavigationRef navigation, WKTypeRef userData, const void* clientInfo);
@@ -109,7 +112,8 @@ namespace Plugin {
 
     static WKContextInjectedBundleClientV1 _handlerInjectedBundle = {
         { 1, nullptr },
-        nullptr, // didReceiveMessageFromInjectedBundle
+        // didReceiveMessageFromInjectedBundle
+        onDidReceiveMessageFromInjectedBundle,
         // didReceiveSynchronousMessageFromInjectedBundle
         onDidReceiveSynchronousMessageFromInjectedBundle,
         nullptr, // getInjectedBundleInitializationUserData
@@ -318,7 +322,7 @@ static GSourceFuncs _handlerIntervention =
         }
     }
 
-    class WebKitImplementation : public Core::Thread, public Exchange::IWebBrowser, public PluginHost::IStateControl {
+    class WebKitImplementation : public Core::Thread, public Exchange::IWebBrowser, public PluginHost::IStateControl, public Exchange::IWebKitPerformance {
     public:
         class BundleConfig : public Core::JSON::Container {
         private:
@@ -447,6 +451,7 @@ static GSourceFuncs _handlerIntervention =
                 , ExecPath()
                 , HTTPProxy()
                 , HTTPProxyExclusion()
+                , PerformanceRecords(16)
             {
                 Add(_T("useragent"), &UserAgent);
                 Add(_T("url"), &URL);
@@ -489,6 +494,7 @@ static GSourceFuncs _handlerIntervention =
                 Add(_T("execpath"), &ExecPath);
                 Add(_T("proxy"), &HTTPProxy);
                 Add(_T("proxyexclusion"), &HTTPProxyExclusion);
+                Add(_T("performancerecords"), &PerformanceRecords);
             }
             ~Config()
             {
@@ -536,6 +542,7 @@ static GSourceFuncs _handlerIntervention =
             Core::JSON::String ExecPath;
             Core::JSON::String HTTPProxy;
             Core::JSON::String HTTPProxyExclusion;
+            Core::JSON::DecUInt16 PerformanceRecords;
         };
 
     private:
@@ -563,6 +570,9 @@ static GSourceFuncs _handlerIntervention =
             , _hidden(false)
             , _time(0)
             , _compliant(false)
+            , _performanceLock()
+            , _navigation()
+            , _pageLoads()
         {
             // Register an @Exit, in case we are killed, with an incorrect ref count !!
             if (atexit(CloseDown) != 0) {
@@ -910,6 +920,9 @@ static GSourceFuncs _handlerIntervention =
             _URL = URL;
             _adminLock.Unlock();
 
+            // The request is where the user starts waiting, not where WebKit starts navigating.
+            NavigationStarted(true);
+
             TRACE(Trace::Information, (_T("New URL: %s"), _URL.c_str()));
 
             if (_context != nullptr) {
@@ -1076,11 +1089,16 @@ static GSourceFuncs _handlerIntervention =
             OnLoadFinished(URL);
         }
 #endif
+        void OnLoadStarted()
+        {
+            NavigationStarted(false);
+        }
         void OnLoadFinished(const string& URL)
         {
             _adminLock.Lock();
 
             _URL = URL;
+            PageLoaded(URL, _httpStatusCode, false);
 
             std::list<Exchange::IWebBrowser::INotification*>::iterator index(_notificationClients.begin());
 
@@ -1095,6 +1113,8 @@ static GSourceFuncs _handlerIntervention =
         {
             _adminLock.Lock();
 
+            PageLoaded(_URL, 0, true);
+
             std::list<Exchange::IWebBrowser::INotification*>::iterator index(_notificationClients.begin());
 
             while (index != _notificationClients.end()) {
@@ -1362,12 +1382,127 @@ static GSourceFuncs _handlerIntervention =
             return _page;
         }
 #endif
+        void OnMilestone(const string& name, const uint64_t value)
+        {
+            _performanceLock.Lock();
+
+            // Milestones can trail the load notification, they then belong to the last recorded load.
+            PageLoad* load = (_navigation.Start != 0 ? &_navigation : (_pageLoads.empty() == false ? &(_pageLoads.back()) : nullptr));
+
+            if (load != nullptr) {
+                if (name == _T("firstpaint")) {
+                    load->FirstPaint = value;
+                } else if (name == _T("domcontentloaded")) {
+                    load->DOMContentLoaded = value;
+                } else if (name == _T("jsheap")) {
+                    load->JSHeap = value;
+                }
+            }
+
+            _performanceLock.Unlock();
+        }
+        uint32_t PageLoads(string& loads) const override
+        {
+            Core::JSON::ArrayType<Plugin::WebKitBrowser::PerformanceData> response;
+
+            _performanceLock.Lock();
+
+            for (const PageLoad& load : _pageLoads) {
+                Plugin::WebKitBrowser::PerformanceData& data(response.Add());
+
+                data.Url = load.URL;
+                data.Start = load.Start / Core::Time::TicksPerMillisecond;
+                data.Load = Elapsed(load.Start, load.End);
+                data.Firstpaint = Elapsed(load.Start, load.FirstPaint);
+                data.Domcontentloaded = Elapsed(load.Start, load.DOMContentLoaded);
+                data.Httpstatus = load.Status;
+                data.Failed = load.Failed;
+                data.Resident = load.Resident;
+                data.Jsheap = load.JSHeap;
+            }
+
+            _performanceLock.Unlock();
+
+            response.ToString(loads);
+
+            return (Core::ERROR_NONE);
+        }
+
         BEGIN_INTERFACE_MAP(WebKitImplementation)
         INTERFACE_ENTRY(Exchange::IWebBrowser)
         INTERFACE_ENTRY(PluginHost::IStateControl)
+        INTERFACE_ENTRY(Exchange::IWebKitPerformance)
         END_INTERFACE_MAP
 
     private:
+        // Timing of a single page load, timestamps in ticks, 0 if not (yet) known.
+        struct PageLoad {
+            string URL;
+            uint64_t Start;
+            uint64_t FirstPaint;
+            uint64_t DOMContentLoaded;
+            uint64_t End;
+            int32_t Status;
+            bool Failed;
+            uint64_t Resident;
+            uint64_t JSHeap;
+            bool Requested;
+        };
+
+        static uint32_t Elapsed(const uint64_t start, const uint64_t end)
+        {
+            return (end > start ? static_cast<uint32_t>((end - start) / Core::Time::TicksPerMillisecond) : 0);
+        }
+        void NavigationStarted(const bool requested)
+        {
+            _performanceLock.Lock();
+
+            // A navigation that follows our own request is that request, keep its start.
+            if ((requested == true) || (_navigation.Requested == false)) {
+                _navigation = PageLoad();
+                _navigation.Start = Core::Time::Now().Ticks();
+            }
+            _navigation.Requested = requested;
+
+            _performanceLock.Unlock();
+        }
+        void PageLoaded(const string& URL, const int32_t status, const bool failed)
+        {
+            if (_config.PerformanceRecords.Value() > 0) {
+                Core::ProcessInfo process;
+                Core::ProcessInfo::Iterator children(process.Id());
+                uint64_t resident = process.Resident();
+
+                // The WebProcess and the NetworkProcess are our children.
+                while (children.Next() == true) {
+                    resident += children.Current().Resident();
+                }
+
+                _performanceLock.Lock();
+
+                PageLoad load(_navigation);
+
+                load.URL = URL;
+                load.End = Core::Time::Now().Ticks();
+                load.Status = status;
+                load.Failed = failed;
+                load.Resident = resident;
+
+                // Without a known start (e.g. a load we did not see starting), the load time is reported as 0.
+                if (load.Start == 0) {
+                    load.Start = load.End;
+                }
+
+                if (_pageLoads.size() >= _config.PerformanceRecords.Value()) {
+                    _pageLoads.pop_front();
+                }
+                _pageLoads.push_back(load);
+
+                _navigation = PageLoad();
+
+                _performanceLock.Unlock();
+            }
+        }
         void Hide()
         {
             if (_context != nullptr) {
@@ -1497,7 +1632,9 @@ static GSourceFuncs _handlerIntervention =
         }
         static void loadChangedCallback(WebKitWebView* webView, WebKitLoadEvent loadEvent, WebKitImplementation* browser)
         {
-            if (loadEvent == WEBKIT_LOAD_FINISHED)
+            if (loadEvent == WEBKIT_LOAD_STARTED)
+                browser->OnLoadStarted();
+            else if (loadEvent == WEBKIT_LOAD_FINISHED)
                 browser->OnLoadFinished();
         }
         static void webProcessTerminatedCallback(WebKitWebView* webView, WebKitWebProcessTerminationReason reason)
@@ -1932,6 +2069,11 @@ static GSourceFuncs _handlerIntervention =
         uint64_t _time;
         bool _compliant;
         Core::StateTrigger<bool> _configurationCompleted { false };
+
+        // Bounded history of the last page loads, oldest first.
+        mutable Core::CriticalSection _performanceLock;
+        PageLoad _navigation;
+        std::deque<PageLoad> _pageLoads;
     };
 
     SERVICE_REGISTRATION(WebKitImplementation, 1, 0);
@@ -1971,6 +2113,27 @@ static GSourceFuncs _handlerIntervention =
         }
     }
 
+    // Handles asynchronous messages from injected bundle.
+    /* static */ void onDidReceiveMessageFromInjectedBundle(WKContextRef context, WKStringRef messageName,
+        WKTypeRef messageBodyObj, const void* clientInfo)
+    {
+        WebKitImplementation* browser = const_cast<WebKitImplementation*>(static_cast<const WebKitImplementation*>(clientInfo));
+
+        if ((WKStringIsEqualToUTF8CString(messageName, Tags::Milestone)) && (messageBodyObj != nullptr) && (WKGetTypeID(messageBodyObj) == WKArrayGetTypeID())) {
+            // A page milestone seen in the WebProcess: its name and its value (a timestamp or a size).
+            WKArrayRef milestone = static_cast<WKArrayRef>(messageBodyObj);
+
+            if (WKArrayGetSize(milestone) == 2) {
+                WKTypeRef name = WKArrayGetItemAtIndex(milestone, 0);
+                WKTypeRef value = WKArrayGetItemAtIndex(milestone, 1);
+
+                if ((WKGetTypeID(name) == WKStringGetTypeID()) && (WKGetTypeID(value) == WKUInt64GetTypeID())) {
+                    browser->OnMilestone(WKStringToString(static_cast<WKStringRef>(name)), WKUInt64GetValue(static_cast<WKUInt64Ref>(value)));
+                }
+            }
+        }
+    }
+
     /* static */ void didStartProvisionalNavigation(WKPageRef page, WKNavigationRef navigation, WKTypeRef userData, const void* clientInfo)
     {
         WebKitImplementation* browser = const_cast<WebKitImplementation*>(static_cast<const WebKitImplementation*>(clientInfo));
@@ -1980,6 +2143,7 @@ static GSourceFuncs _handlerIntervention =
 
         string url = WKStringToString(urlStringRef);
 
+        browser->OnLoadStarted();
         browser->OnURLChanged(url);
 
         WKRelease(urlRef);
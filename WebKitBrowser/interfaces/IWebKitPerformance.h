@@ -0,0 +1,37 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Module.h"
+#include <interfaces/IBrowser.h>
+
+namespace WPEFramework {
+namespace Exchange {
+
+    // Page load history kept by the browser implementation, next to the WebProcess that knows the milestones.
+    struct IWebKitPerformance : virtual public Core::IUnknown {
+        enum { ID = ID_WEB_BROWSER + 0x4001 };
+
+        virtual ~IWebKitPerformance() { }
+
+        // The most recent page loads, oldest first, as a JSON array.
+        virtual uint32_t PageLoads(string& loads /* @out */) const = 0;
+    };
+}}
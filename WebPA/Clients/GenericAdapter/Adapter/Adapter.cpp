@@ -245,7 +245,7 @@ void Adapter::ProcessRequest(char* reqPayload,char* transactionId, char** resPay
 void Adapter::NotificationCallback::NotifyEvent()
 {
     TRACE(Trace::Information, (string(__FUNCTION__)));
-    _signaled.SetEvent();
+    _job.Submit();
 }
 
 void Adapter::Helper::AllocateGetResponse(const req_struct*& reqObj, res_struct*& resObj) const
@@ -507,52 +507,47 @@ WebPAStatus Adapter::Helper::ParameterNamesOfSetters(const req_struct*& reqObj,
 
     return status;
 }
-uint32_t Adapter::NotificationCallback::Worker()
+void Adapter::NotificationCallback::Dispatch()
 {
-    if ((_signaled.Lock(Core::infinite) == Core::ERROR_NONE) && (IsRunning() == true)) {
-        _adminLock.Lock();
-        NotificationHandler* handler = NotificationHandler::GetInstance();
-
-        if (handler) {
-            TRACE(Trace::Information, (_T("Got notification Instance")));
-
-            do {
-                NotifyData* notifyData = handler->NotificationData();
-                if ((nullptr != notifyData) && (IsRunning() == true)) {
-                    std::string notifySource = _parent->_notifier->Source();
-                    std::string notifyDest = _parent->_notifier->Destination();
-
-                    TRACE(Trace::Information, (_T("Calling Process request")));
-
-                    std::string notifyPayload = _parent->_notifier->Process(*notifyData);
-
-                    TRACE(Trace::Information, (_T("Notification Source = %s"), notifySource));
-                    TRACE(Trace::Information, (_T("Notification Dest = %s"), notifyDest));
-
-                    if (notifyPayload.empty() != true) {
-                        TRACE(Trace::Information, (_T("Notification notifyPayload = %s"), notifyPayload));
-                    } else {
-                        TRACE(Trace::Information, (_T("Notification Payload is nullptr")));
-                    }
-                    if ((notifyPayload.empty() != true) && (notifySource.empty() != true) && (notifyDest.empty() != true)) {
-                        if (_parent->_callback)
-                            _parent->_callback->NotifyEvent(notifyPayload, notifySource, notifyDest);
-                    } else {
-                        TRACE(Trace::Error, (_T("Error in generating notification payload")));
-                    }
+    _adminLock.Lock();
+    NotificationHandler* handler = NotificationHandler::GetInstance();
 
-                _parent->FreeNotificationData(notifyData);
+    if (handler) {
+        TRACE(Trace::Information, (_T("Got notification Instance")));
+
+        do {
+            NotifyData* notifyData = handler->NotificationData();
+            if (nullptr != notifyData) {
+                std::string notifySource = _parent->_notifier->Source();
+                std::string notifyDest = _parent->_notifier->Destination();
+
+                TRACE(Trace::Information, (_T("Calling Process request")));
+
+                std::string notifyPayload = _parent->_notifier->Process(*notifyData);
+
+                TRACE(Trace::Information, (_T("Notification Source = %s"), notifySource));
+                TRACE(Trace::Information, (_T("Notification Dest = %s"), notifyDest));
+
+                if (notifyPayload.empty() != true) {
+                    TRACE(Trace::Information, (_T("Notification notifyPayload = %s"), notifyPayload));
                 } else {
-                    TRACE(Trace::Error, (_T("Notification Queue is Empty")));
-                    break;
+                    TRACE(Trace::Information, (_T("Notification Payload is nullptr")));
+                }
+                if ((notifyPayload.empty() != true) && (notifySource.empty() != true) && (notifyDest.empty() != true)) {
+                    if (_parent->_callback)
+                        _parent->_callback->NotifyEvent(notifyPayload, notifySource, notifyDest);
+                } else {
+                    TRACE(Trace::Error, (_T("Error in generating notification payload")));
                 }
-            } while(true);
-        }
-        _adminLock.Unlock();
-    }
-    _signaled.ResetEvent();
 
-    return Core::infinite;
+                _parent->FreeNotificationData(notifyData);
+            } else {
+                TRACE(Trace::Error, (_T("Notification Queue is Empty")));
+                break;
+            }
+        } while(true);
+    }
+    _adminLock.Unlock();
 }
 
 void Adapter::Helper::UpdateRebootReason(const req_struct*& reqObj)
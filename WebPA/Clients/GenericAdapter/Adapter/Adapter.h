@@ -36,7 +36,8 @@ private:
     static constexpr const uint16_t MaxParameterNameLen = 256;
 
 private:
-    class NotificationCallback : public ICallback, public Core::Thread {
+    // Drains the notification queue on the shared worker pool, whenever the handler signals new data.
+    class NotificationCallback : public ICallback {
     public:
         NotificationCallback() = delete;
         NotificationCallback(const NotificationCallback&) = delete;
@@ -45,29 +46,26 @@ private:
     public:
         NotificationCallback(Adapter* parent)
             : _parent(parent)
-            , _signaled(false, true)
+            , _job(*this)
             , _adminLock()
         {
-            Run();
             printf("%s constructed. Line: %d\n", __PRETTY_FUNCTION__,  __LINE__);
         }
         virtual ~NotificationCallback()
         {
-            Stop();
-            _signaled.SetEvent();
-
-            Wait(Thread::BLOCKED | Thread::STOPPED, Core::infinite);
+            _job.Revoke();
             TRACE_L1("%s destructed. Line: %d", __PRETTY_FUNCTION__, __LINE__);
         }
         virtual void NotifyEvent() override;
 
     private:
-    virtual uint32_t Worker();
+        friend Core::ThreadPool::JobType<NotificationCallback&>;
+        void Dispatch();
 
     private:
         Adapter* _parent;
 
-        Core::Event _signaled;
+        Core::WorkerPool::JobType<NotificationCallback&> _job;
         Core::CriticalSection _adminLock;
     };
 
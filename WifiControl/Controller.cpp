@@ -291,11 +291,8 @@ namespace WPASupplicant {
                     _adminLock.Lock();
 
                     // Let see what we need to do with this BSSID, add or remove :-)
-                    if ((event == CTRL_EVENT_BSS_ADDED) && (_detailRequest.Set(bssid) == true)) {
-                        // send out a request for detail.
-                        _adminLock.Unlock();
-                        Submit(&_detailRequest);
-                        _adminLock.Lock();
+                    if (event == CTRL_EVENT_BSS_ADDED) {
+                        Add(bssid);
                     } else if (event == CTRL_EVENT_BSS_REMOVED) {
 
                         NetworkInfoContainer::iterator network(_networks.find(bssid));
@@ -303,6 +300,7 @@ namespace WPASupplicant {
                         if (network != _networks.end()) {
                             _networks.erase(network);
                         }
+                        _changed.erase(bssid);
                     }
 
                     if (_callback != nullptr) {
@@ -340,12 +338,58 @@ namespace WPASupplicant {
     }
     // These methods (add/add/update) are assumed to be running in a locked context.
     // Completion of requests are running in a locked context, so oke to update maps/lists
-    void Controller::Add(const uint64_t& bssid, const NetworkInfo& entry)
+    void Controller::Merge(const NetworkInfoContainer& scanned)
     {
-        TRACE(Communication, (_T("Added SSID: %llX - %s"), bssid, entry.SSID().c_str()));
-        _networks[bssid] = entry;
+        // Whatever the supplicant no longer reports has expired, even if we missed its BSS-REMOVED.
+        NetworkInfoContainer::iterator index(_networks.begin());
+
+        while (index != _networks.end()) {
+            if (scanned.find(index->first) == scanned.end()) {
+                _changed.erase(index->first);
+                index = _networks.erase(index);
+            } else {
+                index++;
+            }
+        }
+
+        for (const std::pair<const uint64_t, NetworkInfo>& entry : scanned) {
+            const NetworkInfo& info(entry.second);
+            NetworkInfoContainer::iterator current(_networks.find(entry.first));
+
+            if (current == _networks.end()) {
+                TRACE(Communication, (_T("Added SSID: %llX - %s"), entry.first, info.SSID().c_str()));
+                _networks.emplace(entry.first, info);
+                _changed.insert(entry.first);
+            } else {
+                const int32_t delta = current->second.Signal() - info.Signal();
+
+                if ((current->second.SSID() != info.SSID()) || (current->second.Frequency() != info.Frequency()) ||
+                    (current->second.Pair() != info.Pair()) || (current->second.Key() != info.Key()) ||
+                    (delta >= SignalDelta) || (-delta >= SignalDelta)) {
+                    _changed.insert(entry.first);
+                }
+
+                // Keeps the details (id, throughput) we already have, no need to ask for them again.
+                current->second.Set(info.SSID(), info.Frequency(), info.Signal(), info.Pair(), info.Key());
+            }
+        }
+
         Reevaluate();
     }
+    void Controller::Add(const uint64_t& bssid)
+    {
+        if (_networks.find(bssid) == _networks.end()) {
+            TRACE(Communication, (_T("Added BSSID: %llX"), bssid));
+
+            // Details follow, Reevaluate() asks for them if the detail request is occupied now.
+            _networks.emplace(bssid, NetworkInfo());
+            _changed.insert(bssid);
+
+            if (_detailRequest.Set(bssid) == true) {
+                Submit(&_detailRequest);
+            }
+        }
+    }
     void Controller::Add(const string& ssid, const bool current, const uint64_t& bssid)
     {
         TRACE(Communication, (_T("Added Network: %s"), ssid.c_str()));
@@ -381,6 +425,7 @@ namespace WPASupplicant {
             index->second.Set(id, ssid, frequency, signal, pairs, keys, throughput);
         } else {
             _networks[bssid] = NetworkInfo(id, ssid, frequency, signal, pairs, keys, throughput);
+            _changed.insert(bssid);
         }
 
         if (scanInProgress == true) {
@@ -23,6 +23,8 @@
 #include "Module.h"
 #include "Network.h"
 
+#include <set>
+
 // Interface specification taken from:
 // https://w1.fi/wpa_supplicant/devel/ctrl_iface_page.html
 
@@ -123,6 +125,8 @@ namespace WPASupplicant {
 
     private:
         static constexpr uint32_t MaxConnectionTime = 3000;
+        // Signal changes (in dBm) below this are not worth reporting as a change of a network.
+        static constexpr int32_t SignalDelta = 6;
 
         Controller() = delete;
         Controller(const Controller&) = delete;
@@ -425,6 +429,7 @@ namespace WPASupplicant {
                     Core::TextFragment data(response.c_str(), response.length());
                     uint32_t marker = data.ForwardFind('\n');
                     uint32_t markerEnd = data.ForwardFind('\n', marker + 1);
+                    NetworkInfoContainer scanned;
 
                     while (marker != markerEnd) {
 
@@ -432,8 +437,11 @@ namespace WPASupplicant {
                         marker = markerEnd;
                         markerEnd = data.ForwardFind('\n', marker + 1);
                         NetworkInfo newEntry;
-                        _parent.Add(Transform(element, newEntry), newEntry);
+                        uint64_t bssid = Transform(element, newEntry);
+                        scanned.emplace(bssid, newEntry);
                     }
+
+                    _parent.Merge(scanned);
                 }
                 if (_eventReporting != static_cast<uint32_t>(~0)) {
                     _parent.Notify(static_cast<events>(_eventReporting));
@@ -988,6 +996,7 @@ namespace WPASupplicant {
         };
         typedef std::map<const uint64_t, NetworkInfo> NetworkInfoContainer;
         typedef std::map<const string, ConfigInfo> EnabledContainer;
+        typedef std::set<uint64_t> ChangedContainer;
         typedef Core::StreamType<Core::SocketDatagram> BaseClass;
 
     protected:
@@ -996,6 +1005,7 @@ namespace WPASupplicant {
             , _adminLock()
             , _requests()
             , _networks()
+            , _changed()
             , _enabled()
             , _error(Core::ERROR_UNAVAILABLE)
             , _callback(nullptr)
@@ -1107,6 +1117,11 @@ namespace WPASupplicant {
             return (_error);
         }
         inline uint32_t Scan()
+        {
+            return (Scan(std::list<uint32_t>(), std::list<string>()));
+        }
+        // Scan only the given frequencies (MHz) and probe for the given SSIDs, an empty list means no restriction.
+        inline uint32_t Scan(const std::list<uint32_t>& frequencies, const std::list<string>& ssids)
         {
 
             uint32_t result = Core::ERROR_INPROGRESS;
@@ -1117,7 +1132,24 @@ namespace WPASupplicant {
             if (activated == true) {
                 result = Core::ERROR_NONE;
 
-                CustomRequest exchange(string(_TXT("SCAN")));
+                string command(_TXT("SCAN"));
+
+                if (frequencies.empty() == false) {
+                    TCHAR separator = '=';
+                    command += _T(" freq");
+                    for (const uint32_t frequency : frequencies) {
+                        command += separator;
+                        command += Core::NumberType<uint32_t>(frequency).Text();
+                        separator = ',';
+                    }
+                }
+                for (const string& ssid : ssids) {
+                    string hex;
+                    Core::ToHexString(reinterpret_cast<const uint8_t*>(ssid.c_str()), static_cast<uint32_t>(ssid.length()), hex);
+                    command += _T(" ssid ") + hex;
+                }
+
+                CustomRequest exchange(command);
 
                 Submit(&exchange);
 
@@ -1241,6 +1273,58 @@ namespace WPASupplicant {
 
             return (result);
         }
+        // Frequencies on which configured networks were seen and the SSIDs of the hidden ones, to
+        // scan for what we can connect to rather than the whole band.
+        inline void Known(std::list<uint32_t>& frequencies, std::list<string>& ssids) const
+        {
+            _adminLock.Lock();
+
+            for (const std::pair<const uint64_t, NetworkInfo>& entry : _networks) {
+                if ((entry.second.Frequency() != 0) && (_enabled.find(entry.second.SSID()) != _enabled.end()) &&
+                    (std::find(frequencies.begin(), frequencies.end(), entry.second.Frequency()) == frequencies.end())) {
+                    frequencies.push_back(entry.second.Frequency());
+                }
+            }
+            for (const std::pair<const string, ConfigInfo>& entry : _enabled) {
+                if (entry.second.Hidden() == true) {
+                    ssids.push_back(entry.first);
+                }
+            }
+
+            _adminLock.Unlock();
+        }
+        // The networks that appeared or changed since the previous call.
+        inline Network::Iterator Changes()
+        {
+            Core::ProxyType<Controller> channel(Core::ProxyType<Controller>(*this));
+            Network::Iterator result;
+
+            _adminLock.Lock();
+
+            for (const uint64_t& bssid : _changed) {
+                NetworkInfoContainer::const_iterator index(_networks.find(bssid));
+
+                if (index != _networks.end()) {
+                    result.Insert(Network(channel,
+                        (index->second.HasId() ? index->second.Id() : static_cast<uint32_t>(~0)),
+                        index->first,
+                        index->second.Frequency(),
+                        index->second.Signal(),
+                        index->second.Pair(),
+                        index->second.Key(),
+                        index->second.SSID(),
+                        index->second.Throughput(),
+                        index->second.IsHidden()));
+                }
+            }
+            _changed.clear();
+
+            _adminLock.Unlock();
+
+            result.Reset();
+
+            return (result);
+        }
         inline Network::Iterator Networks()
         {
             Core::ProxyType<Controller> channel(Core::ProxyType<Controller>(*this));
@@ -1863,7 +1947,8 @@ namespace WPASupplicant {
         }
         // These methods (add/add/update) are assumed to be running in a locked context.
         // Completion of requests are running in a locked context, so oke to update maps/lists
-        void Add(const uint64_t& bssid, const NetworkInfo& entry);
+        void Merge(const NetworkInfoContainer& scanned);
+        void Add(const uint64_t& bssid);
         void Add(const string& ssid, const bool current, const uint64_t& bssid);
         void Update(const string& status);
         void Update(const uint64_t& bssid, const string& ssid, const uint32_t id, uint32_t frequency, const int32_t signal, const uint16_t pairs, const uint32_t keys, const uint32_t throughput);
@@ -1935,6 +2020,7 @@ namespace WPASupplicant {
         mutable Core::CriticalSection _adminLock;
         mutable std::list<Request*> _requests;
         NetworkInfoContainer _networks;
+        ChangedContainer _changed;
         EnabledContainer _enabled;
         uint32_t _error;
         Core::IDispatchType<const events>* _callback;
@@ -119,6 +119,9 @@ namespace Plugin
                         _controller->Scan();
                     }
                     else {
+                        if (_configurationStore.empty() == false) {
+                            _autoConnect.Load(service->PersistentPath() + _T("candidates.json"));
+                        }
                         _autoConnect.Connect(config.Preferred.Value(), 30, ~0);
                     }
                 }
@@ -425,8 +428,9 @@ namespace Plugin
 
         switch (event) {
         case WPASupplicant::Controller::CTRL_EVENT_SCAN_RESULTS: {
+            // Only what appeared or changed, the full list is available through the networks property.
             WifiControl::NetworkList networks;
-            WPASupplicant::Network::Iterator list(_controller->Networks());
+            WPASupplicant::Network::Iterator list(_controller->Changes());
 
             networks.Set(list);
 
@@ -163,8 +163,73 @@ namespace Plugin {
                 uint64_t _bssid;
                 string _ssid;
             };
+            // Where a network was last seen (or associated with), kept across restarts so a
+            // reconnect can go straight to a known BSS instead of waiting for a scan.
+            struct Candidate {
+                string SSID;
+                uint64_t BSSID;
+                uint32_t Frequency;
+                int32_t Signal;
+            };
+            class CandidateList : public Core::JSON::Container {
+            public:
+                class Entry : public Core::JSON::Container {
+                public:
+                    Entry& operator=(const Entry&) = delete;
+
+                    Entry()
+                        : Core::JSON::Container()
+                    {
+                        Init();
+                    }
+                    Entry(const Entry& copy)
+                        : Core::JSON::Container()
+                        , Ssid(copy.Ssid)
+                        , Bssid(copy.Bssid)
+                        , Frequency(copy.Frequency)
+                        , Signal(copy.Signal)
+                    {
+                        Init();
+                    }
+                    ~Entry() override = default;
+
+                private:
+                    void Init()
+                    {
+                        Add(_T("ssid"), &Ssid);
+                        Add(_T("bssid"), &Bssid);
+                        Add(_T("frequency"), &Frequency);
+                        Add(_T("signal"), &Signal);
+                    }
+
+                public:
+                    Core::JSON::String Ssid;
+                    Core::JSON::DecUInt64 Bssid;
+                    Core::JSON::DecUInt32 Frequency;
+                    Core::JSON::DecSInt32 Signal;
+                };
+
+            public:
+                CandidateList(const CandidateList&) = delete;
+                CandidateList& operator=(const CandidateList&) = delete;
+
+                CandidateList()
+                    : Core::JSON::Container()
+                {
+                    Add(_T("candidates"), &Candidates);
+                }
+                ~CandidateList() override = default;
+
+            public:
+                Core::JSON::ArrayType<Entry> Candidates;
+            };
+
             using Job = Core::WorkerPool::JobType<AutoConnect&>;
             using SSIDList = std::list<AccessPoint>;
+            using Candidates = std::list<Candidate>;
+
+            static constexpr uint8_t FullScanInterval = 4;
+            static constexpr uint8_t MaxCandidates = 8;
 
             enum class states : uint8_t
             {
@@ -188,7 +253,11 @@ namespace Plugin {
                 , _ssidList()
                 , _interval(0)
                 , _attempts(0)
+                , _scans(0)
                 , _preferred()
+                , _storage()
+                , _candidates()
+                , _started(0)
             {
             }
             ~AutoConnect() override
@@ -196,6 +265,38 @@ namespace Plugin {
             }
 
         public:
+            // Read the roaming candidates persisted by a previous run.
+            void Load(const string& storage)
+            {
+                _adminLock.Lock();
+
+                _storage = storage;
+                _candidates.clear();
+
+                Core::File file(_storage);
+
+                if (file.Open(true) == true) {
+                    CandidateList list;
+                    Core::OptionalType<Core::JSON::Error> error;
+                    list.IElement::FromFile(file, error);
+
+                    if (error.IsSet() == true) {
+                        SYSLOG(Logging::ParsingError, (_T("Parsing failed with %s"), ErrorDisplayMessage(error.Value()).c_str()));
+                    } else {
+                        auto index(list.Candidates.Elements());
+
+                        while ((index.Next() == true) && (_candidates.size() < MaxCandidates)) {
+                            const CandidateList::Entry& entry(index.Current());
+
+                            if ((entry.Ssid.Value().empty() == false) && (entry.Bssid.Value() != 0)) {
+                                _candidates.push_back({ entry.Ssid.Value(), entry.Bssid.Value(), entry.Frequency.Value(), entry.Signal.Value() });
+                            }
+                        }
+                    }
+                }
+
+                _adminLock.Unlock();
+            }
             uint32_t Connect(const string& SSID, const uint8_t scheduleInterval, const uint32_t attempts) 
             {
                 uint32_t result = Core::ERROR_INPROGRESS;
@@ -209,14 +310,18 @@ namespace Plugin {
                     _preferred = SSID;
                     _attempts = attempts;
                     _interval = (scheduleInterval * 1000);
+                    _started = Core::Time::Now().Ticks();
+
+                    // FastConnect() schedules the job itself when it found a candidate.
+                    if (FastConnect() == false) {
+                        MoveState (states::SCANNING);
 
-                    MoveState (states::SCANNING);
+                        _controller->Scan();
 
-                    _controller->Scan();
+                        _job.Schedule(Core::Time::Now().Add(_interval));
+                    }
 
                     result = Core::ERROR_NONE;
-
-                    _job.Schedule(Core::Time::Now().Add(_interval));
                 }
 
                 _adminLock.Unlock();
@@ -266,11 +371,15 @@ namespace Plugin {
                 if ((reason == WPASupplicant::Controller::WLAN_REASON_NOINFO_GIVEN)
                         && (_state == states::IDLE) && (_attempts > 0)) {
 
-                    MoveState(states::SCANNING);
+                    _started = Core::Time::Now().Ticks();
 
-                    _controller->Scan();
+                    if (FastConnect() == false) {
+                        MoveState(states::SCANNING);
 
-                    _job.Schedule(Core::Time::Now().Add(_interval));
+                        Rescan();
+
+                        _job.Schedule(Core::Time::Now().Add(_interval));
+                    }
                 }
 
                 _adminLock.Unlock();
@@ -294,12 +403,20 @@ namespace Plugin {
 
                     _ssidList.clear();
 
+                    Candidates seen;
+
                     /* Arrange SSIDs in sorted order as per signal strength */
                     WPASupplicant::Network::Iterator list(_controller->Networks());
                     while (list.Next() == true) {
                         const WPASupplicant::Network& net = list.Current();
                         if (_controller->Get(net.SSID()).IsValid()) {
 
+                            Candidates::iterator entry(seen.begin());
+                            while ((entry != seen.end()) && (entry->Signal > net.Signal())) {
+                                entry++;
+                            }
+                            seen.insert(entry, { net.SSID(), net.BSSID(), net.Frequency(), net.Signal() });
+
                             int32_t strength(net.Signal());
                             if (net.SSID().compare(_preferred) == 0) {
                                 strength = Core::NumberType<int32_t>::Max();
@@ -313,6 +430,8 @@ namespace Plugin {
                         }
                     }
 
+                    Refresh(seen);
+
                     if (_ssidList.size() == 0) {
                         _state = states::RETRY;
                     }
@@ -346,7 +465,7 @@ namespace Plugin {
                             --_attempts;
                         }
                         _state = states::SCANNING;
-                        _controller->Scan();
+                        Rescan();
 
                         _job.Schedule(Core::Time::Now().Add(_interval));
                     }
@@ -356,6 +475,136 @@ namespace Plugin {
             }
 
         private:
+            // Try the cached candidates of configured networks right away, the last associated one
+            // first. A scan is still needed if none of them works out, it is run in the background.
+            // Should be called with the _adminLock taken.
+            bool FastConnect()
+            {
+                _ssidList.clear();
+
+                // The candidates are already ranked, only the preferred network is moved up front.
+                SSIDList::iterator preferred(_ssidList.begin());
+
+                for (const Candidate& entry : _candidates) {
+                    if (_controller->Get(entry.SSID).IsValid() == true) {
+                        if (entry.SSID.compare(_preferred) == 0) {
+                            _ssidList.emplace(preferred, Core::NumberType<int32_t>::Max(), entry.BSSID, entry.SSID);
+                        } else {
+                            _ssidList.emplace_back(entry.Signal, entry.BSSID, entry.SSID);
+                            if (preferred == _ssidList.end()) {
+                                preferred = std::prev(_ssidList.end());
+                            }
+                        }
+                    }
+                }
+
+                if (_ssidList.empty() == false) {
+
+                    MoveState(states::CONNECTING);
+
+                    TRACE(Trace::Information, (_T("Fast connect to %s, %d cached candidate(s)"), _ssidList.front().SSID().c_str(), static_cast<uint32_t>(_ssidList.size())));
+
+                    _controller->Connect(this, _ssidList.front().SSID(), _ssidList.front().BSSID());
+
+                    // Keep the BSS table fresh for the next candidates and the roaming ranking.
+                    Rescan();
+
+                    _job.Schedule(Core::Time::Now().Add(_interval));
+                }
+
+                return (_ssidList.empty() == false);
+            }
+            // Rank the roaming candidates on the latest scan results, keeping the last associated BSS
+            // on top. Should be called with the _adminLock taken.
+            void Refresh(Candidates& seen)
+            {
+                if (_candidates.empty() == false) {
+                    const uint64_t last(_candidates.front().BSSID);
+                    Candidates::iterator index(seen.begin());
+
+                    while ((index != seen.end()) && (index->BSSID != last)) {
+                        index++;
+                    }
+                    if (index != seen.end()) {
+                        seen.splice(seen.begin(), seen, index);
+                    } else {
+                        seen.push_front(_candidates.front());
+                    }
+                }
+
+                if (seen.size() > MaxCandidates) {
+                    seen.resize(MaxCandidates);
+                }
+
+                _candidates.swap(seen);
+            }
+            // Remember the BSS we just associated with as the first candidate, the list to persist is
+            // returned in list. Should be called with the _adminLock taken.
+            void Associated(const string& SSID, const uint64_t& bssid, CandidateList& list)
+            {
+                WPASupplicant::Network net(_controller->Get(bssid));
+                Candidate entry({ SSID, bssid, 0, 0 });
+
+                Candidates::iterator index(_candidates.begin());
+                while ((index != _candidates.end()) && (index->BSSID != bssid)) {
+                    index++;
+                }
+                if (index != _candidates.end()) {
+                    entry = *index;
+                    _candidates.erase(index);
+                }
+                if (net.IsValid() == true) {
+                    entry.Frequency = net.Frequency();
+                    entry.Signal = net.Signal();
+                }
+                _candidates.push_front(entry);
+
+                if (_candidates.size() > MaxCandidates) {
+                    _candidates.resize(MaxCandidates);
+                }
+
+                for (const Candidate& candidate : _candidates) {
+                    CandidateList::Entry& element(list.Candidates.Add());
+                    element.Ssid = candidate.SSID;
+                    element.Bssid = candidate.BSSID;
+                    element.Frequency = candidate.Frequency;
+                    element.Signal = candidate.Signal;
+                }
+            }
+            // Writing to flash can take a while, do not call this with the _adminLock taken.
+            static void Save(const string& storage, const CandidateList& list)
+            {
+                if (storage.empty() == false) {
+                    Core::File file(storage);
+
+                    if (file.Create() == true) {
+                        list.IElement::ToFile(file);
+                    }
+                }
+            }
+            // Look where known networks were seen (and for the hidden ones) instead of scanning the whole
+            // band. Every FullScanInterval-th rescan is a full one, a network might have moved channel.
+            void Rescan()
+            {
+                std::list<uint32_t> frequencies;
+                std::list<string> ssids;
+
+                if ((++_scans % FullScanInterval) != 0) {
+                    _controller->Known(frequencies, ssids);
+
+                    // Right after boot the supplicant has not seen anything yet, fall back to where the
+                    // persisted candidates were last seen.
+                    if (frequencies.empty() == true) {
+                        for (const Candidate& entry : _candidates) {
+                            if ((entry.Frequency != 0) && (std::find(frequencies.begin(), frequencies.end(), entry.Frequency) == frequencies.end())) {
+                                frequencies.push_back(entry.Frequency);
+                            }
+                        }
+                    }
+                }
+
+                _controller->Scan(frequencies, ssids);
+            }
             void MoveState(const states newState) {
                 _state = states::IDLE;
 
@@ -369,6 +618,9 @@ namespace Plugin {
             }
             void Completed(const uint32_t result) override {
 
+                CandidateList list;
+                string storage;
+
                 _controller->Revoke(this);
 
                 _adminLock.Lock();
@@ -377,6 +629,14 @@ namespace Plugin {
 
                     MoveState(states::IDLE);
 
+                    if (_ssidList.empty() == false) {
+                        TRACE(Trace::Information, (_T("Connected to %s in %d ms"), _ssidList.front().SSID().c_str(),
+                            static_cast<uint32_t>((Core::Time::Now().Ticks() - _started) / Core::Time::TicksPerMillisecond)));
+
+                        Associated(_ssidList.front().SSID(), _ssidList.front().BSSID(), list);
+                        storage = _storage;
+                    }
+
                     _ssidList.clear();
                 }
                 else {
@@ -385,6 +645,8 @@ namespace Plugin {
                     _job.Submit();
                 }
                 _adminLock.Unlock();
+
+                Save(storage, list);
             }
 
         private:
@@ -395,7 +657,11 @@ namespace Plugin {
             SSIDList _ssidList;
             uint32_t _interval;
             uint32_t _attempts;
+            uint32_t _scans;
             string _preferred;
+            string _storage;
+            Candidates _candidates;
+            uint64_t _started;
         };
 
     public:
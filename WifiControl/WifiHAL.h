@@ -74,9 +74,22 @@ namespace WPASupplicant { // XXX: Change ???
         void Init();
         void Uninit();
         uint32_t Scan();
+        uint32_t Scan(const std::list<uint32_t>&, const std::list<string>&)
+        {
+            // The HAL has no targeted scans.
+            return (Scan());
+        }
         uint32_t Connect(const string& SSID);
         uint32_t Disconnect(const string& SSID);
 
+        inline void Known(std::list<uint32_t>&, std::list<string>&) const
+        {
+        }
+        inline Network::Iterator Changes()
+        {
+            // No change tracking in the HAL, everything is a change.
+            return (Networks());
+        }
         inline Network::Iterator Networks()
         {
             Network::Iterator result;
@@ -0,0 +1,654 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MODULE_NAME RPC_Benchmark
+
+#include <core/core.h>
+#include <websocket/websocket.h>
+#include <interfaces/IPerformance.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "../JSONRPCPlugin/Data.h"
+
+// Non-interactive counterpart of the performance measurements in the JSONRPCClient example. It runs the
+// IPerformance calls of the JSONRPCPlugin over COM-RPC, JSON-RPC and MessagePack with the same payloads,
+// optionally from multiple threads, measures the notification fan-out and reports everything as JSON so
+// results of different builds can be compared.
+
+using namespace WPEFramework;
+
+namespace {
+
+// Returns Core::ERROR_NONE if the call succeeded.
+typedef std::function<uint32_t(uint16_t& size, uint8_t buffer[])> PerformanceFunction;
+
+static uint8_t swapPattern[] = { 0x00, 0x55, 0xAA, 0xFF };
+constexpr uint16_t MaxPayloadSize = 1024 * 32;
+constexpr uint32_t RPCTimeOut = 10000;
+
+class Options {
+public:
+    Options(const Options&) = delete;
+    Options& operator=(const Options&) = delete;
+
+    Options()
+        : COMChannel(_T("127.0.0.1:8899"))
+        , Access(_T("127.0.0.1:80"))
+        , Callsign(_T("JSONRPCPlugin"))
+        , Output()
+        , Loops(200)
+        , WarmUp(20)
+        , Concurrency(1)
+        , Subscribers(8)
+        , Sizes({ 0, 16, 128, 512, 1024, 2048, MaxPayloadSize })
+        , Transports({ _T("comrpc"), _T("jsonrpc"), _T("msgpack") })
+    {
+    }
+
+public:
+    // Returns false if the help needs to be shown.
+    bool Parse(int argc, char** argv)
+    {
+        bool result = true;
+        int index = 1;
+
+        while ((index < argc) && (result == true)) {
+            const bool hasValue = ((index + 1) < argc);
+
+            if ((strcmp(argv[index], "-remote") == 0) && (hasValue == true)) {
+                COMChannel = argv[++index];
+            } else if ((strcmp(argv[index], "-access") == 0) && (hasValue == true)) {
+                Access = argv[++index];
+            } else if ((strcmp(argv[index], "-callsign") == 0) && (hasValue == true)) {
+                Callsign = argv[++index];
+            } else if ((strcmp(argv[index], "-output") == 0) && (hasValue == true)) {
+                Output = argv[++index];
+            } else if ((strcmp(argv[index], "-loops") == 0) && (hasValue == true)) {
+                Loops = std::max(atoi(argv[++index]), 1);
+            } else if ((strcmp(argv[index], "-warmup") == 0) && (hasValue == true)) {
+                WarmUp = std::max(atoi(argv[++index]), 0);
+            } else if ((strcmp(argv[index], "-concurrency") == 0) && (hasValue == true)) {
+                Concurrency = std::max(atoi(argv[++index]), 1);
+            } else if ((strcmp(argv[index], "-subscribers") == 0) && (hasValue == true)) {
+                Subscribers = std::max(atoi(argv[++index]), 0);
+            } else if ((strcmp(argv[index], "-sizes") == 0) && (hasValue == true)) {
+                Sizes.clear();
+                Split(argv[++index], [this](const string& entry) {
+                    Sizes.push_back(static_cast<uint16_t>(std::min(std::max(atoi(entry.c_str()), 0), static_cast<int>(MaxPayloadSize))));
+                });
+            } else if ((strcmp(argv[index], "-transports") == 0) && (hasValue == true)) {
+                Transports.clear();
+                Split(argv[++index], [this](const string& entry) {
+                    Transports.push_back(entry);
+                });
+            } else {
+                result = false;
+            }
+            index++;
+        }
+
+        return (result);
+    }
+    bool Has(const string& transport) const
+    {
+        return (std::find(Transports.begin(), Transports.end(), transport) != Transports.end());
+    }
+
+private:
+    static void Split(const string& list, const std::function<void(const string&)>& handle)
+    {
+        string::size_type start = 0;
+
+        while (start <= list.length()) {
+            string::size_type end = list.find(',', start);
+            const string entry(list.substr(start, (end == string::npos ? end : end - start)));
+
+            if (entry.empty() == false) {
+                handle(entry);
+            }
+
+            start = (end == string::npos ? list.length() + 1 : end + 1);
+        }
+    }
+
+public:
+    string COMChannel;
+    string Access;
+    string Callsign;
+    string Output;
+    uint32_t Loops;
+    uint32_t WarmUp;
+    uint32_t Concurrency;
+    uint32_t Subscribers;
+    std::vector<uint16_t> Sizes;
+    std::vector<string> Transports;
+};
+
+void ShowHelp()
+{
+    printf("RPCBenchmark [options]\n"
+           "\t-remote <node>        COM-RPC channel of the framework, default 127.0.0.1:8899\n"
+           "\t-access <node>        JSON-RPC access point (THUNDER_ACCESS), default 127.0.0.1:80\n"
+           "\t-callsign <name>      Callsign of the JSONRPCPlugin, default JSONRPCPlugin\n"
+           "\t-transports <list>    Comma separated subset of comrpc,jsonrpc,msgpack\n"
+           "\t-sizes <list>         Comma separated payload sizes in bytes, max 32768\n"
+           "\t-loops <n>            Measured calls per transport, operation and size, default 200\n"
+           "\t-warmup <n>           Unmeasured calls before every measurement, default 20\n"
+           "\t-concurrency <n>      Threads issuing the calls at the same time, default 1\n"
+           "\t-subscribers <n>      Subscribers for the notification fan-out, 0 to skip, default 8\n"
+           "\t-output <file>        Write the JSON results to a file instead of stdout\n");
+}
+
+class Result : public Core::JSON::Container {
+public:
+    Result& operator=(const Result&) = delete;
+
+    Result()
+        : Core::JSON::Container()
+        , Transport()
+        , Operation()
+        , Size(0)
+        , Concurrency(0)
+        , Calls(0)
+        , Failures(0)
+        , Mean(0)
+        , P50(0)
+        , P95(0)
+        , P99(0)
+        , Max(0)
+        , Throughput(0)
+    {
+        Add(_T("transport"), &Transport);
+        Add(_T("operation"), &Operation);
+        Add(_T("size"), &Size);
+        Add(_T("concurrency"), &Concurrency);
+        Add(_T("calls"), &Calls);
+        Add(_T("failures"), &Failures);
+        Add(_T("mean"), &Mean);
+        Add(_T("p50"), &P50);
+        Add(_T("p95"), &P95);
+        Add(_T("p99"), &P99);
+        Add(_T("max"), &Max);
+        Add(_T("throughput"), &Throughput);
+    }
+    Result(const Result& copy)
+        : Result()
+    {
+        Transport = copy.Transport;
+        Operation = copy.Operation;
+        Size = copy.Size;
+        Concurrency = copy.Concurrency;
+        Calls = copy.Calls;
+        Failures = copy.Failures;
+        Mean = copy.Mean;
+        P50 = copy.P50;
+        P95 = copy.P95;
+        P99 = copy.P99;
+        Max = copy.Max;
+        Throughput = copy.Throughput;
+    }
+    ~Result() override
+    {
+    }
+
+public:
+    // Latencies in microseconds, throughput in calls per second.
+    void Set(std::vector<uint64_t>& latencies, const uint64_t duration)
+    {
+        Calls = static_cast<uint32_t>(latencies.size());
+
+        if (latencies.empty() == false) {
+            uint64_t total = 0;
+
+            std::sort(latencies.begin(), latencies.end());
+
+            for (const uint64_t entry : latencies) {
+                total += entry;
+            }
+
+            Mean = total / latencies.size();
+            P50 = Percentile(latencies, 50);
+            P95 = Percentile(latencies, 95);
+            P99 = Percentile(latencies, 99);
+            Max = latencies.back();
+            Throughput = (duration == 0) ? 0 : static_cast<uint32_t>((latencies.size() * Core::Time::MicroSecondsPerSecond) / duration);
+        }
+    }
+
+private:
+    static uint64_t Percentile(const std::vector<uint64_t>& sorted, const uint8_t percentile)
+    {
+        // Nearest rank
+        const size_t rank = ((sorted.size() * percentile) + 99) / 100;
+        return (sorted[(rank == 0 ? 0 : rank - 1)]);
+    }
+
+public:
+    Core::JSON::String Transport;
+    Core::JSON::String Operation;
+    Core::JSON::DecUInt16 Size;
+    Core::JSON::DecUInt32 Concurrency;
+    Core::JSON::DecUInt32 Calls;
+    Core::JSON::DecUInt32 Failures;
+    Core::JSON::DecUInt64 Mean;
+    Core::JSON::DecUInt64 P50;
+    Core::JSON::DecUInt64 P95;
+    Core::JSON::DecUInt64 P99;
+    Core::JSON::DecUInt64 Max;
+    Core::JSON::DecUInt32 Throughput;
+};
+
+class Report : public Core::JSON::Container {
+public:
+    Report(const Report&) = delete;
+    Report& operator=(const Report&) = delete;
+
+    Report()
+        : Core::JSON::Container()
+        , Loops(0)
+        , WarmUp(0)
+        , Calls()
+        , FanOut()
+    {
+        Add(_T("loops"), &Loops);
+        Add(_T("warmup"), &WarmUp);
+        Add(_T("calls"), &Calls);
+        Add(_T("fanout"), &FanOut);
+    }
+    ~Report() override
+    {
+    }
+
+public:
+    Core::JSON::DecUInt32 Loops;
+    Core::JSON::DecUInt32 WarmUp;
+    Core::JSON::ArrayType<Result> Calls;
+    Result FanOut;
+};
+
+// Runs "subject" loops times (plus warm-up), spread over the configured number of threads, each with
+// its own payload buffer as the exchange operations overwrite it.
+void Measure(const Options& options, const string& transport, const string& operation, const uint16_t size, const std::function<PerformanceFunction()>& factory, Report& report)
+{
+    std::vector<uint64_t> latencies;
+    std::atomic<uint32_t> failures(0);
+    Core::CriticalSection lock;
+
+    latencies.reserve(options.Loops);
+
+    auto worker = [&](const uint32_t calls, const bool measured) {
+        std::vector<uint8_t> dataFrame(MaxPayloadSize);
+        std::vector<uint64_t> local;
+        PerformanceFunction subject(factory());
+
+        local.reserve(calls);
+
+        for (uint32_t run = 0; run < calls; run++) {
+            uint16_t length = size;
+
+            for (uint16_t index = 0; index < length; index++) {
+                dataFrame[index] = swapPattern[index % sizeof(swapPattern)];
+            }
+
+            Core::StopWatch measurement;
+            const uint32_t result = subject(length, dataFrame.data());
+            const uint64_t elapsed = measurement.Elapsed();
+
+            if (result != Core::ERROR_NONE) {
+                failures++;
+            } else if (measured == true) {
+                local.push_back(elapsed);
+            }
+        }
+
+        if (measured == true) {
+            lock.Lock();
+            latencies.insert(latencies.end(), local.begin(), local.end());
+            lock.Unlock();
+        }
+    };
+
+    auto run = [&](const uint32_t total, const bool measured) {
+        std::vector<std::thread> threads;
+        const uint32_t share = total / options.Concurrency;
+        const uint32_t remainder = total % options.Concurrency;
+
+        for (uint32_t index = 1; index < options.Concurrency; index++) {
+            threads.emplace_back(worker, share + (index < remainder ? 1 : 0), measured);
+        }
+
+        worker(share + (0 < remainder ? 1 : 0), measured);
+
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    };
+
+    run(options.WarmUp, false);
+    failures = 0;
+
+    Core::StopWatch wallClock;
+    run(options.Loops, true);
+    const uint64_t duration = wallClock.Elapsed();
+
+    Result& result(report.Calls.Add());
+    result.Transport = transport;
+    result.Operation = operation;
+    result.Size = size;
+    result.Concurrency = options.Concurrency;
+    result.Failures = failures.load();
+    result.Set(latencies, duration);
+
+    fprintf(stderr, "%-8s %-9s %6u bytes: p50 %6llu us, p99 %6llu us, %u calls/s\n", transport.c_str(), operation.c_str(), size,
+        static_cast<unsigned long long>(result.P50.Value()), static_cast<unsigned long long>(result.P99.Value()), result.Throughput.Value());
+}
+
+void MeasureCOMRPC(const Options& options, Report& report)
+{
+    Core::ProxyType<RPC::InvokeServerType<1, 0, 4>> engine(Core::ProxyType<RPC::InvokeServerType<1, 0, 4>>::Create());
+    Core::ProxyType<RPC::CommunicatorClient> client(
+        Core::ProxyType<RPC::CommunicatorClient>::Create(
+            Core::NodeId(options.COMChannel.c_str()),
+            Core::ProxyType<Core::IIPCServer>(engine)));
+
+    engine->Announcements(client->Announcement());
+
+    if (client->Open(2000) != Core::ERROR_NONE) {
+        fprintf(stderr, "Failed to open up a COMRPC link with the server at %s.\n", options.COMChannel.c_str());
+    } else {
+        Exchange::IPerformance* perf = client->Aquire<Exchange::IPerformance>(2000, options.Callsign, ~0);
+
+        if (perf == nullptr) {
+            fprintf(stderr, "The %s plugin did not return an IPerformance interface.\n", options.Callsign.c_str());
+        } else {
+            for (const uint16_t size : options.Sizes) {
+                Measure(options, _T("comrpc"), _T("send"), size, [perf]() -> PerformanceFunction {
+                    return ([perf](uint16_t& length, uint8_t buffer[]) -> uint32_t {
+                        return (perf->Send(length, buffer));
+                    });
+                }, report);
+                Measure(options, _T("comrpc"), _T("receive"), size, [perf]() -> PerformanceFunction {
+                    return ([perf](uint16_t& length, uint8_t buffer[]) -> uint32_t {
+                        return (perf->Receive(length, buffer));
+                    });
+                }, report);
+                Measure(options, _T("comrpc"), _T("exchange"), size, [perf]() -> PerformanceFunction {
+                    return ([perf](uint16_t& length, uint8_t buffer[]) -> uint32_t {
+                        const uint16_t maxBufferSize = MaxPayloadSize;
+                        return (perf->Exchange(length, buffer, maxBufferSize));
+                    });
+                }, report);
+            }
+
+            perf->Release();
+        }
+
+        client->Close(Core::infinite);
+    }
+
+    client.Release();
+}
+
+template <typename INTERFACE>
+void MeasureJSONRPC(const Options& options, const string& transport, Report& report)
+{
+    JSONRPC::LinkType<INTERFACE> remoteObject((options.Callsign + _T(".2")).c_str(), (_T("benchmark.") + transport).c_str());
+
+    for (const uint16_t size : options.Sizes) {
+        Measure(options, transport, _T("send"), size, [&remoteObject]() -> PerformanceFunction {
+            return ([&remoteObject](uint16_t& length, uint8_t buffer[]) -> uint32_t {
+                string stringBuffer;
+                Data::JSONDataBuffer message;
+                Core::JSON::DecUInt32 result;
+
+                Core::ToString(buffer, length, false, stringBuffer);
+                message.Data = stringBuffer;
+                message.Length = static_cast<uint16_t>(stringBuffer.size());
+                message.Duration = static_cast<uint16_t>(stringBuffer.size() + 1);
+
+                return (remoteObject.template Invoke<Data::JSONDataBuffer, Core::JSON::DecUInt32>(RPCTimeOut, _T("send"), message, result));
+            });
+        }, report);
+        Measure(options, transport, _T("receive"), size, [&remoteObject]() -> PerformanceFunction {
+            return ([&remoteObject](uint16_t& length, uint8_t buffer[]) -> uint32_t {
+                Data::JSONDataBuffer message;
+                Core::JSON::DecUInt16 maxSize = length;
+
+                uint32_t result = remoteObject.template Invoke<Core::JSON::DecUInt16, Data::JSONDataBuffer>(RPCTimeOut, _T("receive"), maxSize, message);
+
+                if (result == Core::ERROR_NONE) {
+                    length = static_cast<uint16_t>(std::min(((message.Data.Value().length() * 6) + 7) / 8, static_cast<size_t>(MaxPayloadSize)));
+                    Core::FromString(message.Data.Value(), buffer, length);
+                }
+                return (result);
+            });
+        }, report);
+        Measure(options, transport, _T("exchange"), size, [&remoteObject]() -> PerformanceFunction {
+            return ([&remoteObject](uint16_t& length, uint8_t buffer[]) -> uint32_t {
+                string stringBuffer;
+                Data::JSONDataBuffer message;
+                Data::JSONDataBuffer response;
+
+                Core::ToString(buffer, length, false, stringBuffer);
+                message.Data = stringBuffer;
+                message.Length = length;
+
+                uint32_t result = remoteObject.template Invoke<Data::JSONDataBuffer, Data::JSONDataBuffer>(RPCTimeOut, _T("exchange"), message, response);
+
+                if (result == Core::ERROR_NONE) {
+                    length = static_cast<uint16_t>(std::min(response.Data.Value().length(), static_cast<size_t>(MaxPayloadSize)));
+                    Core::FromString(response.Data.Value(), buffer, length);
+                }
+                return (result);
+            });
+        }, report);
+    }
+}
+
+// Every subscriber registers for the "message" event, one "postmessage" to all of them is timed until
+// the last subscriber received it.
+class FanOut {
+private:
+    class Subscriber {
+    public:
+        Subscriber() = delete;
+        Subscriber(const Subscriber&) = delete;
+        Subscriber& operator=(const Subscriber&) = delete;
+
+        Subscriber(FanOut& parent, const string& callsign, const uint32_t index)
+            : _parent(parent)
+            , _remoteObject((callsign + _T(".2")).c_str(), (_T("subscriber") + Core::NumberType<uint32_t>(index).Text() + _T(".benchmark")).c_str())
+        {
+        }
+        ~Subscriber()
+        {
+            _remoteObject.Unsubscribe(1000, _T("message"));
+        }
+
+    public:
+        bool Subscribe()
+        {
+            return (_remoteObject.Subscribe<Core::JSON::String>(1000, _T("message"), &Subscriber::Received, this) == Core::ERROR_NONE);
+        }
+
+    private:
+        void Received(const Core::JSON::String& message)
+        {
+            _parent.Received(message.Value());
+        }
+
+    private:
+        FanOut& _parent;
+        JSONRPC::LinkType<Core::JSON::IElement> _remoteObject;
+    };
+
+public:
+    FanOut() = delete;
+    FanOut(const FanOut&) = delete;
+    FanOut& operator=(const FanOut&) = delete;
+
+    FanOut(const Options& options)
+        : _options(options)
+        , _run(~0)
+        , _pending(0)
+        , _done(false, true)
+        , _subscribers()
+        , _remoteObject((options.Callsign + _T(".2")).c_str(), _T("benchmark.fanout"))
+    {
+    }
+    ~FanOut()
+    {
+        for (Subscriber* subscriber : _subscribers) {
+            delete subscriber;
+        }
+    }
+
+public:
+    void Measure(Result& result)
+    {
+        uint32_t failures = 0;
+        uint32_t subscribed = 0;
+        std::vector<uint64_t> latencies;
+
+        for (uint32_t index = 0; index < _options.Subscribers; index++) {
+            _subscribers.push_back(new Subscriber(*this, _options.Callsign, index));
+
+            if (_subscribers.back()->Subscribe() == true) {
+                subscribed++;
+            } else {
+                fprintf(stderr, "Subscriber %u could not register for the message event.\n", index);
+            }
+        }
+
+        latencies.reserve(_options.Loops);
+
+        Core::StopWatch wallClock;
+
+        // Without a single registered subscriber nobody would ever signal the end of a run.
+        for (uint32_t run = 0; (subscribed != 0) && (run < (_options.WarmUp + _options.Loops)); run++) {
+            // Only the subscribers that registered receive the event. The message carries the run, so
+            // an event that arrives after its run timed out is not counted for the next one.
+            _run = run;
+            _pending = subscribed;
+            _done.ResetEvent();
+
+            Core::StopWatch measurement;
+
+            if ((_remoteObject.Invoke<Data::MessageParameters, void>(RPCTimeOut, _T("postmessage"), Data::MessageParameters(_T("all"), Tag(run))) != Core::ERROR_NONE)
+                || (_done.Lock(RPCTimeOut) != Core::ERROR_NONE)) {
+                failures++;
+            } else if (run >= _options.WarmUp) {
+                latencies.push_back(measurement.Elapsed());
+            }
+
+            if (run + 1 == _options.WarmUp) {
+                wallClock.Reset();
+            }
+        }
+
+        const uint64_t duration = wallClock.Elapsed();
+
+        result.Transport = _T("jsonrpc");
+        result.Operation = _T("fanout");
+        result.Concurrency = subscribed;
+        result.Failures = (subscribed != 0 ? failures : (_options.WarmUp + _options.Loops));
+        result.Set(latencies, duration);
+
+        fprintf(stderr, "%-8s %-9s %6u subscribers: p50 %6llu us, p99 %6llu us\n", _T("jsonrpc"), _T("fanout"), subscribed,
+            static_cast<unsigned long long>(result.P50.Value()), static_cast<unsigned long long>(result.P99.Value()));
+    }
+
+private:
+    static string Tag(const uint32_t run)
+    {
+        return (_T("fanout:") + Core::NumberType<uint32_t>(run).Text());
+    }
+    void Received(const string& message)
+    {
+        if ((message == Tag(_run)) && (_pending.fetch_sub(1) == 1)) {
+            _done.SetEvent();
+        }
+    }
+
+private:
+    const Options& _options;
+    std::atomic<uint32_t> _run;
+    std::atomic<uint32_t> _pending;
+    Core::Event _done;
+    std::list<Subscriber*> _subscribers;
+    JSONRPC::LinkType<Core::JSON::IElement> _remoteObject;
+};
+
+}
+
+int main(int argc, char** argv)
+{
+    int result = 0;
+
+    {
+        Options options;
+
+        if (options.Parse(argc, argv) == false) {
+            ShowHelp();
+            result = 1;
+        } else {
+            Report report;
+
+            report.Loops = options.Loops;
+            report.WarmUp = options.WarmUp;
+
+            Core::SystemInfo::SetEnvironment(_T("THUNDER_ACCESS"), options.Access);
+
+            if (options.Has(_T("comrpc")) == true) {
+                MeasureCOMRPC(options, report);
+            }
+            if (options.Has(_T("jsonrpc")) == true) {
+                MeasureJSONRPC<Core::JSON::IElement>(options, _T("jsonrpc"), report);
+            }
+            if (options.Has(_T("msgpack")) == true) {
+                MeasureJSONRPC<Core::JSON::IMessagePack>(options, _T("msgpack"), report);
+            }
+            if (options.Subscribers > 0) {
+                FanOut fanOut(options);
+                fanOut.Measure(report.FanOut);
+            }
+
+            if (options.Output.empty() == true) {
+                string text;
+                report.ToString(text);
+                printf("%s\n", text.c_str());
+            } else {
+                Core::File file(options.Output);
+
+                if ((file.Create() == false) || (report.IElement::ToFile(file) == false)) {
+                    fprintf(stderr, "Could not write the results to %s\n", options.Output.c_str());
+                    result = 1;
+                }
+            }
+        }
+    }
+
+    Core::Singleton::Dispose();
+
+    return (result);
+}